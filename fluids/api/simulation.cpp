@@ -0,0 +1,177 @@
+#include "simulation.hpp"
+#include "../grid/cartesian_grid.hpp"
+#include "../grid/ghias_grid.hpp"
+#include "../grid/ghias_shock_grid.hpp"
+#include "../grid/karagiozis_grid.hpp"
+#include "../grid/shock_grid.hpp"
+#include "../input_output/options.hpp"
+#include "../time_integrators/runge_kutta_integrator.hpp"
+#include "../time_integrators/solver.hpp"
+#include "../time_integrators/time_integrator_types.hpp"
+#include "../utils/operators_overloads.hpp"
+#include "../utils/parallel/communicator.hpp"
+#include "../utils/point_functions.hpp"
+#include "../utils/solver_context.hpp"
+#include <iostream>
+#include <limits>
+#include <utility>
+
+/**
+ * \class SimulationRun
+ * @brief Grid, tool and integrator of a Simulation, whatever the grid type
+ */
+class SimulationRun {
+public:
+    virtual ~SimulationRun() = default;
+    virtual CartesianGrid& grid() = 0;
+    virtual bool step() = 0;
+    /**
+     * @brief Applies the boundary conditions and grid updates to the current
+     * values, as the end of every step does
+     */
+    virtual void update_values() = 0;
+    virtual void stop_at(double t_stop) = 0;
+    virtual bool finished() const = 0;
+    virtual double time() const = 0;
+    virtual long steps() const = 0;
+    virtual void finish() = 0;
+};
+
+namespace {
+template <typename Grid>
+class GridRun : public SimulationRun {
+public:
+    explicit GridRun(Options& opt)
+        : pf(opt.mach(), opt.gam())
+        , grid_c(opt)
+        , tool(create_tool(opt))
+        , integrator(opt, grid_c, tool, pf, context)
+    {
+        integrator.start();
+    }
+    CartesianGrid& grid() override { return grid_c; }
+    bool step() override { return integrator.step(); }
+    void update_values() override
+    {
+        tool->update_values(&grid_c, integrator.time());
+    }
+    void stop_at(double t_stop) override { integrator.stop_at(t_stop); }
+    bool finished() const override { return integrator.finished(); }
+    double time() const override { return integrator.time(); }
+    long steps() const override { return integrator.steps(); }
+    void finish() override { integrator.finish(); }
+
+private:
+    PointFunctions pf;
+    SolverContext context;
+    Grid grid_c;
+    std::shared_ptr<TimeIntegratorTool> tool;
+    RungeKuttaIntegrator<Grid, CartesianVariation> integrator;
+
+    std::shared_ptr<TimeIntegratorTool> create_tool(Options& opt)
+    {
+        auto tool = Solver::create_tool(opt, pf, context, grid_c);
+        if (tool == nullptr) {
+            std::cerr << "Could not create the time integrator tool"
+                      << std::endl;
+            throw(-1);
+        }
+        return tool;
+    }
+};
+
+std::unique_ptr<SimulationRun> create_run(Options& opt)
+{
+    if (opt.integrator_type() != "RUNGE_KUTTA") {
+        std::cerr << "Integrator " << opt.integrator_type()
+                  << " does not support step control" << std::endl;
+        throw(-1);
+    }
+    if (parallel::size() > 1) {
+        Solver::check_decomposition_support(opt);
+    }
+    auto solver_type = opt.solver_type();
+    if (solver_type == "SIMPLE") {
+        return std::make_unique<GridRun<CartesianGrid>>(opt);
+    }
+    if (solver_type == "GHIAS") {
+        return std::make_unique<GridRun<GhiasGrid>>(opt);
+    }
+    if (solver_type == "KARAGIOZIS") {
+        return std::make_unique<GridRun<KaragiozisGrid>>(opt);
+    }
+    if (solver_type == "SHOCK") {
+        return std::make_unique<GridRun<ShockGrid>>(opt);
+    }
+    if (solver_type == "GHIAS_SHOCK") {
+        return std::make_unique<GridRun<GhiasShockGrid>>(opt);
+    }
+    std::cerr << "Solver " << solver_type << " not found!!!" << std::endl;
+    throw(-1);
+}
+} // namespace
+
+Simulation::Simulation(Options& opt)
+    : run(create_run(opt))
+    , state_handed_out(false)
+{
+}
+
+Simulation::~Simulation() = default;
+
+void Simulation::step()
+{
+    if (!finished()) {
+        advance();
+    }
+}
+
+void Simulation::advance_to(double t_target)
+{
+    run->stop_at(t_target);
+    while (!finished() and time() < t_target) {
+        advance();
+    }
+    run->stop_at(std::numeric_limits<double>::infinity());
+}
+
+void Simulation::advance()
+{
+    if (state_handed_out) {
+        run->update_values();
+        state_handed_out = false;
+    }
+    if (run->step()) {
+        for (auto& callback : callbacks) {
+            callback(*this);
+        }
+    }
+}
+
+bool Simulation::finished() const { return run->finished(); }
+
+double Simulation::time() const { return run->time(); }
+
+long Simulation::steps() const { return run->steps(); }
+
+void Simulation::finish() { run->finish(); }
+
+void Simulation::on_print(Callback callback)
+{
+    callbacks.push_back(std::move(callback));
+}
+
+Span<StoredPoint> Simulation::state()
+{
+    state_handed_out = true;
+    auto& g = run->grid();
+    return {g.values_data(), static_cast<size_t>(g.nPointsTotal)};
+}
+
+Span<const int> Simulation::flags() const
+{
+    auto& g = run->grid();
+    return {g.flags_data(), static_cast<size_t>(g.nPointsTotal)};
+}
+
+const CartesianGrid& Simulation::grid() const { return run->grid(); }
@@ -0,0 +1,103 @@
+/**
+ * \file simulation.hpp
+ * @brief Entry point for programs that embed the solver
+ */
+#ifndef SIMULATION_HPP
+#define SIMULATION_HPP
+
+#include "../utils/point_def.hpp"
+#include "../utils/span.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+class CartesianGrid;
+class Options;
+class SimulationRun;
+
+/**
+ * \class Simulation
+ * @brief A run of one case that the caller advances, instead of running it
+ * to T_MAX as main does
+ *
+ * The case comes from opt: set up with Options::set, and read either from
+ * the case files or from the arrays given to Options::set_memory_input.
+ * Only the RUNGE_KUTTA integrator supports step control. Output, step log
+ * and checkpoints follow opt as in a normal run (OUTPUT_TYPE = NONE writes
+ * nothing). Process wide settings (OMP_THREADS, THREAD_AFFINITY, TIMING)
+ * are left to the caller, see Solver::configure_process.
+ *
+ * @code
+ * Options opt;
+ * opt.set("MACH", "0.3");
+ * opt.set_memory_input(constants, components);
+ * Simulation sim(opt);
+ * sim.on_print([](Simulation& s) { couple(s.time(), s.state()); });
+ * sim.advance_to(1.0);
+ * @endcode
+ */
+class Simulation {
+public:
+    using Callback = std::function<void(Simulation&)>;
+
+    /**
+     * @brief Builds the grid and writes the initial output. opt must outlive
+     * the simulation
+     */
+    explicit Simulation(Options& opt);
+    ~Simulation();
+
+    /**
+     * @brief Advances one time step, unless the run is finished()
+     */
+    void step();
+
+    /**
+     * @brief Advances until time() reaches t_target. The last step is
+     * shortened to end exactly at t_target. Stops early if the run
+     * finishes, e.g. at T_MAX
+     */
+    void advance_to(double t_target);
+
+    /**
+     * @brief Whether T_MAX, MAX_STEPS, a steady state or a NaN ended the run
+     */
+    bool finished() const;
+    double time() const;
+    long steps() const;
+
+    /**
+     * @brief Writes the final output and flushes the step log. Not called by
+     * the destructor
+     */
+    void finish();
+
+    /**
+     * @brief Calls callback after every step that ends at a print time
+     * (PRINT_INTERVAL)
+     */
+    void on_print(Callback callback);
+
+    /**
+     * @name State in place
+     * Conservative variables and flags of every point, in the index order of
+     * grid(), without copies. Values written to state() are used from the
+     * next step on, which first applies the boundary conditions and grid
+     * updates to them as the end of every step does. Writes through a span
+     * kept across steps miss them, so call state() again after a step
+     * before writing. A decomposed run holds the block of this process
+     * @{ */
+    Span<StoredPoint> state();
+    Span<const int> flags() const;
+    const CartesianGrid& grid() const;
+    /**  @} */
+
+private:
+    std::unique_ptr<SimulationRun> run;
+    std::vector<Callback> callbacks;
+    bool state_handed_out; ///< state() called since the last step
+
+    void advance();
+};
+
+#endif /* SIMULATION_HPP */
@@ -0,0 +1,152 @@
+#include "../../grid/cartesian_grid.hpp"
+#include "../../input_output/cases/canonical_cases.hpp"
+#include "../../input_output/options.hpp"
+#include "../../input_output/readers/reader.hpp"
+#include "../../time_integrators/runge_kutta_integrator.hpp"
+#include "../../time_integrators/solver.hpp"
+#include "../../time_integrators/time_integrator_types.hpp"
+#include "../../utils/grid_components_container_def.hpp"
+#include "../../utils/grid_constants_container_def.hpp"
+#include "../../utils/point_functions.hpp"
+#include "../../utils/solver_context.hpp"
+#include "../simulation.hpp"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <sstream>
+#include <vector>
+
+namespace {
+/**
+ * @brief Channel case of n x n points, given to the options in memory
+ */
+std::unique_ptr<Options> channel_options(int n)
+{
+    auto input = create_canonical_case("CHANNEL", n, "SIMPLE");
+    std::istringstream config(input.options);
+    auto opt = std::make_unique<Options>(config);
+    opt->set("OUTPUT_TYPE", "NONE");
+    opt->set("T_MAX", "0.05");
+    opt->set("PRINT_INTERVAL", "0.02");
+
+    Reader reader(*opt, std::istringstream(input.initial_conditions),
+        std::istringstream(input.mesh), std::istringstream(input.boundary),
+        std::istringstream(input.immersed_interface),
+        std::istringstream(input.shock));
+    GridConstantsContainer constants{reader.nPointsI(), reader.nPointsJ(),
+        reader.nPointsTotal(), reader.dx(), reader.dy(), reader.xmin(),
+        reader.ymin()};
+    GridComponentsContainer components;
+    components.grid_c = reader.grid();
+    components.flags_c = reader.flags();
+    components.boundary_c = reader.boundary();
+    opt->set_memory_input(constants, components);
+    return opt;
+}
+} // namespace
+
+TEST(SimulationTest, testMatchesSolverRun)
+{
+    auto solver_opt = channel_options(16);
+    Solver solver(*solver_opt, true);
+    solver.run_case();
+
+    auto opt = channel_options(16);
+    Simulation sim(*opt);
+    sim.advance_to(1e10);
+    ASSERT_TRUE(sim.finished());
+    auto state = sim.state();
+    auto& reference = solver.final_values();
+    ASSERT_EQ(state.size(), reference.size());
+    for (size_t ind = 0; ind < state.size(); ind++) {
+        ASSERT_EQ(state[ind].rho(), reference[ind].rho());
+        ASSERT_EQ(state[ind].ru(), reference[ind].ru());
+        ASSERT_EQ(state[ind].rv(), reference[ind].rv());
+        ASSERT_EQ(state[ind].e(), reference[ind].e());
+    }
+}
+
+TEST(SimulationTest, testAdvanceToEndsAtTarget)
+{
+    auto opt = channel_options(16);
+    Simulation sim(*opt);
+    sim.step();
+    ASSERT_EQ(sim.steps(), 1);
+    ASSERT_GT(sim.time(), 0.0);
+    sim.advance_to(0.013);
+    ASSERT_EQ(sim.time(), 0.013);
+    ASSERT_FALSE(sim.finished());
+    sim.advance_to(1e10);
+    ASSERT_TRUE(sim.finished());
+    long steps = sim.steps();
+    sim.step();
+    ASSERT_EQ(sim.steps(), steps);
+}
+
+TEST(SimulationTest, testCallbacksAtPrintIntervals)
+{
+    auto opt = channel_options(16);
+    Simulation sim(*opt);
+    std::vector<double> times;
+    sim.on_print([&](Simulation& s) { times.push_back(s.time()); });
+    sim.advance_to(1e10);
+    ASSERT_EQ(times.size(), 2u);
+    ASSERT_NEAR(times[0], 0.02, 1e-12);
+    ASSERT_NEAR(times[1], 0.04, 1e-12);
+}
+
+TEST(SimulationTest, testStateIsTheGrid)
+{
+    auto opt = channel_options(16);
+    Simulation sim(*opt);
+    auto state = sim.state();
+    ASSERT_EQ(state.size(), 256u);
+    ASSERT_EQ(state.data(), &sim.grid().values(0));
+    ASSERT_EQ(sim.flags()[5], sim.grid().flag(5));
+    state[5].set_rho(2.0);
+    ASSERT_EQ(sim.grid().rho(5), 2.0);
+}
+
+TEST(SimulationTest, testStateWritesGetTheBoundaryConditions)
+{
+    // A wall point in the middle of the bottom, given momentum the wall
+    // condition removes
+    int wall = 8;
+    Point perturbed(1.0, 0.5, 0.5, 2.0);
+
+    auto reference_opt = channel_options(16);
+    PointFunctions pf(reference_opt->mach(), reference_opt->gam());
+    SolverContext context;
+    CartesianGrid grid(*reference_opt);
+    auto tool = Solver::create_tool(*reference_opt, pf, context, grid);
+    RungeKuttaIntegrator<CartesianGrid, CartesianVariation> integrator(
+        *reference_opt, grid, tool, pf, context);
+    integrator.start();
+    grid.set_values(perturbed, wall);
+    tool->update_values(&grid, integrator.time());
+    ASSERT_EQ(grid.ru(wall), 0.0);
+    integrator.step();
+
+    auto opt = channel_options(16);
+    Simulation sim(*opt);
+    sim.state()[wall] = StoredPoint(perturbed);
+    sim.step();
+    auto state = sim.state();
+    ASSERT_EQ(state.size(), static_cast<size_t>(grid.nPointsTotal));
+    for (size_t ind = 0; ind < state.size(); ind++) {
+        ASSERT_EQ(state[ind].rho(), grid.rho(ind));
+        ASSERT_EQ(state[ind].ru(), grid.ru(ind));
+        ASSERT_EQ(state[ind].rv(), grid.rv(ind));
+        ASSERT_EQ(state[ind].e(), grid.e(ind));
+    }
+}
+
+TEST(SimulationTest, testMemoryInputSizeIsChecked)
+{
+    auto opt = channel_options(16);
+    auto constants = opt->memory_constants();
+    auto components = opt->memory_components();
+    components.flags_c.pop_back();
+    opt->set_memory_input(constants, components);
+    ASSERT_THROW(Simulation sim(*opt), int);
+}
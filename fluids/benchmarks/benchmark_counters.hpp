@@ -0,0 +1,108 @@
+/**
+ * \file benchmark_counters.hpp
+ * @brief Per-point counters shared by the kernel benchmarks
+ */
+#ifndef BENCHMARK_COUNTERS_HPP
+#define BENCHMARK_COUNTERS_HPP
+
+#include "synthetic_grid.hpp"
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+/**
+ * @brief Minimum memory traffic of a pointwise kernel: the state and flag of
+ * the point are read once and its result is written once
+ */
+template <typename Result>
+constexpr size_t compulsory_bytes()
+{
+    return sizeof(Point) + sizeof(int) + sizeof(Result);
+}
+
+/**
+ * @brief Reports time/point (printed in ns) and bytes/point for a kernel
+ * applied to n_points points per iteration
+ */
+inline void report_per_point(
+    benchmark::State& state, size_t n_points, size_t bytes_per_point)
+{
+    auto points = static_cast<int64_t>(n_points);
+    state.SetItemsProcessed(state.iterations() * points);
+    state.SetBytesProcessed(
+        state.iterations() * points * static_cast<int64_t>(bytes_per_point));
+    state.counters["time_per_point"] = benchmark::Counter(points,
+        benchmark::Counter::kIsIterationInvariantRate
+            | benchmark::Counter::kInvert);
+    state.counters["bytes_per_point"]
+        = benchmark::Counter(static_cast<double>(bytes_per_point));
+}
+
+/**
+ * @brief Grid sizes n of the benchmarks: the space or comma separated list
+ * in the BENCHMARK_GRID_SIZES environment variable, 64 256 1024 if unset.
+ * Benchmarks are registered before main, so a command line flag would come
+ * too late
+ */
+inline std::vector<int> grid_sizes()
+{
+    const char* variable = std::getenv("BENCHMARK_GRID_SIZES");
+    if (variable == nullptr) {
+        return {64, 256, 1024};
+    }
+    std::string list(variable);
+    for (auto& c : list) {
+        c = (c == ',') ? ' ' : c;
+    }
+    std::istringstream input(list);
+    std::vector<int> sizes;
+    int n;
+    while (input >> n and n > 0) {
+        sizes.push_back(n);
+    }
+    if (!input.eof() or sizes.empty()) {
+        std::cerr << "BENCHMARK_GRID_SIZES must list positive grid sizes, not \""
+                  << variable << "\"" << std::endl;
+        throw(-1);
+    }
+    return sizes;
+}
+
+/**
+ * @brief Runs the benchmark on n^2 grids of every layout (0: INTERIOR,
+ * 1: WALLS, 2: BODY), for every n of grid_sizes()
+ */
+inline void all_layouts(benchmark::internal::Benchmark* b)
+{
+    for (int n : grid_sizes()) {
+        for (auto layout : {SyntheticLayout::INTERIOR, SyntheticLayout::WALLS,
+                 SyntheticLayout::BODY}) {
+            b->Args({n, static_cast<int>(layout)});
+        }
+    }
+    b->ArgNames({"n", "layout"});
+}
+
+/**
+ * @brief As all_layouts, for kernels that need boundary points
+ */
+inline void wall_layouts(benchmark::internal::Benchmark* b)
+{
+    for (int n : grid_sizes()) {
+        for (auto layout : {SyntheticLayout::WALLS, SyntheticLayout::BODY}) {
+            b->Args({n, static_cast<int>(layout)});
+        }
+    }
+    b->ArgNames({"n", "layout"});
+}
+
+inline SyntheticGrid& grid_for(const benchmark::State& state)
+{
+    return SyntheticGrid::get(static_cast<int>(state.range(0)),
+        static_cast<SyntheticLayout>(state.range(1)));
+}
+
+#endif /* BENCHMARK_COUNTERS_HPP */
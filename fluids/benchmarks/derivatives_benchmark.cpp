@@ -0,0 +1,45 @@
+#include "../derivatives/derivatives.hpp"
+#include "../derivatives/derivatives_factory.hpp"
+#include "benchmark_counters.hpp"
+#include <string>
+
+namespace {
+void BM_derivative(benchmark::State& state, const std::string& der_type,
+    int order, DerFunction der_function)
+{
+    auto& synthetic = grid_for(state);
+    auto der = create_derivative(der_type, synthetic.pf, synthetic.grid, order);
+    auto& grid = synthetic.grid;
+    auto& points = synthetic.active_points;
+    for (auto _ : state) {
+        for (int ind : points) {
+            benchmark::DoNotOptimize(
+                ((*der).*der_function)(grid, alias::RHO, ind));
+        }
+    }
+    report_per_point(state, points.size(), compulsory_bytes<double>());
+}
+
+const auto DX = static_cast<DerFunction>(&Derivatives::DX);
+const auto DXX = static_cast<DerFunction>(&Derivatives::DXX);
+const auto DXY = static_cast<DerFunction>(&Derivatives::DXY);
+} // namespace
+
+BENCHMARK_CAPTURE(BM_derivative, regular_DX, "REGULAR", 2, DX)
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_derivative, regular_DXX, "REGULAR", 2, DXX)
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_derivative, regular_DXY, "REGULAR", 2, DXY)
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_derivative, fourth_DX, "REGULAR", 4, DX)
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_derivative, fourth_DXX, "REGULAR", 4, DXX)
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_derivative, fourth_DXY, "REGULAR", 4, DXY)
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_derivative, irregular_DX, "KARAGIOZIS", 2, DX)
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_derivative, irregular_DXX, "KARAGIOZIS", 2, DXX)
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_derivative, irregular_DXY, "KARAGIOZIS", 2, DXY)
+    ->Apply(all_layouts);
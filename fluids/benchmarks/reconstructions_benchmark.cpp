@@ -0,0 +1,94 @@
+#include "../derivatives/derivatives_factory.hpp"
+#include "../reconstructions/abstract_convection.hpp"
+#include "../reconstructions/abstract_dissipation.hpp"
+#include "../reconstructions/convection_factory.hpp"
+#include "../reconstructions/flux_functions/flux_factory.hpp"
+#include "../reconstructions/simple_dissipation.hpp"
+#include "../reconstructions/split_convection_cached.hpp"
+#include "../utils/operators_overloads.hpp"
+#include "benchmark_counters.hpp"
+#include <memory>
+#include <string>
+
+namespace {
+std::shared_ptr<Convection> make_convection(
+    SyntheticGrid& synthetic, const std::string& conv_type)
+{
+    auto der = create_derivative("REGULAR", synthetic.pf, synthetic.grid);
+    if (conv_type == "SPLIT_CONVECTION_CACHED") {
+        return std::make_shared<SplitConvectionCached>(synthetic.pf, der,
+            create_flux(synthetic.opt, synthetic.pf, synthetic.context));
+    }
+    return create_convection(
+        synthetic.opt, synthetic.pf, synthetic.context, der, conv_type);
+}
+
+void BM_convection(benchmark::State& state, const std::string& conv_type)
+{
+    auto& synthetic = grid_for(state);
+    auto conv = make_convection(synthetic, conv_type);
+    auto& grid = synthetic.grid;
+    auto& points = synthetic.active_points;
+    for (auto _ : state) {
+        conv->init(grid);
+        for (int ind : points) {
+            benchmark::DoNotOptimize(
+                conv->convection_x(grid, ind) + conv->convection_y(grid, ind));
+        }
+    }
+    report_per_point(state, points.size(), compulsory_bytes<Flux>());
+}
+
+void BM_simple_dissipation(benchmark::State& state)
+{
+    auto& synthetic = grid_for(state);
+    auto der = create_derivative("REGULAR", synthetic.pf, synthetic.grid);
+    SimpleDissipation diss(
+        synthetic.pf, der, synthetic.opt.reynolds(), synthetic.opt.prandtl());
+    auto& grid = synthetic.grid;
+    auto& points = synthetic.active_points;
+    for (auto _ : state) {
+        for (int ind : points) {
+            benchmark::DoNotOptimize(diss.dissipation_x(grid, ind)
+                + diss.dissipation_y(grid, ind));
+        }
+    }
+    report_per_point(state, points.size(), compulsory_bytes<Flux>());
+}
+
+void BM_flux(benchmark::State& state, const std::string& flux_type)
+{
+    auto& synthetic = grid_for(state);
+    auto flux = create_flux(
+        synthetic.opt, synthetic.pf, synthetic.context, flux_type);
+    auto& grid = synthetic.grid;
+    auto& points = synthetic.active_points;
+    for (auto _ : state) {
+        for (int ind : points) {
+            const auto& p = grid.values(ind);
+            benchmark::DoNotOptimize(flux->fluxX(p));
+            benchmark::DoNotOptimize(flux->fluxXPositive(p));
+            benchmark::DoNotOptimize(flux->fluxXNegative(p));
+        }
+    }
+    report_per_point(state, points.size(),
+        sizeof(Point) + sizeof(int) + 3 * sizeof(Flux));
+}
+} // namespace
+
+BENCHMARK_CAPTURE(BM_convection, simple, "SIMPLE")->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_convection, skew_symmetric, "SKEW_SYMMETRIC")
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_convection, split, "SPLIT_CONVECTION")
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_convection, split_cached, "SPLIT_CONVECTION_CACHED")
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_convection, simple_flux, "SIMPLE_FLUX")
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_convection, weno, "WENO_CONVECTION")->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_convection, mix, "MIX_CONVECTION")->Apply(all_layouts);
+BENCHMARK(BM_simple_dissipation)->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_flux, simple, "SIMPLE")->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_flux, steger_warming, "STEGER_WARMING")
+    ->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_flux, lax_friedrichs, "LF_FLUX")->Apply(all_layouts);
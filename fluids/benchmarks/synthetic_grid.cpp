@@ -0,0 +1,235 @@
+/**
+ * \file synthetic_grid.cpp
+ * @brief Implementation of the SyntheticGrid class
+ */
+#include "synthetic_grid.hpp"
+#include "../input_output/readers/reader.hpp"
+#include "../utils/flag_handler.hpp"
+#include <cmath>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <utility>
+
+namespace {
+const int DERX_SHIFT = 2;
+const int DERY_SHIFT = 10;
+const int MAX_STENCIL = 16;
+const double WALL_TYPE = 5;    // adiabatic no-slip wall
+const double RIGHT_OFFSET = 8; // right and top walls
+
+bool in_body(int n, int i, int j)
+{
+    int lo = 3 * n / 8;
+    int hi = 5 * n / 8;
+    return i >= lo and i < hi and j >= lo and j < hi;
+}
+
+bool on_edge(int n, int i, int j)
+{
+    return i == 0 or j == 0 or i == n - 1 or j == n - 1;
+}
+
+std::vector<int> point_types(int n, SyntheticLayout layout)
+{
+    std::vector<int> types(n * n, FLUID_POINT);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (layout == SyntheticLayout::BODY and in_body(n, i, j)) {
+                types[i * n + j] = SOLID_POINT;
+            }
+            else if (layout != SyntheticLayout::INTERIOR
+                and on_edge(n, i, j)) {
+                types[i * n + j] = BOUNDARY_POINT;
+            }
+        }
+    }
+    return types;
+}
+
+/**
+ * @brief Number of usable points from (i, j) in direction (di, dj), following
+ * setDerXFlags/setDerYFlags of create_input/derFlags.py
+ */
+int stencil_reach(
+    const std::vector<int>& types, int n, int i, int j, int di, int dj)
+{
+    int reach = 0;
+    bool stop = false;
+    while (reach < MAX_STENCIL and !stop) {
+        int ii = i + di * reach;
+        int jj = j + dj * reach;
+        if (ii < 0 or jj < 0 or ii >= n or jj >= n) {
+            stop = true;
+        }
+        else if (types[ii * n + jj] == SOLID_POINT) {
+            stop = true;
+        }
+        else if (types[ii * n + jj] == GHOST_POINT) {
+            reach++;
+            stop = true;
+        }
+        else {
+            reach++;
+        }
+    }
+    return std::max(0, reach - 1);
+}
+
+Point state_at(int n, int i, int j)
+{
+    double x = static_cast<double>(j) / n;
+    double y = static_cast<double>(i) / n;
+    double rho = 1.0 + 0.1 * std::sin(2 * M_PI * x) * std::cos(2 * M_PI * y);
+    double u = 0.2 + 0.05 * std::cos(2 * M_PI * y);
+    double v = 0.05 * std::sin(2 * M_PI * x);
+    double e = 40.0 + 0.5 * rho * (u * u + v * v);
+    return {rho, rho * u, rho * v, e};
+}
+} // namespace
+
+std::string layout_name(SyntheticLayout layout)
+{
+    switch (layout) {
+    case SyntheticLayout::INTERIOR:
+        return "interior";
+    case SyntheticLayout::WALLS:
+        return "walls";
+    case SyntheticLayout::BODY:
+        return "body";
+    }
+    return "";
+}
+
+std::string SyntheticGrid::mesh(int n, SyntheticLayout layout)
+{
+    auto types = point_types(n, layout);
+    std::ostringstream os;
+    os << n << " " << n << "\n"
+       << 1.0 / n << " " << 1.0 / n << "\n0.0 0.0\n";
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int type = types[i * n + j];
+            int flag = type;
+            if (type == FLUID_POINT or type == BOUNDARY_POINT) {
+                int left = stencil_reach(types, n, i, j, 0, -1);
+                int right = stencil_reach(types, n, i, j, 0, 1);
+                int down = stencil_reach(types, n, i, j, -1, 0);
+                int up = stencil_reach(types, n, i, j, 1, 0);
+                flag += (left + 16 * right) << DERX_SHIFT;
+                flag += (down + 16 * up) << DERY_SHIFT;
+            }
+            os << flag << " ";
+        }
+        os << "\n";
+    }
+    return os.str();
+}
+
+std::string SyntheticGrid::initial_conditions(int n)
+{
+    std::ostringstream os;
+    os.precision(17);
+    os << n << " " << n << "\n";
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            auto p = state_at(n, i, j);
+            os << p.rho() << " " << p.ru() << " " << p.rv() << " " << p.e()
+               << "\n";
+        }
+    }
+    return os.str();
+}
+
+std::string SyntheticGrid::boundary(int n, SyntheticLayout layout)
+{
+    if (layout == SyntheticLayout::INTERIOR) {
+        return "0\n";
+    }
+    std::ostringstream os;
+    os << 4 * (n - 1) << "\n";
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (!on_edge(n, i, j)) {
+                continue;
+            }
+            bool x_boundary = (j == 0 or j == n - 1);
+            bool y_boundary = (i == 0 or i == n - 1);
+            double x_type = WALL_TYPE + (j == n - 1 ? RIGHT_OFFSET : 0);
+            double y_type = WALL_TYPE + (i == n - 1 ? RIGHT_OFFSET : 0);
+            os << i * n + j << "\n"
+               << x_boundary << " " << y_boundary << "\n"
+               << x_type << " " << y_type << "\n"
+               << "1.0 0.0 0.0 1.0 1.0\n"
+               << "0 0.0 0.0\n";
+        }
+    }
+    return os.str();
+}
+
+std::string SyntheticGrid::immersed_interface(int n, SyntheticLayout layout)
+{
+    std::ostringstream os;
+    os.precision(17);
+    std::vector<std::string> points;
+    if (layout == SyntheticLayout::BODY) {
+        auto types = point_types(n, layout);
+        auto solid = [&](int i, int j) {
+            return types[i * n + j] == SOLID_POINT;
+        };
+        auto add = [&](char type, int i, int j, const Point& p) {
+            std::ostringstream line;
+            line.precision(17);
+            line << type << " " << i << " " << j << " 0.5 0.0 " << p.rho()
+                 << " 0.0 0.0 " << p.e() << " " << p.rho() << " 0.0 0.0 "
+                 << p.e() << "\n";
+            points.push_back(line.str());
+        };
+        // A crossing of type x at (i, j) lies between (i, j) and (i, j + 1)
+        for (int i = 1; i < n - 1; i++) {
+            for (int j = 1; j < n - 2; j++) {
+                if (solid(i, j) != solid(i, j + 1)) {
+                    add('x', i, j, state_at(n, i, j));
+                }
+                if (solid(j, i) != solid(j + 1, i)) {
+                    add('y', j, i, state_at(n, j, i));
+                }
+            }
+        }
+    }
+    os << "KARAGIOZIS\n" << points.size() << "\n";
+    for (auto& line : points) {
+        os << line;
+    }
+    return os.str();
+}
+
+SyntheticGrid::SyntheticGrid(int n, SyntheticLayout layout)
+    : opt()
+    , pf(opt.mach(), opt.gam())
+    , grid(Reader(opt, std::istringstream(initial_conditions(n)),
+               std::istringstream(mesh(n, layout)),
+               std::istringstream(boundary(n, layout)),
+               std::istringstream(immersed_interface(n, layout)),
+               std::istringstream("SHOCK\n0\n")),
+          opt)
+{
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        int type = flag_functions::point_type(grid.flag(ind));
+        if (type == FLUID_POINT or type == BOUNDARY_POINT) {
+            active_points.push_back(ind);
+        }
+    }
+}
+
+SyntheticGrid& SyntheticGrid::get(int n, SyntheticLayout layout)
+{
+    static std::map<std::pair<int, SyntheticLayout>,
+        std::unique_ptr<SyntheticGrid>>
+        grids;
+    auto& entry = grids[std::make_pair(n, layout)];
+    if (!entry) {
+        entry = std::make_unique<SyntheticGrid>(n, layout);
+    }
+    return *entry;
+}
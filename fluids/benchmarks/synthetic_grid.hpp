@@ -0,0 +1,55 @@
+/**
+ * \file synthetic_grid.hpp
+ * @brief Synthetic grids used by the kernel benchmarks
+ */
+#ifndef SYNTHETIC_GRID_HPP
+#define SYNTHETIC_GRID_HPP
+
+#include "../grid/karagiozis_grid.hpp"
+#include "../input_output/options.hpp"
+#include "../utils/point_functions.hpp"
+#include "../utils/solver_context.hpp"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Point kinds present in a synthetic grid
+ *
+ * INTERIOR: fluid points only, derivatives become one-sided near the edges.
+ * WALLS: the outer ring is made of adiabatic no-slip wall boundary points.
+ * BODY: walls plus a square immersed body (a quarter of the domain wide) in
+ * the middle, described by Karagiozis discontinuities.
+ */
+enum class SyntheticLayout { INTERIOR, WALLS, BODY };
+
+std::string layout_name(SyntheticLayout layout);
+
+/**
+ * \class SyntheticGrid
+ * @brief Smooth flow on a n x n grid with flags built as derFlags.py does
+ */
+class SyntheticGrid {
+public:
+    SyntheticGrid(int n, SyntheticLayout layout);
+
+    Options opt;
+    PointFunctions pf;
+    SolverContext context; ///< Wave speeds stay 0
+    KaragiozisGrid grid;
+    std::vector<int> active_points; ///< Fluid and boundary points
+
+    /**
+     * @brief Grid shared by every benchmark using the same size and layout
+     */
+    static SyntheticGrid& get(int n, SyntheticLayout layout);
+
+    /** @name Input files of the grid, as read by Reader
+     * @{ */
+    static std::string mesh(int n, SyntheticLayout layout);
+    static std::string initial_conditions(int n);
+    static std::string boundary(int n, SyntheticLayout layout);
+    static std::string immersed_interface(int n, SyntheticLayout layout);
+    /**  @} */
+};
+
+#endif /* SYNTHETIC_GRID_HPP */
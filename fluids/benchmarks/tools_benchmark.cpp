@@ -0,0 +1,60 @@
+#include "../boundary/boundary.hpp"
+#include "../derivatives/derivatives_factory.hpp"
+#include "../utils/boundary_point_def.hpp"
+#include "../utils/filters/minimal_filter_3_moments.hpp"
+#include "../utils/operators_overloads.hpp"
+#include "../utils/shock_detectors/luisa_detector_factory.hpp"
+#include "../utils/shock_detectors/luisa_shock_detector.hpp"
+#include "benchmark_counters.hpp"
+#include <string>
+
+namespace {
+void BM_boundary_convection_x(benchmark::State& state)
+{
+    auto& synthetic = grid_for(state);
+    auto der = create_derivative("REGULAR", synthetic.pf, synthetic.grid);
+    Boundary boundary(synthetic.pf, synthetic.context, der,
+        synthetic.opt.reynolds(), synthetic.opt.prandtl());
+    auto& grid = synthetic.grid;
+    auto& points = grid.boundary();
+    for (auto _ : state) {
+        for (auto& bp : points) {
+            benchmark::DoNotOptimize(boundary.convection_x(grid, bp, 0.0));
+        }
+    }
+    report_per_point(state, points.size(),
+        sizeof(BoundaryPoint) + compulsory_bytes<Flux>());
+}
+
+void BM_minimal_filter(benchmark::State& state)
+{
+    auto& synthetic = grid_for(state);
+    // filter_grid changes the grid, so it works on a copy
+    KaragiozisGrid grid(synthetic.grid);
+    MinimalFilter3Moments filter;
+    for (auto _ : state) {
+        filter.filter_grid(&grid);
+        benchmark::ClobberMemory();
+    }
+    report_per_point(state, grid.nPointsTotal, compulsory_bytes<Point>());
+}
+
+void BM_luisa_detector(benchmark::State& state, const std::string& type)
+{
+    auto& synthetic = grid_for(state);
+    auto& grid = synthetic.grid;
+    auto detector = create_luisa_detector(
+        synthetic.opt, grid.nPointsI, grid.nPointsJ, type);
+    for (auto _ : state) {
+        detector->detect_shocks(grid);
+        benchmark::DoNotOptimize(detector->set_of_shocked_points().size());
+    }
+    report_per_point(state, grid.nPointsTotal, compulsory_bytes<double>());
+}
+} // namespace
+
+BENCHMARK(BM_boundary_convection_x)->Apply(wall_layouts);
+BENCHMARK(BM_minimal_filter)->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_luisa_detector, type_23, "TYPE_23")->Apply(all_layouts);
+BENCHMARK_CAPTURE(BM_luisa_detector, type_345, "TYPE_345")
+    ->Apply(all_layouts);
@@ -7,12 +7,13 @@
 #include "../grid/cartesian_grid.hpp"
 #include "../reconstructions/dissipation_tool.hpp"
 #include "../utils/boundary_point_def.hpp"
-#include "../utils/global_vars.hpp"
 #include "../utils/point_functions.hpp"
+#include "../utils/solver_context.hpp"
 
-Boundary::Boundary(PointFunctions& pf_in, std::shared_ptr<Derivatives> der_in,
-    double reynolds_in, double prandtl_in)
+Boundary::Boundary(PointFunctions& pf_in, const SolverContext& context_in,
+    std::shared_ptr<Derivatives> der_in, double reynolds_in, double prandtl_in)
     : pf(pf_in)
+    , context(context_in)
     , der(der_in)
     , gam(pf_in.gam)
     , lodi(Lodi(pf_in, der_in))
@@ -193,7 +194,7 @@ void Boundary::subsonic_outlet(LodiArray* lodi_a, const CartesianGrid& grid,
 
     if (fabs(vel_1) < c) { // Is in fact subsonic
         double pressure_correction = c * 0.9
-            * (1 - max_mach_number * max_mach_number)
+            * (1 - context.max_mach_number * context.max_mach_number)
             * (pf.pressure(point) - bconf.bp.p);
         if (bconf.is_left_or_bottom) {
             (*lodi_a)[3] = pressure_correction;
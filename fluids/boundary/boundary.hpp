@@ -14,6 +14,7 @@
 class CartesianGrid;
 class Derivatives;
 struct PointFunctions;
+struct SolverContext;
 struct BoundaryPoint;
 class DissipationTool;
 
@@ -28,12 +29,14 @@ public:
      * @brief Boundary constructor
      *
      * @param pf_in
+     * @param context_in State of the run, for the largest Mach number
      * @param der_in
      * @param reynolds_in
      * @param prandtl_in
      */
-    Boundary(PointFunctions& pf_in, std::shared_ptr<Derivatives> der_in,
-        double reynolds_in, double prandtl_in);
+    Boundary(PointFunctions& pf_in, const SolverContext& context_in,
+        std::shared_ptr<Derivatives> der_in, double reynolds_in,
+        double prandtl_in);
 
     /**
      * @brief Convection in x direction
@@ -92,6 +95,7 @@ public:
 private:
     // Utility parameters
     PointFunctions& pf;
+    const SolverContext& context;
     std::shared_ptr<Derivatives> der;
     const double gam;
     Lodi lodi;
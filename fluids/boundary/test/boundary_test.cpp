@@ -9,6 +9,7 @@
 #include "../../grid/test/cartesian_grid_test_interface.hpp"
 #include "../../input_output/options.hpp"
 #include "../../utils/point_functions.hpp"
+#include "../../utils/solver_context.hpp"
 #include "sample_inputs.inc"
 
 class BoundaryTest : public testing::Test {
@@ -28,7 +29,7 @@ protected:
         der = std::make_shared<RegularDerivatives>(
             *pf, grid->shiftX(), grid->shiftY(), grid->dx, grid->dy);
         boundary = std::make_shared<Boundary>(
-            *pf, der, opt.reynolds(), opt.prandtl());
+            *pf, context, der, opt.reynolds(), opt.prandtl());
         nPointsTotal = grid->nPointsTotal;
         nPointsI = grid->nPointsI;
         nPointsJ = grid->nPointsJ;
@@ -37,6 +38,7 @@ protected:
     std::shared_ptr<RegularDerivatives> der;
     std::shared_ptr<PointFunctions> pf;
     std::shared_ptr<Boundary> boundary;
+    SolverContext context;
     int nPointsI, nPointsJ, nPointsTotal;
     double dx, dy;
     Flux lower_x, lower_y;
@@ -1,11 +1,12 @@
 #ifndef DERIVATIVES_HPP
 #define DERIVATIVES_HPP
 
+#include "../grid/grid_shape.hpp"
+#include "../utils/point_def.hpp"
 #include "../utils/useful_alias.hpp"
 #include <functional>
 
 class CartesianGrid;
-struct Point;
 struct PointFunctions;
 struct Flux;
 
@@ -22,7 +23,12 @@ class Derivatives {
 public:
     const PointFunctions& pf;
     const int shiftX;
+#ifdef FIXED_NPOINTS_J
+    /// Constant in a build specialized for one grid size
+    static constexpr int shiftY = grid_shape::fixed_nPointsJ;
+#else
     const int shiftY;
+#endif
     const double dx;
     const double dy;
 
@@ -82,10 +88,13 @@ protected:
         double dx_in, double dy_in)
         : pf(pf_in)
         , shiftX(shiftX_in)
+#ifndef FIXED_NPOINTS_J
         , shiftY(shiftY_in)
+#endif
         , dx(dx_in)
         , dy(dy_in)
     {
+        static_cast<void>(shiftY_in);
     }
 };
 
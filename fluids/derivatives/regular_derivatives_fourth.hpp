@@ -6,6 +6,7 @@
 #define REGULAR_DERIVATIVES_FOURTH_HPP
 
 #include "derivatives.hpp"
+#include <cstdint>
 
 /**
  * \class RegularDerivativesFourth
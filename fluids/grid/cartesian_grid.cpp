@@ -5,6 +5,7 @@
 #include "./cartesian_grid.hpp"
 #include "../input_output/options.hpp"
 #include "../input_output/readers/reader.hpp"
+#include "../utils/binary_io.hpp"
 #include "../utils/flag_handler.hpp"
 
 CartesianGrid::CartesianGrid()
@@ -15,7 +16,9 @@ CartesianGrid::CartesianGrid()
     , dy(0.1)
     , xmin(0)
     , ymin(0)
-    , points_c(std::vector<Point>(nPointsTotal))
+    , points_c(memory::GridArray<StoredPoint>(nPointsTotal))
+    , topology_c(std::make_shared<GridTopology>())
+    , flags_c(topology_c->flags.data())
 {
 }
 
@@ -32,10 +35,24 @@ CartesianGrid::CartesianGrid(Reader reader)
     , dy(reader.dy())
     , xmin(reader.xmin())
     , ymin(reader.ymin())
-    , points_c(reader.grid())
-    , flags_c(reader.flags())
-    , boundary_c(reader.boundary())
+    , points_c(
+          memory::convert_to_grid_array<StoredPoint>(reader.grid()))
+    , topology_c(reader.topology())
+    , flags_c(topology_c->flags.data())
+    , decomposition_c(reader.decomposition())
 {
+    if (!grid_shape::fits(nPointsI, nPointsJ)) {
+        std::cerr << "Grid is " << nPointsI << "x" << nPointsJ
+                  << " but this build is specialized for "
+                  << grid_shape::fixed_nPointsI << "x"
+                  << grid_shape::fixed_nPointsJ << " grids" << std::endl;
+        throw(-1);
+    }
+}
+
+CartesianGrid CartesianGrid::whole_domain(Options& opt)
+{
+    return CartesianGrid(Reader(opt, false));
 }
 
 void CartesianGrid::update_values(CartesianGrid* grid_to_update_from)
@@ -61,8 +78,50 @@ void CartesianGrid::update_values(CartesianGrid* grid_to_update_from)
     points_c = grid_to_update_from->points_c;
 }
 
+void CartesianGrid::round_to_single()
+{
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (int ind = 0; ind < nPointsTotal; ind++) {
+        auto& p = points_c[ind];
+        p = Point(::round_to_single(p.rho()), ::round_to_single(p.ru()),
+            ::round_to_single(p.rv()), ::round_to_single(p.e()));
+    }
+}
+
 bool CartesianGrid::ind_is_valid(int ind) const
 {
     return (ind >= 0 and ind < nPointsI * nPointsJ
         and flag_functions::point_type(flags_c[ind]) != SOLID_POINT);
 }
+
+void CartesianGrid::save_state(std::ostream& os) const
+{
+    binary_io::write(os, nPointsI);
+    binary_io::write(os, nPointsJ);
+    binary_io::write(os, static_cast<int>(sizeof(storage_real)));
+    binary_io::write_vector(os, points_c);
+}
+
+void CartesianGrid::load_state(std::istream& is)
+{
+    int nI, nJ;
+    binary_io::read(is, nI);
+    binary_io::read(is, nJ);
+    if (nI != nPointsI or nJ != nPointsJ) {
+        std::cerr << "Checkpoint grid is " << nI << "x" << nJ
+                  << " but the current grid is " << nPointsI << "x" << nPointsJ
+                  << std::endl;
+        throw(-1);
+    }
+    int value_size;
+    binary_io::read(is, value_size);
+    if (value_size != static_cast<int>(sizeof(storage_real))) {
+        std::cerr << "Checkpoint values have " << value_size
+                  << " bytes but this build stores " << sizeof(storage_real)
+                  << std::endl;
+        throw(-1);
+    }
+    binary_io::read_vector(is, points_c);
+}
@@ -8,8 +8,14 @@
 class Options;
 class Reader;
 #include "../utils/boundary_point_def.hpp"
+#include "../utils/grid_topology_def.hpp"
+#include "grid_shape.hpp"
+#include "../utils/memory/grid_allocator.hpp"
+#include "../utils/parallel/decomposition.hpp"
 #include "../utils/point_def.hpp"
 
+#include <iosfwd>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -28,6 +34,11 @@ class CartesianGrid {
 public:
     CartesianGrid(Options& opt);                        ///< Main constructor
     CartesianGrid(const CartesianGrid& grid) = default; ///< Copy constructor
+    /**
+     * @brief Grid over the whole domain even when running on several
+     * processes, e.g. to collect their blocks for output
+     */
+    static CartesianGrid whole_domain(Options& opt);
     const int nPointsI;     ///< Number of grid lines
     const int nPointsJ;     ///< Number of grid columns
     const int nPointsTotal; ///< nPointsI*nPointsJ
@@ -49,7 +60,7 @@ public:
     /**
      * @name Accessors
      * @{ */
-    inline const Point& values(int ind) const { return points_c[ind]; }
+    inline const StoredPoint& values(int ind) const { return points_c[ind]; }
     inline double rho(int ind) const { return values(ind).rho(); }
     inline double ru(int ind) const { return values(ind).ru(); }
     inline double rv(int ind) const { return values(ind).rv(); }
@@ -58,11 +69,46 @@ public:
 
     inline const std::vector<BoundaryPoint>& boundary(void) const
     {
-        return boundary_c;
+        return topology_c->boundary;
     }
 
     double X(int ind) const { return xmin + dx * indJ(ind); }
     double Y(int ind) const { return ymin + dy * indI(ind); }
+
+    /**
+     * @brief Values and flags of all points, in index order, for code that
+     * reads or writes the whole state in place
+     */
+    StoredPoint* values_data() { return points_c.data(); }
+    const StoredPoint* values_data() const { return points_c.data(); }
+    const int* flags_data() const { return flags_c; }
+    /**
+     * @brief Flags and boundary points, which copies of the grid and grids
+     * built from the same memory input share
+     */
+    const std::shared_ptr<const GridTopology>& topology() const
+    {
+        return topology_c;
+    }
+    /**  @} */
+
+    /**
+     * @name Domain decomposition
+     * @{ */
+
+    /**
+     * @brief Block of the domain stored in this process, nullptr when the
+     * grid holds the whole domain. The grid then holds ghost points copied
+     * from other processes besides the points it owns
+     */
+    const std::shared_ptr<const parallel::Decomposition>& decomposition() const
+    {
+        return decomposition_c;
+    }
+    bool is_owned(int ind) const
+    {
+        return !decomposition_c or decomposition_c->is_owned(ind);
+    }
     /**  @} */
 
     /**
@@ -74,6 +120,11 @@ public:
     inline void setRV(double val, int ind) { _values(ind).set_rv(val); }
     inline void setE(double val, int ind) { _values(ind).set_e(val); }
     inline void set_values(Point p, int ind) { _values(ind) = p; }
+    /**
+     * @brief Rounds every value as a single precision store would, so a
+     * double build can show the effect of SINGLE_PRECISION_STORAGE
+     */
+    void round_to_single();
     /**  @} */
 
     /**
@@ -85,6 +136,13 @@ public:
      */
     virtual void grid_specific_update() {}
 
+    /**
+     * @brief Whether grid_specific_update reads the values of neighbor
+     * points, whose ghost copies must then be refreshed first on a
+     * decomposed grid
+     */
+    virtual bool update_reads_neighbors() const { return false; }
+
     /**
      * @brief Executed once before a RK step
      *
@@ -104,26 +162,26 @@ public:
      * @name Index manipulation functions
      * @{ */
 
-    int indI(int ind) const { return ind / nPointsJ; /*C-style arrays*/ }
-    int indJ(int ind) const { return ind % nPointsJ; /*C-style arrays*/ }
+    int indI(int ind) const { return ind / columns(); /*C-style arrays*/ }
+    int indJ(int ind) const { return ind % columns(); /*C-style arrays*/ }
     int indIPlusOne(int ind) const { return IND(indI(ind) + 1, indJ(ind)); }
     int indIMinusOne(int ind) const { return IND(indI(ind) - 1, indJ(ind)); }
     int indJPlusOne(int ind) const { return IND(indI(ind), indJ(ind) + 1); }
     int indJMinusOne(int ind) const { return IND(indI(ind), indJ(ind) - 1); }
-    bool i_is_valid(int i) const { return (i >= 0 and i < nPointsI); }
-    bool j_is_valid(int j) const { return (j >= 0 and j < nPointsJ); }
+    bool i_is_valid(int i) const { return (i >= 0 and i < lines()); }
+    bool j_is_valid(int j) const { return (j >= 0 and j < columns()); }
     bool ind_is_valid(int ind) const;
     int IND(int i, int j) const //!< Boundary-aware index calculation
     {
         if (i_is_valid(i) and j_is_valid(j))
-            return i * nPointsJ + j;
+            return i * columns() + j;
         else
             return -1;
     }
     int IND(std::pair<int, int> p) const { return IND(p.first, p.second); }
 
     int shiftX(void) const { return 1; /*C-style arrays*/ }
-    int shiftY(void) const { return nPointsJ; /*C-style arrays*/ }
+    int shiftY(void) const { return columns(); /*C-style arrays*/ }
 
     std::pair<int, int> indIJ(int ind) const
     {
@@ -132,15 +190,39 @@ public:
     /**  @} */
     virtual void specific_print() {}
 
+    /**
+     * @name Checkpointing
+     * @{ */
+
+    /**
+     * @brief Writes everything that evolves in time to os
+     */
+    virtual void save_state(std::ostream& os) const;
+
+    /**
+     * @brief Restores what save_state wrote. The grid must have been built
+     * from the same case files
+     */
+    virtual void load_state(std::istream& is);
+    /**  @} */
+
 protected:
     CartesianGrid();
     CartesianGrid(Reader reader);
 
 private:
-    std::vector<Point> points_c;
-    std::vector<int> flags_c;
-    std::vector<BoundaryPoint> boundary_c;
-    inline Point& _values(int ind) { return points_c[ind]; }
+    memory::GridArray<StoredPoint> points_c;
+    std::shared_ptr<const GridTopology> topology_c;
+    const int* flags_c; ///< topology_c->flags, read on every point
+    std::shared_ptr<const parallel::Decomposition> decomposition_c;
+    inline StoredPoint& _values(int ind) { return points_c[ind]; }
+    /**
+     * @brief nPointsI and nPointsJ, as constants in a build specialized for
+     * one grid size (see grid_shape.hpp)
+     * @{ */
+    int lines() const { return grid_shape::lines(nPointsI); }
+    int columns() const { return grid_shape::columns(nPointsJ); }
+    /**  @} */
 };
 
 #endif
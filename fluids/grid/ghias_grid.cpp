@@ -5,6 +5,7 @@
 #include "ghias_grid.hpp"
 #include "../input_output/options.hpp"
 #include "../input_output/readers/reader.hpp"
+#include <array>
 
 GhiasGrid::GhiasGrid(Options& opt)
     : GhiasGrid(Reader(opt), opt)
@@ -23,8 +24,8 @@ void GhiasGrid::grid_specific_update()
     // This assumes that (rho, T) use Neumann conditions and (ru, rv) use
     // Dirichlet conditions
     // Changing it is not too hard, but I'm not doing it
-    static std::vector<double> matrix(4 * 4);
-    static std::vector<double> sol(2 * 4);
+    std::vector<double> matrix(4 * 4);
+    std::vector<double> sol(2 * 4);
     Point res;
     for (auto& gp : ghias_points_c) {
         compute_dirichlet_values(gp, matrix, sol, res);
@@ -133,12 +134,12 @@ void GhiasGrid::fill_interpolation_vector_ru_rv(
 void GhiasGrid::compute_interpolation(
     std::vector<double>& matrix, std::vector<double>& sol)
 {
-    static std::vector<int> ipiv(4);
-    static int dim = 4;
-    static int nrhs = 2;
-    static int info;
+    std::array<int, 4> ipiv;
+    int dim = 4;
+    int nrhs = 2;
+    int info;
     // Call to LAPACK
-    dgesv_(&dim, &nrhs, &*matrix.begin(), &dim, &*ipiv.begin(), &*sol.begin(),
+    dgesv_(&dim, &nrhs, &*matrix.begin(), &dim, ipiv.data(), &*sol.begin(),
         &dim, &info);
     if (info != 0) {
         std::cerr << "[GHIAS_GRID] Problems with system solution!" << std::endl;
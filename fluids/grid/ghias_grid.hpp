@@ -22,6 +22,7 @@ public:
     GhiasGrid(Options& opt);
     GhiasGrid(Reader reader, Options& opt);
     virtual void grid_specific_update() override;
+    virtual bool update_reads_neighbors() const override { return true; }
 
 private:
     /**
@@ -5,6 +5,8 @@
 #include "ghias_shock_grid.hpp"
 #include "../input_output/options.hpp"
 #include "../input_output/readers/reader.hpp"
+#include "../utils/binary_io.hpp"
+#include <vector>
 
 GhiasShockGrid::GhiasShockGrid(Options& opt)
     : GhiasShockGrid(Reader(opt), opt)
@@ -37,3 +39,22 @@ void GhiasShockGrid::specific_print()
     }
     counter++;
 }
+
+void GhiasShockGrid::save_state(std::ostream& os) const
+{
+    GhiasGrid::save_state(os);
+    auto& shocked = shock_detector->set_of_shocked_points();
+    binary_io::write_vector(
+        os, std::vector<int>(shocked.begin(), shocked.end()));
+    binary_io::write(os, counter);
+}
+
+void GhiasShockGrid::load_state(std::istream& is)
+{
+    GhiasGrid::load_state(is);
+    std::vector<int> shocked;
+    binary_io::read_vector(is, shocked);
+    shock_detector->set_shocked_points(
+        std::set<int>(shocked.begin(), shocked.end()));
+    binary_io::read(is, counter);
+}
@@ -21,6 +21,8 @@ public:
     GhiasShockGrid(Reader reader, Options& opt);
     virtual void grid_specific_pre_update(double) override final;
     virtual void specific_print() override final;
+    virtual void save_state(std::ostream& os) const override;
+    virtual void load_state(std::istream& is) override;
     const std::set<int>& to_revisit() const
     {
         return shock_detector->set_of_shocked_points();
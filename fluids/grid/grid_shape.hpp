@@ -0,0 +1,53 @@
+/**
+ * \file grid_shape.hpp
+ * @brief Grid size compiled into the build, if any
+ *
+ * Configuring with -DFIXED_GRID_CASE=<gridInfo.dat or NIxNJ> defines
+ * FIXED_NPOINTS_I and FIXED_NPOINTS_J. CartesianGrid then takes its index
+ * math and stencil offsets from these constants instead of nPointsJ, so
+ * the divisions in indI()/indJ() become multiplications and the y shifts
+ * fold into the addresses. Such a build only runs grids of that size.
+ */
+#ifndef GRID_SHAPE_HPP
+#define GRID_SHAPE_HPP
+
+namespace grid_shape {
+
+#ifdef FIXED_NPOINTS_J
+constexpr int fixed_nPointsI = FIXED_NPOINTS_I;
+constexpr int fixed_nPointsJ = FIXED_NPOINTS_J;
+#else
+constexpr int fixed_nPointsI = 0; ///< 0 when the size is read at run time
+constexpr int fixed_nPointsJ = 0; ///< 0 when the size is read at run time
+#endif
+
+constexpr bool is_fixed() { return fixed_nPointsJ > 0; }
+
+/**
+ * @brief Lines of a grid read with nPointsI lines
+ */
+constexpr int lines(int nPointsI)
+{
+    return is_fixed() ? fixed_nPointsI : nPointsI;
+}
+
+/**
+ * @brief Columns of a grid read with nPointsJ columns
+ */
+constexpr int columns(int nPointsJ)
+{
+    return is_fixed() ? fixed_nPointsJ : nPointsJ;
+}
+
+/**
+ * @brief Whether the build can run a nPointsI x nPointsJ grid
+ */
+constexpr bool fits(int nPointsI, int nPointsJ)
+{
+    return !is_fixed()
+        or (nPointsI == fixed_nPointsI and nPointsJ == fixed_nPointsJ);
+}
+
+} // namespace grid_shape
+
+#endif /* GRID_SHAPE_HPP */
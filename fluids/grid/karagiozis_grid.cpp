@@ -7,6 +7,7 @@
 #include "../input_output/readers/reader.hpp"
 #include <algorithm>
 #include <iostream>
+#include <string>
 #include <tuple>
 #include <utility>
 
@@ -22,9 +23,16 @@ KaragiozisGrid::KaragiozisGrid(Reader reader, Options& opt)
 {
     KaragiozisGrid::fill_discontinuity_map();
     KaragiozisGrid::sort_lists();
-    std::ofstream outfile("./output/disc_points.txt");
+    // On a decomposed grid each process lists the discontinuities it owns
+    std::string suffix;
+    if (decomposition()) {
+        suffix = "_rank" + std::to_string(decomposition()->rank());
+    }
+    std::ofstream outfile("./output/disc_points" + suffix + ".txt");
     for (auto& dp : karagiozis_points_c) {
-        outfile << disc_X(&dp) << "," << disc_Y(&dp) << std::endl;
+        if (is_owned(dp.ind)) {
+            outfile << disc_X(&dp) << "," << disc_Y(&dp) << std::endl;
+        }
     }
 }
 
@@ -121,7 +129,8 @@ void KaragiozisGrid::set_points_to_revisit(GenericDiscontinuity* disc)
 
 void KaragiozisGrid::safe_insert_to_points_to_revisit(int ind)
 {
-    if (ind >= 0) {
+    // Ghost points are advanced by the process that owns them
+    if (ind >= 0 and is_owned(ind)) {
         points_to_revisit.insert(ind);
     }
 }
@@ -249,3 +258,32 @@ GenericDiscontinuity* KaragiozisGrid::last_disc_y(int ind) const
     const DiscontinuityList& vec = ymap->at(ind);
     return vec.back();
 }
+
+void KaragiozisGrid::save_state(std::ostream& os) const
+{
+    CartesianGrid::save_state(os);
+    binary_io::write(os, static_cast<uint64_t>(karagiozis_points_c.size()));
+    for (auto& bd : karagiozis_points_c) {
+        bd.save_state(os);
+    }
+}
+
+void KaragiozisGrid::load_state(std::istream& is)
+{
+    CartesianGrid::load_state(is);
+    uint64_t n_body_points;
+    binary_io::read(is, n_body_points);
+    if (n_body_points != karagiozis_points_c.size()) {
+        std::cerr << "Checkpoint has " << n_body_points
+                  << " body points but the case has "
+                  << karagiozis_points_c.size() << std::endl;
+        throw(-1);
+    }
+    for (auto& bd : karagiozis_points_c) {
+        bd.load_state(is);
+    }
+    points_to_revisit.clear();
+    clear_discontinuity_map();
+    KaragiozisGrid::fill_discontinuity_map();
+    KaragiozisGrid::sort_lists();
+}
@@ -27,6 +27,9 @@ public:
     KaragiozisGrid(Reader reader, Options& opt);
 
     virtual void grid_specific_update() override;
+    virtual bool update_reads_neighbors() const override { return true; }
+    virtual void save_state(std::ostream& os) const override;
+    virtual void load_state(std::istream& is) override;
 
     /**
      * @name Accessors
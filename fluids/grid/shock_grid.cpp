@@ -775,3 +775,27 @@ void ShockGrid::specific_print()
     }
     counter++;
 }
+
+void ShockGrid::save_state(std::ostream& os) const
+{
+    KaragiozisGrid::save_state(os);
+    binary_io::write(os, static_cast<uint64_t>(shock_points_c.size()));
+    for (auto& sp : shock_points_c) {
+        sp.save_state(os);
+    }
+    binary_io::write(os, counter);
+}
+
+void ShockGrid::load_state(std::istream& is)
+{
+    KaragiozisGrid::load_state(is);
+    uint64_t n_shocks;
+    binary_io::read(is, n_shocks);
+    shock_points_c.assign(n_shocks, ShockDiscontinuity());
+    for (auto& sp : shock_points_c) {
+        sp.load_state(is);
+    }
+    binary_io::read(is, counter);
+    clear_discontinuity_map();
+    ShockGrid::fill_discontinuity_map();
+}
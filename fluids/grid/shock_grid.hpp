@@ -30,6 +30,8 @@ public:
     bool remove_disconnected_shocks();
     bool delete_shock_near_wall();
     void specific_print() override final;
+    void save_state(std::ostream& os) const override;
+    void load_state(std::istream& is) override;
 
 private:
     std::vector<ShockDiscontinuity> shock_points_c;
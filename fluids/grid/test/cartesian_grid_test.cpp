@@ -19,10 +19,10 @@ TEST(CartesianGridTest, testDefaultConstructor)
     grid.setRV(v[2], ind);
     grid.setE(v[3], ind);
 
-    ASSERT_EQ(grid.rho(ind), v[0]);
-    ASSERT_EQ(grid.ru(ind), v[1]);
-    ASSERT_EQ(grid.rv(ind), v[2]);
-    ASSERT_EQ(grid.e(ind), v[3]);
+    ASSERT_EQ(grid.rho(ind), static_cast<storage_real>(v[0]));
+    ASSERT_EQ(grid.ru(ind), static_cast<storage_real>(v[1]));
+    ASSERT_EQ(grid.rv(ind), static_cast<storage_real>(v[2]));
+    ASSERT_EQ(grid.e(ind), static_cast<storage_real>(v[3]));
 }
 
 TEST(CartesianGridTest, testReaderConstructor)
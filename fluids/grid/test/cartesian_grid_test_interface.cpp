@@ -1,6 +1,8 @@
 #include "cartesian_grid_test_interface.hpp"
 #include "../../input_output/readers/reader.hpp"
 
+#include <sstream>
+
 CartesianGridTestInterface::CartesianGridTestInterface()
     : CartesianGrid::CartesianGrid()
 {
@@ -13,3 +15,21 @@ CartesianGridTestInterface::CartesianGridTestInterface(Options& opt,
           std::move(mesh_details), std::move(boundary_file)))
 {
 }
+
+CartesianGridTestInterface CartesianGridTestInterface::fluid_grid(
+    Options& opt, int nI, int nJ, double dx, double dy,
+    const std::function<Point(int, int)>& state)
+{
+    std::ostringstream mesh, initial;
+    mesh << nI << " " << nJ << "\n" << dx << " " << dy << "\n0.0 0.0\n";
+    initial << nI << " " << nJ << "\n";
+    for (int i = 0; i < nI; i++) {
+        for (int j = 0; j < nJ; j++) {
+            mesh << "0 ";
+            initial << state(i, j) << "\n";
+        }
+        mesh << "\n";
+    }
+    return CartesianGridTestInterface(opt, std::istringstream(initial.str()),
+        std::istringstream(mesh.str()), std::istringstream("0\n"));
+}
@@ -1,12 +1,23 @@
 #ifndef CARTESIAN_GRID_TEST_INTERFACE_HPP
 #define CARTESIAN_GRID_TEST_INTERFACE_HPP
+#include "../../utils/point_def.hpp"
 #include "../cartesian_grid.hpp"
 
+#include <functional>
+
 class CartesianGridTestInterface : public CartesianGrid {
 public:
     CartesianGridTestInterface();
     CartesianGridTestInterface(Options& opt, std::istream&& initial_grid,
         std::istream&& mesh_details, std::istream&& boundary_file);
+
+    /**
+     * @brief nI x nJ grid of fluid points only, without boundary points,
+     * whose point (i, j) starts from state(i, j). The lower left corner is
+     * at (0, 0)
+     */
+    static CartesianGridTestInterface fluid_grid(Options& opt, int nI, int nJ,
+        double dx, double dy, const std::function<Point(int, int)>& state);
 };
 
 #endif /* CARTESIAN_GRID_TEST_INTERFACE_HPP */
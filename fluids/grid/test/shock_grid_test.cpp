@@ -242,3 +242,54 @@ TEST(ShockGridTest, testRemoveShockNearWall)
 
     EXPECT_EQ(grid.shock_points().size(), 2);
 }
+
+TEST(ShockGridTest, testStateRoundTrip)
+{
+    std::istringstream initial_conditions(initial_conditions_sample);
+    std::istringstream mesh_details(grid_info_sample);
+    std::istringstream boundary_file(boundary_empty);
+    std::istringstream immersed_file(immersed_interface_simple);
+    std::istringstream shock_file(shock_points_simple);
+    Options opt;
+    Reader reader(opt, std::move(initial_conditions), std::move(mesh_details),
+        std::move(boundary_file), std::move(immersed_file),
+        std::move(shock_file));
+    ShockGrid grid(reader, opt);
+    grid.shock_points()[0].w = 0.3;
+    grid.shock_points()[1].sigma = 1.2;
+
+    std::stringstream state;
+    grid.save_state(state);
+
+    std::istringstream initial_conditions2(initial_conditions_sample);
+    std::istringstream mesh_details2(grid_info_sample);
+    std::istringstream boundary_file2(boundary_empty);
+    std::istringstream immersed_file2(immersed_interface_simple);
+    std::istringstream shock_file2("SHOCK\n0\n");
+    Reader reader2(opt, std::move(initial_conditions2),
+        std::move(mesh_details2), std::move(boundary_file2),
+        std::move(immersed_file2), std::move(shock_file2));
+    ShockGrid restored(reader2, opt);
+    ASSERT_EQ(restored.shock_points().size(), 0u);
+
+    restored.load_state(state);
+    auto& spts = restored.shock_points();
+    ASSERT_EQ(spts.size(), grid.shock_points().size());
+    for (size_t s = 0; s < spts.size(); s++) {
+        auto& original = grid.shock_points()[s];
+        EXPECT_EQ(spts[s].ind, original.ind);
+        EXPECT_EQ(spts[s].type, original.type);
+        EXPECT_EQ(spts[s].frac, original.frac);
+        EXPECT_EQ(spts[s].w, original.w);
+        EXPECT_EQ(spts[s].sigma, original.sigma);
+        EXPECT_EQ(spts[s].left(), original.left());
+        EXPECT_EQ(spts[s].right(), original.right());
+    }
+    EXPECT_EQ(restored.discontinuity_map_x()->size(),
+        grid.discontinuity_map_x()->size());
+    EXPECT_EQ(restored.discontinuity_map_y()->size(),
+        grid.discontinuity_map_y()->size());
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        ASSERT_EQ(restored.values(ind), grid.values(ind));
+    }
+}
@@ -2,8 +2,10 @@
 #define BASE_OPTION_HPP
 
 #include <string>
+#include <vector>
 struct BaseOpt {
     virtual void set(const std::string& in) = 0;
+    virtual void set_list(const std::vector<std::string>& in) { set(in[0]); }
     virtual ~BaseOpt(){};
     virtual std::string print() const { return std::string("no"); };
 };
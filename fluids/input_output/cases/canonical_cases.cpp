@@ -0,0 +1,453 @@
+/**
+ * \file canonical_cases.cpp
+ * @brief Generation of the canonical benchmark cases
+ */
+#include "canonical_cases.hpp"
+#include "../../utils/flag_handler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+
+namespace {
+const int DERX_SHIFT = 2;
+const int DERY_SHIFT = 10;
+const int MAX_STENCIL = 16;
+const double GAM = 1.4;
+
+const int SUBSONIC_INLET = 1;
+const int SUPERSONIC_INLET = 2;
+const int SUBSONIC_OUTLET = 3;
+const int SUPERSONIC_OUTLET = 4;
+const int WALL = 5;       // adiabatic no-slip wall
+const int FAR_SIDE = 8;   // added for right and top boundaries
+
+const double CYLINDER_X = 0.4;
+const double CYLINDER_Y = 0.5;
+const double CYLINDER_R = 0.1;
+const double DIAPHRAGM_WIDTH = 0.02;
+const double BODY_LAYER = 0.05;
+
+struct State {
+    double rho, u, v, p;
+};
+
+/**
+ * @brief Description of a case on the unit square
+ */
+struct CaseSetup {
+    double mach;
+    double reynolds;
+    std::function<State(double, double)> initial;
+    int left, right, bottom, top; ///< Boundary types on each side
+    State inflow;
+    bool cylinder;
+};
+
+double reference_pressure(double mach) { return 1 / (GAM * mach * mach); }
+
+CaseSetup setup_for(const std::string& case_name)
+{
+    CaseSetup setup{};
+    if (case_name == "SHOCK_TUBE") {
+        setup.mach = 1.0;
+        setup.reynolds = 1000.0;
+        double p0 = reference_pressure(setup.mach);
+        setup.initial = [p0](double x, double) {
+            // Sod states, joined over a short distance so the schemes without
+            // shock handling start from a resolved profile
+            double left = 0.5 * (1 - std::tanh((x - 0.5) / DIAPHRAGM_WIDTH));
+            return State{
+                0.125 + 0.875 * left, 0.0, 0.0, p0 * (0.1 + 0.9 * left)};
+        };
+        setup.left = setup.right = setup.bottom = setup.top = WALL;
+        setup.inflow = {1.0, 0.0, 0.0, p0};
+    }
+    else if (case_name == "CYLINDER") {
+        setup.mach = 2.0;
+        setup.reynolds = 1000.0;
+        State free_stream{1.0, 1.0, 0.0, reference_pressure(setup.mach)};
+        setup.initial = [free_stream](double, double) { return free_stream; };
+        setup.left = SUPERSONIC_INLET;
+        setup.right = setup.bottom = setup.top = SUPERSONIC_OUTLET;
+        setup.inflow = free_stream;
+        setup.cylinder = true;
+    }
+    else if (case_name == "CHANNEL") {
+        setup.mach = 0.3;
+        setup.reynolds = 100.0;
+        State inflow{1.0, 1.0, 0.0, reference_pressure(setup.mach)};
+        setup.initial = [inflow](double, double) { return inflow; };
+        setup.left = SUBSONIC_INLET;
+        setup.right = SUBSONIC_OUTLET;
+        setup.bottom = setup.top = WALL;
+        setup.inflow = inflow;
+    }
+    else {
+        std::cerr << "Unknown benchmark case " << case_name << std::endl;
+        throw(-1);
+    }
+    return setup;
+}
+
+bool uses_ghias(const std::string& solver_type)
+{
+    return solver_type == "GHIAS" or solver_type == "GHIAS_SHOCK";
+}
+
+bool inside_cylinder(double x, double y)
+{
+    return std::hypot(x - CYLINDER_X, y - CYLINDER_Y) < CYLINDER_R;
+}
+
+/**
+ * @brief Grid on the unit square; point (i, j) is at (j*h, i*h)
+ */
+class CaseGrid {
+public:
+    CaseGrid(int n_in, const CaseSetup& setup_in)
+        : n(n_in)
+        , h(1.0 / (n_in - 1))
+        , setup(setup_in)
+        , types(n_in * n_in, FLUID_POINT)
+        , ghost(n_in * n_in, false)
+    {
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n; j++) {
+                if (i == 0 or j == 0 or i == n - 1 or j == n - 1) {
+                    types[ind(i, j)] = BOUNDARY_POINT;
+                }
+                else if (setup.cylinder and inside_cylinder(x(j), y(i))) {
+                    types[ind(i, j)] = SOLID_POINT;
+                }
+            }
+        }
+        mark_ghost_points();
+    }
+
+    int ind(int i, int j) const { return i * n + j; }
+    double x(int j) const { return j * h; }
+    double y(int i) const { return i * h; }
+
+    std::string mesh() const;
+    std::string initial_conditions() const;
+    std::string boundary() const;
+    std::string karagiozis_interface() const;
+    std::string ghias_interface() const;
+
+private:
+    const int n;
+    const double h;
+    const CaseSetup& setup;
+    std::vector<int> types;
+    std::vector<bool> ghost;
+
+    void mark_ghost_points();
+    int stencil_reach(int i, int j, int di, int dj) const;
+};
+
+/**
+ * @brief Solid points with a fluid point among their 8 neighbours become
+ * ghost points, as in create_input/createMask.py (both immersed methods need
+ * a valid point on each side of a crossing)
+ */
+void CaseGrid::mark_ghost_points()
+{
+    for (int i = 1; i < n - 1; i++) {
+        for (int j = 1; j < n - 1; j++) {
+            if (types[ind(i, j)] != SOLID_POINT) {
+                continue;
+            }
+            bool near_fluid = false;
+            for (int di = -1; di <= 1; di++) {
+                for (int dj = -1; dj <= 1; dj++) {
+                    near_fluid = near_fluid
+                        or types[ind(i + di, j + dj)] != SOLID_POINT;
+                }
+            }
+            ghost[ind(i, j)] = near_fluid;
+        }
+    }
+    for (int k = 0; k < n * n; k++) {
+        if (ghost[k]) {
+            types[k] = GHOST_POINT;
+        }
+    }
+}
+
+/**
+ * @brief Same rule as setDerXFlags/setDerYFlags in create_input/derFlags.py
+ */
+int CaseGrid::stencil_reach(int i, int j, int di, int dj) const
+{
+    int reach = 0;
+    bool stop = false;
+    while (reach < MAX_STENCIL and !stop) {
+        int ii = i + di * reach;
+        int jj = j + dj * reach;
+        if (ii < 0 or jj < 0 or ii >= n or jj >= n
+            or types[ind(ii, jj)] == SOLID_POINT) {
+            stop = true;
+        }
+        else if (types[ind(ii, jj)] == GHOST_POINT) {
+            reach++;
+            stop = true;
+        }
+        else {
+            reach++;
+        }
+    }
+    return std::max(0, reach - 1);
+}
+
+std::string CaseGrid::mesh() const
+{
+    std::ostringstream os;
+    os.precision(17);
+    os << n << " " << n << "\n" << h << " " << h << "\n0.0 0.0\n";
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int flag = types[ind(i, j)];
+            if (flag == FLUID_POINT or flag == BOUNDARY_POINT) {
+                flag += (stencil_reach(i, j, 0, -1)
+                            + 16 * stencil_reach(i, j, 0, 1))
+                    << DERX_SHIFT;
+                flag += (stencil_reach(i, j, -1, 0)
+                            + 16 * stencil_reach(i, j, 1, 0))
+                    << DERY_SHIFT;
+            }
+            os << flag << " ";
+        }
+        os << "\n";
+    }
+    return os.str();
+}
+
+void write_point(std::ostream& os, const State& s)
+{
+    double e = s.p / (GAM - 1) + 0.5 * s.rho * (s.u * s.u + s.v * s.v);
+    os << s.rho << " " << s.rho * s.u << " " << s.rho * s.v << " " << e;
+}
+
+std::string CaseGrid::initial_conditions() const
+{
+    std::ostringstream os;
+    os.precision(17);
+    os << n << " " << n << "\n";
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            State s = setup.initial(x(j), y(i));
+            if (setup.cylinder) {
+                // Velocity rises smoothly from rest on the body, which
+                // avoids an impulsive start right at the wall
+                double gap = std::hypot(x(j) - CYLINDER_X, y(i) - CYLINDER_Y)
+                    - CYLINDER_R;
+                double ramp = std::tanh(std::max(gap, 0.0) / BODY_LAYER);
+                s.u *= ramp;
+                s.v *= ramp;
+            }
+            write_point(os, s);
+            os << "\n";
+        }
+    }
+    return os.str();
+}
+
+std::string CaseGrid::boundary() const
+{
+    std::ostringstream os;
+    os.precision(17);
+    os << 4 * (n - 1) << "\n";
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (types[ind(i, j)] != BOUNDARY_POINT) {
+                continue;
+            }
+            bool x_boundary = (j == 0 or j == n - 1);
+            bool y_boundary = (i == 0 or i == n - 1);
+            int x_type = (j == 0) ? setup.left : setup.right + FAR_SIDE;
+            int y_type = (i == 0) ? setup.bottom : setup.top + FAR_SIDE;
+            State s = setup.inflow;
+            double T = GAM * setup.mach * setup.mach * s.p / s.rho;
+            os << ind(i, j) << "\n"
+               << x_boundary << " " << y_boundary << "\n"
+               << x_type << " " << y_type << "\n"
+               << s.rho << " " << s.u << " " << s.v << " " << T << " " << s.p
+               << "\n0 0.0 0.0\n";
+        }
+    }
+    return os.str();
+}
+
+/**
+ * @brief Crossings of the grid lines with the cylinder. A crossing of type x
+ * at (i, j) lies between (i, j) and (i, j + 1), at x(j) + frac*h.
+ */
+std::string CaseGrid::karagiozis_interface() const
+{
+    std::vector<std::string> lines;
+    auto add = [&](char type, int i, int j, double frac, double theta) {
+        std::ostringstream line;
+        line.precision(17);
+        line << type << " " << i << " " << j << " " << frac << " " << theta
+             << " ";
+        State rest = setup.initial(x(j), y(i));
+        rest.u = rest.v = 0.0;
+        write_point(line, rest);
+        line << " ";
+        write_point(line, rest);
+        line << "\n";
+        lines.push_back(line.str());
+    };
+    for (int i = 1; i < n - 1; i++) {
+        for (int j = 1; j < n - 2; j++) {
+            if (inside_cylinder(x(j), y(i))
+                != inside_cylinder(x(j + 1), y(i))) {
+                double dy = y(i) - CYLINDER_Y;
+                double half = std::sqrt(CYLINDER_R * CYLINDER_R - dy * dy);
+                double xc = (x(j) < CYLINDER_X) ? CYLINDER_X - half
+                                                : CYLINDER_X + half;
+                add('x', i, j, (xc - x(j)) / h,
+                    std::atan2(dy, xc - CYLINDER_X));
+            }
+            if (inside_cylinder(x(i), y(j))
+                != inside_cylinder(x(i), y(j + 1))) {
+                double dx = x(i) - CYLINDER_X;
+                double half = std::sqrt(CYLINDER_R * CYLINDER_R - dx * dx);
+                double yc = (y(j) < CYLINDER_Y) ? CYLINDER_Y - half
+                                                : CYLINDER_Y + half;
+                add('y', j, i, (yc - y(j)) / h,
+                    std::atan2(yc - CYLINDER_Y, dx));
+            }
+        }
+    }
+    std::ostringstream os;
+    os << "KARAGIOZIS\n" << lines.size() << "\n";
+    for (auto& line : lines) {
+        os << line;
+    }
+    return os.str();
+}
+
+/**
+ * @brief Ghost points with the boundary point, normal and image point of each
+ * one, written as create_input/outputFunctions.py does
+ */
+std::string CaseGrid::ghias_interface() const
+{
+    auto closest_on_body = [&](int i, int j, double* bx, double* by,
+                               double* nx, double* ny) {
+        double dx = x(j) - CYLINDER_X;
+        double dy = y(i) - CYLINDER_Y;
+        double dist = std::max(std::hypot(dx, dy), 1e-12);
+        *nx = dx / dist;
+        *ny = dy / dist;
+        *bx = CYLINDER_X + CYLINDER_R * *nx;
+        *by = CYLINDER_Y + CYLINDER_R * *ny;
+    };
+
+    std::ostringstream body;
+    body.precision(15);
+    body << std::scientific;
+    int n_ghosts = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (!ghost[ind(i, j)]) {
+                continue;
+            }
+            double bx, by, nx, ny;
+            closest_on_body(i, j, &bx, &by, &nx, &ny);
+            double image_x = 2 * bx - x(j);
+            double image_y = 2 * by - y(i);
+            int ci = static_cast<int>(std::floor(image_y / h));
+            int cj = static_cast<int>(std::floor(image_x / h));
+            body << i << " " << j << "\n";
+            int neighbors[4][2]
+                = {{ci, cj}, {ci + 1, cj}, {ci + 1, cj + 1}, {ci, cj + 1}};
+            for (auto& nb : neighbors) {
+                if (ghost[ind(nb[0], nb[1])]) {
+                    double nbx, nby, nnx, nny;
+                    closest_on_body(nb[0], nb[1], &nbx, &nby, &nnx, &nny);
+                    body << "b " << nb[0] << " " << nb[1] << " " << nbx << " "
+                         << nby << " " << nnx << " " << nny << "\n";
+                }
+                else {
+                    body << "f " << nb[0] << " " << nb[1] << " " << x(nb[1])
+                         << " " << y(nb[0]) << " " << 0.0 << " " << 0.0
+                         << "\n";
+                }
+            }
+            body << image_x << " " << image_y << "\n\n";
+            n_ghosts++;
+        }
+    }
+    std::ostringstream os;
+    os << "GHIAS\n" << n_ghosts << "\n" << body.str();
+    return os.str();
+}
+} // namespace
+
+const std::vector<std::string>& canonical_case_names()
+{
+    static const std::vector<std::string> names
+        = {"SHOCK_TUBE", "CYLINDER", "CHANNEL"};
+    return names;
+}
+
+bool case_supports_solver(
+    const std::string& case_name, const std::string& solver_type)
+{
+    return !(case_name == "CYLINDER" and solver_type == "SIMPLE");
+}
+
+CaseInput create_canonical_case(
+    const std::string& case_name, int n, const std::string& solver_type)
+{
+    auto setup = setup_for(case_name);
+    bool ghias = uses_ghias(solver_type);
+    CaseGrid grid(n, setup);
+
+    CaseInput input;
+    input.mesh = grid.mesh();
+    input.initial_conditions = grid.initial_conditions();
+    input.boundary = grid.boundary();
+    if (!setup.cylinder) {
+        input.immersed_interface = ghias ? "GHIAS\n0\n" : "KARAGIOZIS\n0\n";
+    }
+    else {
+        input.immersed_interface
+            = ghias ? grid.ghias_interface() : grid.karagiozis_interface();
+    }
+    input.shock = "SHOCK\n0\n";
+
+    std::ostringstream options;
+    options << "SOLVER_TYPE = " << solver_type << "\n"
+            << "INTEGRATOR_TYPE = RUNGE_KUTTA\n"
+            << "MACH = " << setup.mach << "\n"
+            << "REYNOLDS = " << setup.reynolds << "\n"
+            << "GAMMA = " << GAM << "\n";
+    input.options = options.str();
+    return input;
+}
+
+std::string write_case_input(
+    const CaseInput& input, const std::string& directory)
+{
+    auto write_file = [&](const std::string& name, const std::string& data) {
+        std::ofstream output(directory + name);
+        if (!output.is_open()) {
+            std::cerr << "Could not open file " << directory + name
+                      << std::endl;
+            throw(-1);
+        }
+        output << data;
+    };
+    write_file("gridInfo.dat", input.mesh);
+    write_file("initialCondition.dat", input.initial_conditions);
+    write_file("boundary.dat", input.boundary);
+    write_file("immersedInterface.dat", input.immersed_interface);
+    write_file("shock.dat", input.shock);
+    return "INPUT_BASE_PATH = " + directory + "\n" + input.options;
+}
@@ -0,0 +1,61 @@
+/**
+ * \file canonical_cases.hpp
+ * @brief Input files of the canonical benchmark cases, generated in C++
+ */
+#ifndef CANONICAL_CASES_HPP
+#define CANONICAL_CASES_HPP
+
+#include <string>
+#include <vector>
+
+/**
+ * @brief Contents of the input files of a case and the options it needs
+ */
+struct CaseInput {
+    std::string mesh;
+    std::string initial_conditions;
+    std::string boundary;
+    std::string immersed_interface;
+    std::string shock;
+    std::string options; ///< Configuration lines fixing the physics
+};
+
+/**
+ * @brief Names of the canonical cases
+ *
+ * SHOCK_TUBE: Sod-type shock tube closed by walls (Re 1000).
+ * CYLINDER: Mach 2 flow around a cylinder, with supersonic inlet and outlets
+ * (Re 1000).
+ * CHANNEL: Mach 0.3 channel flow between no-slip walls (Re 100).
+ */
+const std::vector<std::string>& canonical_case_names();
+
+/**
+ * @brief Whether a case can run with a given SOLVER_TYPE
+ *
+ * The cylinder needs an immersed interface, so it does not run with SIMPLE.
+ */
+bool case_supports_solver(
+    const std::string& case_name, const std::string& solver_type);
+
+/**
+ * @brief Builds the input of a case on a n x n grid
+ *
+ * The immersed interface is written in the format of solver_type (Karagiozis
+ * discontinuities for KARAGIOZIS and SHOCK, Ghias ghost points for GHIAS and
+ * GHIAS_SHOCK). Flags follow create_input/derFlags.py.
+ */
+CaseInput create_canonical_case(
+    const std::string& case_name, int n, const std::string& solver_type);
+
+/**
+ * @brief Writes the input files to directory (which must exist), with the
+ * default input file names
+ *
+ * @return Configuration lines selecting directory as INPUT_BASE_PATH plus
+ * the options of the case
+ */
+std::string write_case_input(
+    const CaseInput& input, const std::string& directory);
+
+#endif /* CANONICAL_CASES_HPP */
@@ -0,0 +1,89 @@
+#include "../../../grid/ghias_grid.hpp"
+#include "../../../grid/karagiozis_grid.hpp"
+#include "../../../utils/flag_handler.hpp"
+#include "../../options.hpp"
+#include "../../readers/reader.hpp"
+#include "../canonical_cases.hpp"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <string>
+
+namespace {
+const int n = 32;
+
+Reader reader_for(Options& opt, const CaseInput& input)
+{
+    return Reader(opt, std::istringstream(input.initial_conditions),
+        std::istringstream(input.mesh), std::istringstream(input.boundary),
+        std::istringstream(input.immersed_interface),
+        std::istringstream(input.shock));
+}
+
+int count_type(const CartesianGrid& grid, int type)
+{
+    int count = 0;
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        count += (flag_functions::point_type(grid.flag(ind)) == type);
+    }
+    return count;
+}
+}
+
+TEST(CanonicalCasesTest, testEveryCaseBuilds)
+{
+    for (auto& name : canonical_case_names()) {
+        Options opt;
+        auto input = create_canonical_case(name, n, "KARAGIOZIS");
+        KaragiozisGrid grid(reader_for(opt, input), opt);
+        ASSERT_EQ(grid.nPointsTotal, n * n);
+        ASSERT_EQ(count_type(grid, BOUNDARY_POINT), 4 * (n - 1));
+        ASSERT_EQ(grid.boundary().size(), 4u * (n - 1));
+    }
+}
+
+TEST(CanonicalCasesTest, testCylinderInterfaces)
+{
+    Options opt;
+    auto karagiozis = create_canonical_case("CYLINDER", n, "KARAGIOZIS");
+    KaragiozisGrid k_grid(reader_for(opt, karagiozis), opt);
+    ASSERT_GT(k_grid.body_points().size(), 0u);
+    for (auto& bd : k_grid.body_points()) {
+        ASSERT_GE(bd.frac, 0.0);
+        ASSERT_LE(bd.frac, 1.0);
+    }
+
+    auto ghias = create_canonical_case("CYLINDER", n, "GHIAS");
+    GhiasGrid g_grid(reader_for(opt, ghias), opt);
+
+    std::istringstream interface(ghias.immersed_interface);
+    std::string type_name;
+    int n_ghosts;
+    interface >> type_name >> n_ghosts;
+    ASSERT_EQ(type_name, "GHIAS");
+    ASSERT_GT(n_ghosts, 0);
+    ASSERT_EQ(n_ghosts, count_type(g_grid, GHOST_POINT));
+    for (int gp = 0; gp < n_ghosts; gp++) {
+        int i, j;
+        double x, y, nx, ny;
+        char corner;
+        interface >> i >> j;
+        ASSERT_EQ(flag_functions::point_type(g_grid.flag(g_grid.IND(i, j))),
+            GHOST_POINT);
+        for (int k = 0; k < 4; k++) {
+            interface >> corner >> i >> j >> x >> y >> nx >> ny;
+            int type
+                = flag_functions::point_type(g_grid.flag(g_grid.IND(i, j)));
+            ASSERT_NE(type, SOLID_POINT);
+            ASSERT_EQ(corner, (type == GHOST_POINT) ? 'b' : 'f');
+        }
+        interface >> x >> y;
+    }
+}
+
+TEST(CanonicalCasesTest, testCylinderNeedsImmersedSolver)
+{
+    ASSERT_FALSE(case_supports_solver("CYLINDER", "SIMPLE"));
+    ASSERT_TRUE(case_supports_solver("CYLINDER", "GHIAS_SHOCK"));
+    ASSERT_TRUE(case_supports_solver("CHANNEL", "SIMPLE"));
+}
@@ -0,0 +1,242 @@
+/**
+ * \file checkpoint.cpp
+ * @brief Implementation of the Checkpointer class
+ */
+#include "checkpoint.hpp"
+#include "../../grid/cartesian_grid.hpp"
+#include "../../utils/binary_io.hpp"
+#include "../../utils/parallel/communicator.hpp"
+#include "../options.hpp"
+#include "../writers/output_manager.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <dirent.h>
+
+namespace {
+const char magic[4] = {'T', 'F', 'C', 'K'};
+const uint32_t version = 2;
+
+uint64_t fnv1a(const std::string& data)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : data) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes contents to file_name through a temporary file, so the file
+ * is either the old one or the complete new one
+ */
+bool atomic_write(const std::string& file_name, const std::string& contents)
+{
+    auto tmp_name = file_name + ".tmp";
+    {
+        std::ofstream output(tmp_name, std::ios::binary | std::ios::trunc);
+        if (!output.is_open()) {
+            std::cerr << "Could not open file " << tmp_name << std::endl;
+            return false;
+        }
+        output.write(contents.data(),
+            static_cast<std::streamsize>(contents.size()));
+        output.flush();
+        if (output.fail()) {
+            std::cerr << "Failed while writing to file " << tmp_name
+                      << std::endl;
+            return false;
+        }
+    }
+    if (std::rename(tmp_name.c_str(), file_name.c_str()) != 0) {
+        std::cerr << "Could not rename " << tmp_name << " to " << file_name
+                  << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Each process of a decomposed run checkpoints its own block
+ */
+std::string process_suffix()
+{
+    return parallel::size() > 1 ? "_rank" + std::to_string(parallel::rank())
+                                : "";
+}
+
+/**
+ * @brief Checkpoints named prefix_<step>.chk in directory, oldest first
+ */
+std::deque<std::string> existing_checkpoints(
+    const std::string& directory, const std::string& prefix)
+{
+    std::deque<std::string> found;
+    DIR* dir = opendir(directory.empty() ? "." : directory.c_str());
+    if (dir == nullptr) {
+        return found;
+    }
+    const std::string extension = ".chk";
+    while (dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() <= prefix.size() + extension.size()
+            or name.compare(0, prefix.size(), prefix) != 0
+            or name.compare(name.size() - extension.size(), extension.size(),
+                   extension)
+                != 0) {
+            continue;
+        }
+        auto number = name.substr(prefix.size(),
+            name.size() - prefix.size() - extension.size());
+        if (std::all_of(number.begin(), number.end(),
+                [](char c) { return std::isdigit(c) != 0; })) {
+            found.push_back(name);
+        }
+    }
+    closedir(dir);
+    // Zero padded step numbers sort by length, then alphabetically
+    std::sort(found.begin(), found.end(),
+        [](const std::string& a, const std::string& b) {
+            return a.size() != b.size() ? a.size() < b.size() : a < b;
+        });
+    for (auto& name : found) {
+        name = directory + name;
+    }
+    return found;
+}
+} // namespace
+
+Checkpointer::Checkpointer(Options& opt)
+    : base_name(opt.output_base_path() + opt.checkpoint_file_name()
+          + process_suffix())
+    , interval(opt.checkpoint_interval())
+    , keep(opt.checkpoint_keep())
+    , restart(opt.restart())
+    , restart_file(opt.restart_file())
+    , written(existing_checkpoints(opt.output_base_path(),
+          opt.checkpoint_file_name() + process_suffix() + "_"))
+{
+}
+
+void Checkpointer::save_if_due(const CartesianGrid& grid,
+    const OutputManager& output, double t, long step)
+{
+    if (interval > 0 and step % interval == 0) {
+        save(grid, output, t, step);
+    }
+}
+
+std::string Checkpointer::save(const CartesianGrid& grid,
+    const OutputManager& output, double t, long step)
+{
+    std::ostringstream payload_stream;
+    binary_io::write(payload_stream, t);
+    binary_io::write(payload_stream, static_cast<int64_t>(step));
+    output.save_state(payload_stream);
+    grid.save_state(payload_stream);
+    auto payload = payload_stream.str();
+
+    std::ostringstream file_stream;
+    file_stream.write(magic, 4);
+    binary_io::write(file_stream, version);
+    binary_io::write(file_stream, static_cast<uint64_t>(payload.size()));
+    file_stream.write(payload.data(), payload.size());
+    binary_io::write(file_stream, fnv1a(payload));
+
+    std::string number = std::to_string(step);
+    std::string padded_number
+        = std::string(number.length() < 8 ? 8 - number.length() : 0, '0')
+        + number;
+    auto file_name = base_name + "_" + padded_number + ".chk";
+    if (!atomic_write(file_name, file_stream.str())
+        or !atomic_write(latest_file_name(), file_name + "\n")) {
+        return "";
+    }
+    std::cout << std::endl
+              << "Checkpoint " << file_name << "; t=" << t << std::endl;
+
+    remember(file_name);
+    while (keep > 0 and written.size() > static_cast<size_t>(keep)) {
+        std::remove(written.front().c_str());
+        written.pop_front();
+    }
+    return file_name;
+}
+
+double Checkpointer::load(
+    CartesianGrid& grid, OutputManager& output, long& step)
+{
+    std::string file_name = restart_file;
+    if (file_name == "LATEST") {
+        std::ifstream latest(latest_file_name());
+        if (!(latest >> file_name)) {
+            std::cerr << "Could not find the latest checkpoint in "
+                      << latest_file_name() << std::endl;
+            throw(-1);
+        }
+    }
+    double t = load_file(file_name, grid, output, step);
+    remember(file_name);
+    std::cout << "Restarting from " << file_name << "; t=" << t << std::endl;
+    return t;
+}
+
+void Checkpointer::remember(const std::string& file_name)
+{
+    auto previous = std::find(written.begin(), written.end(), file_name);
+    if (previous != written.end()) {
+        written.erase(previous);
+    }
+    written.push_back(file_name);
+}
+
+double Checkpointer::load_file(const std::string& file_name,
+    CartesianGrid& grid, OutputManager& output, long& step)
+{
+    std::ifstream input(file_name, std::ios::binary);
+    if (!input.is_open()) {
+        std::cerr << "Could not open file " << file_name << std::endl;
+        throw(-1);
+    }
+    char file_magic[4];
+    uint32_t file_version;
+    uint64_t payload_size;
+    input.read(file_magic, 4);
+    if (!input or !std::equal(magic, magic + 4, file_magic)) {
+        std::cerr << file_name << " is not a checkpoint" << std::endl;
+        throw(-1);
+    }
+    binary_io::read(input, file_version);
+    if (file_version != version) {
+        std::cerr << "Unsupported checkpoint version " << file_version
+                  << std::endl;
+        throw(-1);
+    }
+    binary_io::read(input, payload_size);
+    std::string payload(payload_size, '\0');
+    input.read(&payload[0], static_cast<std::streamsize>(payload_size));
+    uint64_t checksum = 0;
+    if (input) {
+        binary_io::read(input, checksum);
+    }
+    if (!input or checksum != fnv1a(payload)) {
+        std::cerr << "Checkpoint " << file_name << " is corrupted" << std::endl;
+        throw(-1);
+    }
+
+    std::istringstream payload_stream(payload);
+    double t;
+    int64_t stored_step;
+    binary_io::read(payload_stream, t);
+    binary_io::read(payload_stream, stored_step);
+    output.load_state(payload_stream);
+    grid.load_state(payload_stream);
+    step = static_cast<long>(stored_step);
+    return t;
+}
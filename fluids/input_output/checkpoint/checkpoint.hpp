@@ -0,0 +1,82 @@
+/**
+ * \file checkpoint.hpp
+ * @brief Binary checkpoints for restarting a run
+ */
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <deque>
+#include <string>
+
+class CartesianGrid;
+class Options;
+class OutputManager;
+
+/**
+ * \class Checkpointer
+ * @brief Writes and reads binary checkpoints of a run
+ *
+ * A checkpoint holds the time, the step number, the state of the output
+ * streams and the grid state (see CartesianGrid::save_state), so a restarted
+ * run continues bit-identically. Checkpoints are written every
+ * CHECKPOINT_INTERVAL steps to OUTPUT_BASE_PATH/CHECKPOINT_FILE_NAME_<step>.chk
+ * through a temporary file and a rename, so a crash while writing never
+ * leaves a truncated checkpoint behind. Only the last CHECKPOINT_KEEP files
+ * are kept, counting those of the case already in OUTPUT_BASE_PATH when the
+ * run starts, and OUTPUT_BASE_PATH/CHECKPOINT_FILE_NAME.latest names the
+ * newest one. With RESTART = TRUE the run starts from RESTART_FILE, or from
+ * the newest checkpoint if RESTART_FILE = LATEST. In runs on several
+ * processes every process writes its own files, named
+ * CHECKPOINT_FILE_NAME_rank<N>.
+ */
+class Checkpointer {
+public:
+    Checkpointer(Options& opt);
+
+    bool restart_requested() const { return restart; }
+
+    /**
+     * @brief Saves a checkpoint if step is a multiple of the interval
+     */
+    void save_if_due(const CartesianGrid& grid, const OutputManager& output,
+        double t, long step);
+
+    /**
+     * @brief Saves a checkpoint and removes the ones no longer kept
+     *
+     * @return Name of the checkpoint file
+     */
+    std::string save(const CartesianGrid& grid, const OutputManager& output,
+        double t, long step);
+
+    /**
+     * @brief Restores grid and output state from the restart file
+     *
+     * @param step Receives the step number stored in the checkpoint
+     * @return Time stored in the checkpoint
+     */
+    double load(CartesianGrid& grid, OutputManager& output, long& step);
+
+    /**
+     * @brief Restores grid and output state from a given file
+     */
+    static double load_file(const std::string& file_name, CartesianGrid& grid,
+        OutputManager& output, long& step);
+
+private:
+    const std::string base_name;
+    const int interval;
+    const int keep;
+    const bool restart;
+    const std::string restart_file;
+    std::deque<std::string> written; ///< Checkpoints on disk, oldest first
+
+    /**
+     * @brief Moves file_name to the newest end of written
+     */
+    void remember(const std::string& file_name);
+
+    std::string latest_file_name() const { return base_name + ".latest"; }
+};
+
+#endif /* CHECKPOINT_HPP */
@@ -0,0 +1,139 @@
+#include "../../../grid/test/cartesian_grid_test_interface.hpp"
+#include "../../options.hpp"
+#include "../../writers/output_manager.hpp"
+#include "../checkpoint.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+namespace {
+const int nI = 6;
+const int nJ = 7;
+
+CartesianGridTestInterface small_grid(Options& opt, double shift)
+{
+    return CartesianGridTestInterface::fluid_grid(
+        opt, nI, nJ, 0.1, 0.1, [shift](int i, int j) {
+            return Point(1.0 + shift + std::sin(0.3 * i + 0.1 * j), 0.1 * i,
+                0.2 * j, 40.0 + shift);
+        });
+}
+
+bool file_exists(const std::string& name)
+{
+    std::ifstream f(name);
+    return f.good();
+}
+}
+
+TEST(CheckpointTest, testRoundTrip)
+{
+    std::istringstream stream("OUTPUT_BASE_PATH = ./\n"
+                              "CHECKPOINT_FILE_NAME = chk_round_trip\n"
+                              "CHECKPOINT_INTERVAL = 5\n");
+    Options opt(stream);
+    auto grid = small_grid(opt, 0.0);
+    OutputManager output(opt);
+    Checkpointer checkpointer(opt);
+
+    checkpointer.save_if_due(grid, output, 0.25, 4);
+    ASSERT_FALSE(file_exists("./chk_round_trip_00000004.chk"));
+    checkpointer.save_if_due(grid, output, 0.3, 5);
+    ASSERT_TRUE(file_exists("./chk_round_trip_00000005.chk"));
+
+    auto other = small_grid(opt, 1.0);
+    OutputManager other_output(opt);
+    long step = 0;
+    double t = Checkpointer::load_file(
+        "./chk_round_trip_00000005.chk", other, other_output, step);
+    ASSERT_EQ(t, 0.3);
+    ASSERT_EQ(step, 5);
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        ASSERT_EQ(other.rho(ind), grid.rho(ind));
+        ASSERT_EQ(other.ru(ind), grid.ru(ind));
+        ASSERT_EQ(other.rv(ind), grid.rv(ind));
+        ASSERT_EQ(other.e(ind), grid.e(ind));
+    }
+
+    std::istringstream restart_stream("OUTPUT_BASE_PATH = ./\n"
+                                      "CHECKPOINT_FILE_NAME = chk_round_trip\n"
+                                      "RESTART = TRUE\n");
+    Options restart_opt(restart_stream);
+    Checkpointer restarter(restart_opt);
+    ASSERT_TRUE(restarter.restart_requested());
+    auto restarted = small_grid(opt, 2.0);
+    ASSERT_EQ(restarter.load(restarted, other_output, step), 0.3);
+    ASSERT_EQ(restarted.rho(3), grid.rho(3));
+}
+
+TEST(CheckpointTest, testOnlyLastCheckpointsAreKept)
+{
+    std::istringstream stream("OUTPUT_BASE_PATH = ./\n"
+                              "CHECKPOINT_FILE_NAME = chk_keep\n"
+                              "CHECKPOINT_INTERVAL = 1\n"
+                              "CHECKPOINT_KEEP = 2\n");
+    Options opt(stream);
+    auto grid = small_grid(opt, 0.0);
+    OutputManager output(opt);
+    Checkpointer checkpointer(opt);
+
+    for (int step = 1; step <= 3; step++) {
+        checkpointer.save_if_due(grid, output, 0.1 * step, step);
+    }
+    ASSERT_FALSE(file_exists("./chk_keep_00000001.chk"));
+    ASSERT_TRUE(file_exists("./chk_keep_00000002.chk"));
+    ASSERT_TRUE(file_exists("./chk_keep_00000003.chk"));
+    ASSERT_FALSE(file_exists("./chk_keep_00000003.chk.tmp"));
+
+    std::ifstream latest("./chk_keep.latest");
+    std::string latest_name;
+    latest >> latest_name;
+    ASSERT_EQ(latest_name, "./chk_keep_00000003.chk");
+}
+
+TEST(CheckpointTest, testRestartedRunPrunesOlderCheckpoints)
+{
+    std::istringstream stream("OUTPUT_BASE_PATH = ./\n"
+                              "CHECKPOINT_FILE_NAME = chk_rescan\n"
+                              "CHECKPOINT_INTERVAL = 1\n"
+                              "CHECKPOINT_KEEP = 2\n");
+    Options opt(stream);
+    auto grid = small_grid(opt, 0.0);
+    OutputManager output(opt);
+    {
+        Checkpointer first_run(opt);
+        for (int step = 1; step <= 2; step++) {
+            first_run.save_if_due(grid, output, 0.1 * step, step);
+        }
+    }
+
+    Checkpointer second_run(opt);
+    second_run.save_if_due(grid, output, 0.3, 3);
+    ASSERT_FALSE(file_exists("./chk_rescan_00000001.chk"));
+    ASSERT_TRUE(file_exists("./chk_rescan_00000002.chk"));
+    ASSERT_TRUE(file_exists("./chk_rescan_00000003.chk"));
+}
+
+TEST(CheckpointTest, testCorruptedCheckpointIsRejected)
+{
+    std::istringstream stream("OUTPUT_BASE_PATH = ./\n"
+                              "CHECKPOINT_FILE_NAME = chk_corrupt\n");
+    Options opt(stream);
+    auto grid = small_grid(opt, 0.0);
+    OutputManager output(opt);
+    Checkpointer checkpointer(opt);
+    auto file_name = checkpointer.save(grid, output, 0.5, 10);
+
+    {
+        std::fstream file(file_name, std::ios::binary | std::ios::in
+                | std::ios::out);
+        file.seekp(40);
+        file.put('\x7f');
+    }
+    long step;
+    ASSERT_ANY_THROW(Checkpointer::load_file(file_name, grid, output, step));
+    ASSERT_ANY_THROW(
+        Checkpointer::load_file("./chk_missing.chk", grid, output, step));
+}
@@ -1,7 +1,11 @@
 #include "options.hpp"
 #include "options_types.hpp"
 #include "tokenizer.hpp"
+#include "../utils/grid_components_container_def.hpp"
+#include "../utils/grid_constants_container_def.hpp"
+#include "../utils/grid_topology_def.hpp"
 #include <iostream>
+#include <utility>
 
 Options::Options() : opt_map(Options::create_default_map()) {}
 
@@ -18,6 +22,58 @@ void Options::print_all() {
   }
 }
 
+void Options::set(const std::string &name, const std::string &value) {
+  std::string line = name + " = " + value;
+  std::string opt_name;
+  std::vector<std::string> opt_values;
+  std::string error_string;
+  if (!TokenizeString(line, opt_name, opt_values)) {
+    std::cerr << "Could not set option " << line << std::endl;
+    throw(-1);
+  }
+  if (!is_valid_opt(opt_name)) {
+    got_invalid_option(opt_name, error_string);
+  } else {
+    safe_set_option(opt_name, opt_values, error_string);
+  }
+  if (!error_string.empty()) {
+    std::cerr << error_string << std::endl;
+    throw(-1);
+  }
+}
+
+void Options::set_memory_input(GridConstantsContainer constants,
+                               GridComponentsContainer components) {
+  auto topology = std::make_shared<GridTopology>();
+  topology->flags = memory::to_grid_array(components.flags_c);
+  topology->boundary = components.boundary_c;
+  memory_topology_c = std::move(topology);
+  memory_constants_c =
+      std::make_shared<const GridConstantsContainer>(std::move(constants));
+  memory_components_c =
+      std::make_shared<const GridComponentsContainer>(std::move(components));
+  set("INPUT_TYPE", "MEMORY");
+}
+
+void Options::share_memory_input(const Options &other) {
+  if (!other.has_memory_input()) {
+    std::cerr << "No memory input to share" << std::endl;
+    throw(-1);
+  }
+  memory_constants_c = other.memory_constants_c;
+  memory_components_c = other.memory_components_c;
+  memory_topology_c = other.memory_topology_c;
+  set("INPUT_TYPE", "MEMORY");
+}
+
+const GridConstantsContainer &Options::memory_constants() const {
+  return *memory_constants_c;
+}
+
+const GridComponentsContainer &Options::memory_components() const {
+  return *memory_components_c;
+}
+
 std::map<std::string, std::unique_ptr<BaseOpt>> Options::create_default_map() {
 
   std::map<std::string, std::unique_ptr<BaseOpt>> def_map;
@@ -29,6 +85,7 @@ std::map<std::string, std::unique_ptr<BaseOpt>> Options::create_default_map() {
   def_map["MIX_PARAM"] = std::make_unique<DoubleOpt>("0.1");
 
   def_map["T_MAX"] = std::make_unique<DoubleOpt>("1.0");
+  def_map["MAX_STEPS"] = std::make_unique<IntOpt>("0");
   def_map["T_INIT"] = std::make_unique<DoubleOpt>("0.0");
   def_map["PRINT_INTERVAL"] = std::make_unique<DoubleOpt>("0.1");
   def_map["PRINT_CONTINUE"] = std::make_unique<BoolOpt>("FALSE");
@@ -50,6 +107,69 @@ std::map<std::string, std::unique_ptr<BaseOpt>> Options::create_default_map() {
   def_map["OUTPUT_COUNTER"] = std::make_unique<IntOpt>("0");
   def_map["INPUT_TYPE"] = std::make_unique<StringOpt>("DEFAULT");
   def_map["OUTPUT_TYPE"] = std::make_unique<StringOpt>("VTK");
+  def_map["OUTPUT_FIELDS"] = std::make_unique<StringListOpt>("ALL");
+  def_map["OUTPUT_BOX"] = std::make_unique<StringListOpt>("NONE");
+  def_map["OUTPUT_STRIDE"] = std::make_unique<IntOpt>("1");
+  def_map["OUTPUT_STREAMS"] = std::make_unique<StringListOpt>("NONE");
+  def_map["OUTPUT_STREAM_INTERVALS"] = std::make_unique<StringListOpt>("");
+  def_map["OUTPUT_STREAM_STRIDES"] = std::make_unique<StringListOpt>("");
+  def_map["OUTPUT_STREAM_FIELDS"] = std::make_unique<StringListOpt>("");
+  def_map["OUTPUT_STREAM_BOXES"] = std::make_unique<StringListOpt>("");
+  def_map["OUTPUT_PARTITIONED"] = std::make_unique<BoolOpt>("FALSE");
+  def_map["COMPRESSION_ERROR_BOUND"] = std::make_unique<DoubleOpt>("1e-4");
+  def_map["COMPRESSION_ERROR_TYPE"] = std::make_unique<StringOpt>("REL");
+  def_map["COMPRESSION_FIELD_BOUNDS"] = std::make_unique<StringListOpt>("NONE");
+  def_map["COMPRESSION_LEVEL"] = std::make_unique<IntOpt>("6");
+  def_map["COMPRESSION_VALIDATE"] = std::make_unique<BoolOpt>("FALSE");
+  def_map["HDF5_SNAPSHOTS_PER_FILE"] = std::make_unique<IntOpt>("0");
+  def_map["HDF5_CHUNK_SIZE"] = std::make_unique<IntOpt>("64");
+  def_map["HDF5_COMPRESSION_LEVEL"] = std::make_unique<IntOpt>("4");
+
+  def_map["CHECKPOINT_INTERVAL"] = std::make_unique<IntOpt>("0");
+  def_map["CHECKPOINT_KEEP"] = std::make_unique<IntOpt>("2");
+  def_map["CHECKPOINT_FILE_NAME"] = std::make_unique<StringOpt>("checkpoint");
+  def_map["RESTART"] = std::make_unique<BoolOpt>("FALSE");
+  def_map["RESTART_FILE"] = std::make_unique<StringOpt>("LATEST");
+
+  def_map["TIMING"] = std::make_unique<BoolOpt>("TRUE");
+  def_map["TIMING_JSON"] = std::make_unique<StringOpt>("NONE");
+
+  def_map["STEP_LOG"] = std::make_unique<StringOpt>("NONE");
+  def_map["STEP_LOG_FORMAT"] = std::make_unique<StringOpt>("CSV");
+  def_map["STEP_LOG_INTERVAL"] = std::make_unique<IntOpt>("1");
+  def_map["STEP_LOG_FLUSH_SECONDS"] = std::make_unique<DoubleOpt>("1.0");
+  def_map["PROGRESS_INTERVAL"] = std::make_unique<IntOpt>("100");
+
+  def_map["STEADY_STATE"] = std::make_unique<BoolOpt>("FALSE");
+  def_map["STEADY_RESIDUAL_DROP"] = std::make_unique<DoubleOpt>("6");
+  def_map["STEADY_PLATEAU_STEPS"] = std::make_unique<IntOpt>("0");
+  def_map["STEADY_PLATEAU_TOLERANCE"] = std::make_unique<DoubleOpt>("0.01");
+  def_map["LOCAL_TIME_STEPPING"] = std::make_unique<BoolOpt>("FALSE");
+  def_map["RESIDUAL_SMOOTHING"] = std::make_unique<BoolOpt>("FALSE");
+  def_map["RESIDUAL_SMOOTHING_CFL"] = std::make_unique<DoubleOpt>("0.9");
+
+  def_map["IMEX_NEWTON_ITERATIONS"] = std::make_unique<IntOpt>("2");
+  def_map["IMEX_KRYLOV_ITERATIONS"] = std::make_unique<IntOpt>("20");
+  def_map["IMEX_KRYLOV_TOLERANCE"] = std::make_unique<DoubleOpt>("1e-3");
+
+  def_map["JFNK_MAX_ITERATIONS"] = std::make_unique<IntOpt>("200");
+  def_map["JFNK_MAX_CFL"] = std::make_unique<DoubleOpt>("20");
+  def_map["JFNK_KRYLOV_ITERATIONS"] = std::make_unique<IntOpt>("30");
+  def_map["JFNK_KRYLOV_TOLERANCE"] = std::make_unique<DoubleOpt>("1e-2");
+
+  def_map["ADAPTIVE_RTOL"] = std::make_unique<DoubleOpt>("1e-4");
+  def_map["ADAPTIVE_ATOL"] = std::make_unique<DoubleOpt>("1e-6");
+  def_map["ADAPTIVE_MAX_REJECTIONS"] = std::make_unique<IntOpt>("20");
+
+  def_map["BENCHMARK"] = std::make_unique<BoolOpt>("FALSE");
+  def_map["BENCHMARK_CASES"] =
+      std::make_unique<StringListOpt>("SHOCK_TUBE CYLINDER CHANNEL");
+  def_map["BENCHMARK_SOLVERS"] = std::make_unique<StringListOpt>(
+      "SIMPLE GHIAS KARAGIOZIS SHOCK GHIAS_SHOCK");
+  def_map["BENCHMARK_SIZES"] = std::make_unique<StringListOpt>("64 128 256");
+  def_map["BENCHMARK_THREADS"] = std::make_unique<StringListOpt>("ALL");
+  def_map["BENCHMARK_STEPS"] = std::make_unique<IntOpt>("20");
+  def_map["BENCHMARK_REPORT"] = std::make_unique<StringOpt>("NONE");
 
   def_map["FLUX"] = std::make_unique<StringOpt>("SIMPLE");
   def_map["CONVECTION"] = std::make_unique<StringOpt>("SIMPLE");
@@ -61,6 +181,21 @@ std::map<std::string, std::unique_ptr<BaseOpt>> Options::create_default_map() {
   def_map["DERIVATIVE_ORDER"] = std::make_unique<IntOpt>("2");
 
   def_map["OMP_THREADS"] = std::make_unique<IntOpt>("0");
+  def_map["THREAD_AFFINITY"] = std::make_unique<StringOpt>("NONE");
+  def_map["FIRST_TOUCH"] = std::make_unique<BoolOpt>("TRUE");
+  def_map["HUGE_PAGES"] = std::make_unique<BoolOpt>("FALSE");
+
+  def_map["TILE_ROWS"] = std::make_unique<IntOpt>("0");
+  def_map["TILE_COLS"] = std::make_unique<IntOpt>("0");
+  def_map["TILE_AUTOTUNE"] = std::make_unique<BoolOpt>("FALSE");
+
+  def_map["STORAGE_ROUNDING"] = std::make_unique<StringOpt>("NONE");
+  def_map["PRECISION_CHECK"] = std::make_unique<BoolOpt>("FALSE");
+
+  def_map["ENSEMBLE"] = std::make_unique<BoolOpt>("FALSE");
+  def_map["ENSEMBLE_MACH"] = std::make_unique<StringListOpt>("NONE");
+  def_map["ENSEMBLE_REYNOLDS"] = std::make_unique<StringListOpt>("NONE");
+  def_map["ENSEMBLE_CONCURRENCY"] = std::make_unique<IntOpt>("0");
 
   def_map["LUISA_DETECTOR"] = std::make_unique<StringOpt>("TYPE_23");
   def_map["DETECTOR_SENSITIVITY"] = std::make_unique<DoubleOpt>("1.0");
@@ -87,6 +222,15 @@ std::string Options::getStringOpt(const std::string &key) {
   return dynamic_cast<StringOpt *>(opt_map[key].get())->value();
 }
 
+std::vector<std::string> Options::getStringListOpt(const std::string &key) {
+  return dynamic_cast<StringListOpt *>(opt_map[key].get())->value();
+}
+
+std::vector<std::vector<std::string>>
+Options::getStringListGroups(const std::string &key) {
+  return dynamic_cast<StringListOpt *>(opt_map[key].get())->groups();
+}
+
 bool Options::parse_file(std::istream &is) {
   std::string base_path = get_input_base_path(is);
   if (base_path.length() != 0u) {
@@ -122,7 +266,7 @@ bool Options::safe_set_option(std::string &opt_name,
                               std::vector<std::string> &opt_values,
                               std::string &error_string) {
   try {
-    opt_map[opt_name]->set(opt_values[0]);
+    opt_map[opt_name]->set_list(opt_values);
     return true;
   } catch (...) {
     std::string error_msg;
@@ -7,6 +7,10 @@
 #include <string>
 #include <vector>
 
+struct GridComponentsContainer;
+struct GridConstantsContainer;
+struct GridTopology;
+
 class Options {
 public:
     Options();
@@ -14,12 +18,39 @@ public:
 
     void print_all();
 
+    /**
+     * @brief Sets one option as a configuration line "name = value" would
+     */
+    void set(const std::string& name, const std::string& value);
+
+    /**
+     * @brief Makes the grids take their mesh, flags, initial values and
+     * boundary points from memory instead of the case files (sets
+     * INPUT_TYPE = MEMORY). The grids built from these options share
+     * memory_topology() instead of copying the flags and boundary points
+     */
+    void set_memory_input(
+        GridConstantsContainer constants, GridComponentsContainer components);
+    /**
+     * @brief Takes the memory input of other without copying it, so the
+     * grids of both options share one topology
+     */
+    void share_memory_input(const Options& other);
+    bool has_memory_input() const { return memory_constants_c != nullptr; }
+    const GridConstantsContainer& memory_constants() const;
+    const GridComponentsContainer& memory_components() const;
+    const std::shared_ptr<const GridTopology>& memory_topology() const
+    {
+        return memory_topology_c;
+    }
+
     double gam(void) { return getDoubleOpt("GAMMA"); }
     double reynolds(void) { return getDoubleOpt("REYNOLDS"); }
     double prandtl(void) { return getDoubleOpt("PRANDTL"); }
     double mach(void) { return getDoubleOpt("MACH"); }
     double cfl(void) { return getDoubleOpt("CFL"); }
     double mix_param(void) { return getDoubleOpt("MIX_PARAM"); }
+    int max_steps(void) { return getIntOpt("MAX_STEPS"); }
     double t_init(void) { return getDoubleOpt("T_INIT"); }
     double t_max(void) { return getDoubleOpt("T_MAX"); }
     double print_interval(void) { return getDoubleOpt("PRINT_INTERVAL"); }
@@ -75,6 +106,161 @@ public:
     std::string input_type(void) { return getStringOpt("INPUT_TYPE"); }
     std::string output_type(void) { return getStringOpt("OUTPUT_TYPE"); }
 
+    std::vector<std::string> output_fields(void)
+    {
+        return getStringListOpt("OUTPUT_FIELDS");
+    }
+    std::vector<std::string> output_box(void)
+    {
+        return getStringListOpt("OUTPUT_BOX");
+    }
+    int output_stride(void) { return getIntOpt("OUTPUT_STRIDE"); }
+
+    std::vector<std::string> output_streams(void)
+    {
+        return getStringListOpt("OUTPUT_STREAMS");
+    }
+    std::vector<std::string> output_stream_intervals(void)
+    {
+        return getStringListOpt("OUTPUT_STREAM_INTERVALS");
+    }
+    std::vector<std::string> output_stream_strides(void)
+    {
+        return getStringListOpt("OUTPUT_STREAM_STRIDES");
+    }
+    std::vector<std::vector<std::string>> output_stream_fields(void)
+    {
+        return getStringListGroups("OUTPUT_STREAM_FIELDS");
+    }
+    std::vector<std::vector<std::string>> output_stream_boxes(void)
+    {
+        return getStringListGroups("OUTPUT_STREAM_BOXES");
+    }
+    bool output_partitioned(void) { return getBoolOpt("OUTPUT_PARTITIONED"); }
+
+    double compression_error_bound(void)
+    {
+        return getDoubleOpt("COMPRESSION_ERROR_BOUND");
+    }
+    std::string compression_error_type(void)
+    {
+        return getStringOpt("COMPRESSION_ERROR_TYPE");
+    }
+    std::vector<std::vector<std::string>> compression_field_bounds(void)
+    {
+        return getStringListGroups("COMPRESSION_FIELD_BOUNDS");
+    }
+    int compression_level(void) { return getIntOpt("COMPRESSION_LEVEL"); }
+    bool compression_validate(void)
+    {
+        return getBoolOpt("COMPRESSION_VALIDATE");
+    }
+
+    int hdf5_snapshots_per_file(void)
+    {
+        return getIntOpt("HDF5_SNAPSHOTS_PER_FILE");
+    }
+    int hdf5_chunk_size(void) { return getIntOpt("HDF5_CHUNK_SIZE"); }
+    int hdf5_compression_level(void)
+    {
+        return getIntOpt("HDF5_COMPRESSION_LEVEL");
+    }
+
+    int checkpoint_interval(void) { return getIntOpt("CHECKPOINT_INTERVAL"); }
+    int checkpoint_keep(void) { return getIntOpt("CHECKPOINT_KEEP"); }
+    std::string checkpoint_file_name(void)
+    {
+        return getStringOpt("CHECKPOINT_FILE_NAME");
+    }
+    bool restart(void) { return getBoolOpt("RESTART"); }
+    std::string restart_file(void) { return getStringOpt("RESTART_FILE"); }
+
+    bool timing(void) { return getBoolOpt("TIMING"); }
+    std::string timing_json(void) { return getStringOpt("TIMING_JSON"); }
+
+    std::string step_log(void) { return getStringOpt("STEP_LOG"); }
+    std::string step_log_format(void)
+    {
+        return getStringOpt("STEP_LOG_FORMAT");
+    }
+    int step_log_interval(void) { return getIntOpt("STEP_LOG_INTERVAL"); }
+    double step_log_flush_seconds(void)
+    {
+        return getDoubleOpt("STEP_LOG_FLUSH_SECONDS");
+    }
+    int progress_interval(void) { return getIntOpt("PROGRESS_INTERVAL"); }
+
+    bool steady_state(void) { return getBoolOpt("STEADY_STATE"); }
+    double steady_residual_drop(void)
+    {
+        return getDoubleOpt("STEADY_RESIDUAL_DROP");
+    }
+    int steady_plateau_steps(void) { return getIntOpt("STEADY_PLATEAU_STEPS"); }
+    double steady_plateau_tolerance(void)
+    {
+        return getDoubleOpt("STEADY_PLATEAU_TOLERANCE");
+    }
+    bool local_time_stepping(void) { return getBoolOpt("LOCAL_TIME_STEPPING"); }
+    bool residual_smoothing(void) { return getBoolOpt("RESIDUAL_SMOOTHING"); }
+    double residual_smoothing_cfl(void)
+    {
+        return getDoubleOpt("RESIDUAL_SMOOTHING_CFL");
+    }
+
+    int imex_newton_iterations(void)
+    {
+        return getIntOpt("IMEX_NEWTON_ITERATIONS");
+    }
+    int imex_krylov_iterations(void)
+    {
+        return getIntOpt("IMEX_KRYLOV_ITERATIONS");
+    }
+    double imex_krylov_tolerance(void)
+    {
+        return getDoubleOpt("IMEX_KRYLOV_TOLERANCE");
+    }
+
+    int jfnk_max_iterations(void) { return getIntOpt("JFNK_MAX_ITERATIONS"); }
+    double jfnk_max_cfl(void) { return getDoubleOpt("JFNK_MAX_CFL"); }
+    int jfnk_krylov_iterations(void)
+    {
+        return getIntOpt("JFNK_KRYLOV_ITERATIONS");
+    }
+    double jfnk_krylov_tolerance(void)
+    {
+        return getDoubleOpt("JFNK_KRYLOV_TOLERANCE");
+    }
+
+    double adaptive_rtol(void) { return getDoubleOpt("ADAPTIVE_RTOL"); }
+    double adaptive_atol(void) { return getDoubleOpt("ADAPTIVE_ATOL"); }
+    int adaptive_max_rejections(void)
+    {
+        return getIntOpt("ADAPTIVE_MAX_REJECTIONS");
+    }
+
+    bool benchmark(void) { return getBoolOpt("BENCHMARK"); }
+    std::vector<std::string> benchmark_cases(void)
+    {
+        return getStringListOpt("BENCHMARK_CASES");
+    }
+    std::vector<std::string> benchmark_solvers(void)
+    {
+        return getStringListOpt("BENCHMARK_SOLVERS");
+    }
+    std::vector<std::string> benchmark_sizes(void)
+    {
+        return getStringListOpt("BENCHMARK_SIZES");
+    }
+    std::vector<std::string> benchmark_threads(void)
+    {
+        return getStringListOpt("BENCHMARK_THREADS");
+    }
+    int benchmark_steps(void) { return getIntOpt("BENCHMARK_STEPS"); }
+    std::string benchmark_report(void)
+    {
+        return getStringOpt("BENCHMARK_REPORT");
+    }
+
     std::string flux(void) { return getStringOpt("FLUX"); }
     std::string convection(void) { return getStringOpt("CONVECTION"); }
     std::string mix_convection_main(void)
@@ -90,6 +276,33 @@ public:
     int derivative_order(void) { return getIntOpt("DERIVATIVE_ORDER"); }
 
     int omp_threads(void) { return getIntOpt("OMP_THREADS"); }
+    std::string thread_affinity(void)
+    {
+        return getStringOpt("THREAD_AFFINITY");
+    }
+    bool first_touch(void) { return getBoolOpt("FIRST_TOUCH"); }
+    bool huge_pages(void) { return getBoolOpt("HUGE_PAGES"); }
+
+    int tile_rows(void) { return getIntOpt("TILE_ROWS"); }
+    int tile_cols(void) { return getIntOpt("TILE_COLS"); }
+    bool tile_autotune(void) { return getBoolOpt("TILE_AUTOTUNE"); }
+
+    std::string storage_rounding(void)
+    {
+        return getStringOpt("STORAGE_ROUNDING");
+    }
+    bool precision_check(void) { return getBoolOpt("PRECISION_CHECK"); }
+
+    bool ensemble(void) { return getBoolOpt("ENSEMBLE"); }
+    std::vector<std::string> ensemble_mach(void)
+    {
+        return getStringListOpt("ENSEMBLE_MACH");
+    }
+    std::vector<std::string> ensemble_reynolds(void)
+    {
+        return getStringListOpt("ENSEMBLE_REYNOLDS");
+    }
+    int ensemble_concurrency(void) { return getIntOpt("ENSEMBLE_CONCURRENCY"); }
 
     std::string luisa_detector() { return getStringOpt("LUISA_DETECTOR"); }
 
@@ -103,11 +316,17 @@ public:
 
 private:
     std::map<std::string, std::unique_ptr<BaseOpt>> opt_map;
+    std::shared_ptr<const GridConstantsContainer> memory_constants_c;
+    std::shared_ptr<const GridComponentsContainer> memory_components_c;
+    std::shared_ptr<const GridTopology> memory_topology_c;
 
     double getDoubleOpt(const std::string& key);
     bool getBoolOpt(const std::string& key);
     std::string getStringOpt(const std::string& key);
     int getIntOpt(const std::string& key);
+    std::vector<std::string> getStringListOpt(const std::string& key);
+    std::vector<std::vector<std::string>> getStringListGroups(
+        const std::string& key);
 
     std::map<std::string, std::unique_ptr<BaseOpt>> create_default_map(void);
     std::string get_input_base_path(std::istream& is);
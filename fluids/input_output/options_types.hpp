@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <sstream>
 #include <string>
+#include <vector>
 
 struct IntOpt : public BaseOpt {
 
@@ -69,4 +70,54 @@ private:
     std::string val;
 };
 
+/**
+ * @brief Option holding every token given after the "=" sign
+ *
+ * A ";" token splits the list into groups, so "rho u; ALL" holds the groups
+ * {"rho", "u"} and {"ALL"}.
+ */
+struct StringListOpt : public BaseOpt {
+
+    StringListOpt(const std::string& in)
+        : val(parse(in)){};
+
+    void set(const std::string& in) final { val = parse(in); };
+    void set_list(const std::vector<std::string>& in) final { val = in; };
+    std::vector<std::string> value(void) const { return val; }
+    std::vector<std::vector<std::string>> groups(void) const
+    {
+        std::vector<std::vector<std::string>> ret(1);
+        for (auto& token : val) {
+            if (token == ";") {
+                ret.emplace_back();
+            }
+            else {
+                ret.back().push_back(token);
+            }
+        }
+        return ret;
+    }
+    std::string print() const
+    {
+        std::string ret;
+        for (auto& token : val) {
+            ret += (ret.empty() ? "" : " ") + token;
+        }
+        return ret;
+    }
+
+private:
+    std::vector<std::string> val;
+    std::vector<std::string> parse(const std::string& in)
+    {
+        std::vector<std::string> ret;
+        std::istringstream stream(in);
+        std::string token;
+        while (stream >> token) {
+            ret.push_back(token);
+        }
+        return ret;
+    }
+};
+
 #endif /*OPTIONS_TYPES_HPP*/
@@ -1,12 +1,24 @@
 #include "reader.hpp"
+#include "../../utils/parallel/communicator.hpp"
+#include "../stream_from_file.hpp"
 
-Reader::Reader(Options& opt)
+Reader::Reader(Options& opt, bool decompose)
     : local_container(GridConstantsContainer())
 {
     std::string input_type = opt.input_type();
-    if (input_type == "DEFAULT") {
+    bool block = decompose and parallel::size() > 1;
+    if (input_type == "DEFAULT" and block) {
+        read_block(opt, parallel::size(), parallel::rank());
+    }
+    else if (input_type == "DEFAULT") {
         default_reader(opt, local_components, local_container);
     }
+    else if (input_type == "MEMORY") {
+        read_memory_input(opt);
+        if (block) {
+            restrict_to_block(parallel::size(), parallel::rank());
+        }
+    }
     else {
         std::cerr << "Input type '" << input_type << "' is not supported"
                   << std::endl;
@@ -32,3 +44,198 @@ Reader::Reader(Options& opt, std::istream&& initial_conditions,
         throw(-1);
     }
 }
+
+void Reader::read_memory_input(Options& opt)
+{
+    if (!opt.has_memory_input()) {
+        std::cerr << "INPUT_TYPE = MEMORY needs the grid given with "
+                     "Options::set_memory_input"
+                  << std::endl;
+        throw(-1);
+    }
+    local_container = opt.memory_constants();
+    local_components = opt.memory_components();
+    local_topology = opt.memory_topology();
+    auto& c = local_container;
+    size_t n_points = static_cast<size_t>(c.nPointsI) * c.nPointsJ;
+    if (c.nPointsI <= 0 or c.nPointsJ <= 0
+        or static_cast<size_t>(c.nPointsTotal) != n_points
+        or local_components.grid_c.size() != n_points
+        or local_topology->flags.size() != n_points) {
+        std::cerr << "Grid in memory is " << c.nPointsI << "x" << c.nPointsJ
+                  << " with " << c.nPointsTotal << " points, "
+                  << local_components.grid_c.size() << " values and "
+                  << local_topology->flags.size() << " flags" << std::endl;
+        throw(-1);
+    }
+}
+
+namespace {
+void check_block_support(const GridComponentsContainer& components)
+{
+    if (!components.shock_points_c.empty()) {
+        std::cerr << "Shocks are not supported with domain decomposition"
+                  << std::endl;
+        throw(-1);
+    }
+}
+
+/**
+ * @brief Keeps the immersed interface points of global that the block of d
+ * needs, with local indices. A ghost point belongs to the process that owns
+ * it and interpolates from fluid points close enough to be stored there. A
+ * body discontinuity is kept wherever both points it lies between are
+ * stored, which covers every discontinuity the owned points are derived
+ * across
+ */
+void distribute_interface(const GridComponentsContainer& global,
+    const parallel::Decomposition& d, GridComponentsContainer* block)
+{
+    for (auto gp : global.ghias_points_c) {
+        int ind = d.local_ind(gp.ind);
+        if (ind < 0 or !d.is_owned(ind)) {
+            continue;
+        }
+        gp.ind = ind;
+        for (int k = 0; k < 4; k++) {
+            int neighbor = d.local_ind(gp.neighbors_inds[k]); // NOLINT
+            if (gp.is_fluid(k) and neighbor < 0) {
+                std::cerr << "Ghost point " << d.global_ind(ind)
+                          << " interpolates from point "
+                          << gp.neighbors_inds[k] // NOLINT
+                          << ", which is outside the block of process "
+                          << d.rank() << std::endl;
+                throw(-1);
+            }
+            gp.neighbors_inds[k] = neighbor; // NOLINT
+        }
+        block->ghias_points_c.push_back(gp);
+    }
+    for (auto bd : global.karagiozis_points_c) {
+        int next = bd.ind + (bd.is_x() ? 1 : d.global_nPointsJ());
+        int ind = d.local_ind(bd.ind);
+        if (ind < 0 or d.local_ind(next) < 0) {
+            continue;
+        }
+        bd.ind = ind;
+        block->karagiozis_points_c.push_back(bd);
+    }
+}
+} // namespace
+
+void Reader::read_block(Options& opt, int procs, int rank)
+{
+    auto mesh_details = stream_from_file(opt.input_meshfile_name());
+    auto initial_conditions
+        = stream_from_file(opt.input_flow_configuration_file_name());
+    local_container = read_details_constants(mesh_details);
+    if (!sizes_are_equal(
+            std::make_pair(local_container.nPointsI, local_container.nPointsJ),
+            read_size_initial(initial_conditions))) {
+        std::cerr << "Input mesh file: " << opt.input_meshfile_name()
+                  << std::endl
+                  << "Input initial conditions: "
+                  << opt.input_flow_configuration_file_name() << std::endl;
+    }
+    auto d = std::make_shared<parallel::Decomposition>(
+        local_container.nPointsI, local_container.nPointsJ, procs, rank);
+
+    // The files list the points in global index order, and only the block
+    // of this process is kept
+    auto& block = local_components;
+    block.grid_c.resize(d->nPointsTotal());
+    block.flags_c.resize(d->nPointsTotal());
+    int flag;
+    Point point;
+    for (int global_ind = 0; global_ind < local_container.nPointsTotal;
+         global_ind++) {
+        mesh_details >> flag;
+        initial_conditions >> point;
+        int ind = d->local_ind(global_ind);
+        if (ind >= 0) {
+            block.grid_c[ind] = point;
+            block.flags_c[ind] = d->local_flag(flag, ind);
+        }
+    }
+    auto boundary_file
+        = stream_from_file(opt.input_boundary_configuration_file_name());
+    // Each boundary point belongs to the process that owns it
+    int num_points;
+    boundary_file >> num_points;
+    BoundaryPoint bp;
+    for (int k = 0; k < num_points; k++) {
+        boundary_file >> bp;
+        int ind = d->local_ind(bp.ind);
+        if (ind >= 0 and d->is_owned(ind)) {
+            bp.ind = ind;
+            block.boundary_c.push_back(bp);
+        }
+    }
+    // The interface lists far fewer points than the grid, so it is read
+    // whole before each process keeps its own
+    GridComponentsContainer interface;
+    try {
+        auto immersed_interface
+            = stream_from_file(opt.input_immersed_interface_file_name());
+        read_immersed_interface(
+            interface, local_container, immersed_interface);
+    }
+    catch (...) {
+        std::cerr << "Immersed Interface File not found! Assuming empty!!!"
+                  << std::endl;
+    }
+    check_block_support(interface);
+    distribute_interface(interface, *d, &block);
+    keep_block(d);
+}
+
+std::shared_ptr<const GridTopology> Reader::topology()
+{
+    if (local_topology == nullptr) {
+        auto topology = std::make_shared<GridTopology>();
+        topology->flags = memory::to_grid_array(local_components.flags_c);
+        topology->boundary = local_components.boundary_c;
+        local_topology = std::move(topology);
+    }
+    return local_topology;
+}
+
+void Reader::restrict_to_block(int procs, int rank)
+{
+    auto& global = local_components;
+    auto& topology = *local_topology;
+    check_block_support(global);
+    auto d = std::make_shared<parallel::Decomposition>(
+        local_container.nPointsI, local_container.nPointsJ, procs, rank);
+
+    GridComponentsContainer block;
+    block.grid_c.resize(d->nPointsTotal());
+    block.flags_c.resize(d->nPointsTotal());
+    for (int ind = 0; ind < d->nPointsTotal(); ind++) {
+        int global_ind = d->global_ind(ind);
+        block.grid_c[ind] = global.grid_c[global_ind];
+        block.flags_c[ind] = d->local_flag(topology.flags[global_ind], ind);
+    }
+    // Each boundary point belongs to the process that owns it
+    for (auto bp : topology.boundary) {
+        int ind = d->local_ind(bp.ind);
+        if (ind >= 0 and d->is_owned(ind)) {
+            bp.ind = ind;
+            block.boundary_c.push_back(bp);
+        }
+    }
+    distribute_interface(global, *d, &block);
+    local_components = block;
+    local_topology = nullptr;
+    keep_block(d);
+}
+
+void Reader::keep_block(std::shared_ptr<const parallel::Decomposition> d)
+{
+    local_container.xmin += local_container.dx * d->local_j().begin;
+    local_container.ymin += local_container.dy * d->local_i().begin;
+    local_container.nPointsI = d->nPointsI();
+    local_container.nPointsJ = d->nPointsJ();
+    local_container.nPointsTotal = d->nPointsTotal();
+    local_decomposition = d;
+}
@@ -8,27 +8,45 @@
 #include "../../utils/ghias_ghost_point_def.hpp"
 #include "../../utils/grid_components_container_def.hpp"
 #include "../../utils/grid_constants_container_def.hpp"
+#include "../../utils/grid_topology_def.hpp"
+#include "../../utils/parallel/decomposition.hpp"
 #include "../../utils/point_def.hpp"
 #include "../options.hpp"
 
 #include <iostream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
 class Reader {
 public:
-    Reader(Options& opt);
+    /**
+     * @brief Reads the case files, or copies the grid given to
+     * Options::set_memory_input when INPUT_TYPE is MEMORY. When running on
+     * several processes and decompose is true only the block of this process
+     * (with its ghost points and the immersed interface points it needs) is
+     * kept, see decomposition(). Each process then streams through the case
+     * files and stores no more than its block. Shocks are not supported on a
+     * block
+     */
+    Reader(Options& opt, bool decompose = true);
     Reader(Options& opt, std::istream&& initial_conditions,
         std::istream&& mesh_details, std::istream&& boundary_file,
         std::istream&& immersed_interface = std::move(std::istringstream("")),
         std::istream&& shock_file = std::move(std::istringstream("")));
     std::vector<Point> grid(void) { return local_components.grid_c; }
-    std::vector<int> flags(void) { return local_components.flags_c; }
-    std::vector<BoundaryPoint> boundary(void)
+    std::vector<int> flags(void)
     {
-        return local_components.boundary_c;
+        auto& flags = topology()->flags;
+        return std::vector<int>(flags.begin(), flags.end());
     }
+    std::vector<BoundaryPoint> boundary(void) { return topology()->boundary; }
+    /**
+     * @return Flags and boundary points, shared with the other grids built
+     * from the same memory input
+     */
+    std::shared_ptr<const GridTopology> topology();
     std::vector<GhiasGhostPoint> ghias_ghost_points()
     {
         return local_components.ghias_points_c;
@@ -48,10 +66,30 @@ public:
     double dy(void) { return local_container.dy; }
     double xmin(void) { return local_container.xmin; }
     double ymin(void) { return local_container.ymin; }
+    /**
+     * @return Block kept by this process, nullptr if it kept the whole grid
+     */
+    std::shared_ptr<const parallel::Decomposition> decomposition()
+    {
+        return local_decomposition;
+    }
 
 private:
     GridComponentsContainer local_components;
     GridConstantsContainer local_container;
+    /** Topology of the memory input, nullptr if the flags and boundary
+     * points are in local_components */
+    std::shared_ptr<const GridTopology> local_topology;
+    std::shared_ptr<const parallel::Decomposition> local_decomposition;
+
+    void read_memory_input(Options& opt);
+    void read_block(Options& opt, int procs, int rank);
+    void restrict_to_block(int procs, int rank);
+    /**
+     * @brief Sets the sizes and origin of the block of d, whose points are in
+     * local_components
+     */
+    void keep_block(std::shared_ptr<const parallel::Decomposition> d);
 };
 
 #endif /* READER_HPP */
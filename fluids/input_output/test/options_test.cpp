@@ -41,3 +41,27 @@ TEST_F(OptionsTest, testFileParsing)
     ASSERT_EQ(opts_parse->input_flow_configuration_file_name(),
         "./input/initialCondition.dat");
 }
+
+TEST(OptionsListTest, testListOptions)
+{
+    std::istringstream stream("OUTPUT_FIELDS = rho, u, v\n"
+                              "OUTPUT_STREAM_BOXES = NONE; 0 1 0 1\n");
+    Options opt(stream);
+    ASSERT_EQ(opt.output_fields(), std::vector<std::string>({"rho", "u", "v"}));
+    auto boxes = opt.output_stream_boxes();
+    ASSERT_EQ(boxes.size(), 2u);
+    ASSERT_EQ(boxes[0], std::vector<std::string>({"NONE"}));
+    ASSERT_EQ(boxes[1], std::vector<std::string>({"0", "1", "0", "1"}));
+    ASSERT_EQ(opt.output_box(), std::vector<std::string>({"NONE"}));
+}
+
+TEST(OptionsSetTest, testSet)
+{
+    Options opt;
+    opt.set("MACH", "0.5");
+    opt.set("OUTPUT_FIELDS", "rho, u");
+    ASSERT_EQ(opt.mach(), 0.5);
+    ASSERT_EQ(opt.output_fields(), std::vector<std::string>({"rho", "u"}));
+    ASSERT_THROW(opt.set("NOT_AN_OPTION", "1"), int);
+    ASSERT_THROW(opt.set("MACH", "fast"), int);
+}
@@ -0,0 +1,477 @@
+#include "compressed_writer.hpp"
+#include "../../grid/cartesian_grid.hpp"
+#include "nan_checker.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef WITH_ZLIB
+#include <zlib.h>
+#endif
+
+namespace {
+
+const char magic[4] = {'T', 'F', 'Z', '1'};
+const uint8_t mode_lossless = 0;
+const uint8_t mode_lossy = 1;
+// Quantization codes larger than this are stored verbatim instead
+const double max_code = 1073741824.0;
+
+typedef std::vector<unsigned char> Bytes;
+
+template <typename T>
+void put(Bytes& out, const T& value)
+{
+    const auto* ptr = reinterpret_cast<const unsigned char*>(&value);
+    out.insert(out.end(), ptr, ptr + sizeof(T));
+}
+
+template <typename T>
+T get(const Bytes& in, size_t& pos)
+{
+    T value;
+    if (pos + sizeof(T) > in.size()) {
+        std::cerr << "Compressed snapshot is truncated" << std::endl;
+        throw(-1);
+    }
+    std::memcpy(&value, in.data() + pos, sizeof(T));
+    pos += sizeof(T);
+    return value;
+}
+
+void put_varint(Bytes& out, uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+uint64_t get_varint(const Bytes& in, size_t& pos)
+{
+    uint64_t value = 0;
+    for (int shift = 0; pos < in.size() && shift < 64; shift += 7) {
+        unsigned char byte = in[pos++];
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    std::cerr << "Compressed snapshot is corrupted" << std::endl;
+    throw(-1);
+}
+
+inline uint64_t zigzag(int64_t v)
+{
+    return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t unzigzag(uint64_t v)
+{
+    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+/**
+ * @brief 2D Lorenzo prediction from the reconstructed left, lower and
+ * lower-left neighbours
+ */
+inline double predict(const std::vector<double>& rec, int i, int j, int nJ)
+{
+    int k = i * nJ + j;
+    double left = (j > 0) ? rec[k - 1] : 0.0;
+    double down = (i > 0) ? rec[k - nJ] : 0.0;
+    double diag = (i > 0 && j > 0) ? rec[k - nJ - 1] : 0.0;
+    return left + down - diag;
+}
+
+inline double reconstruct(double pred, double step, int64_t code)
+{
+    return pred + step * static_cast<double>(code);
+}
+
+Bytes encode_lossy(const std::vector<double>& v, int nI, int nJ, double eb)
+{
+    Bytes out;
+    out.reserve(v.size());
+    std::vector<double> rec(v.size());
+    const double step = 2 * eb;
+    for (int i = 0; i < nI; i++) {
+        for (int j = 0; j < nJ; j++) {
+            int k = i * nJ + j;
+            double pred = predict(rec, i, j, nJ);
+            double diff = (v[k] - pred) / step;
+            if (std::fabs(diff) < max_code) {
+                auto code = static_cast<int64_t>(std::llround(diff));
+                double value = reconstruct(pred, step, code);
+                if (std::fabs(value - v[k]) <= eb) {
+                    put_varint(out, zigzag(code) + 1);
+                    rec[k] = value;
+                    continue;
+                }
+            }
+            // Unpredictable point, kept as is
+            put_varint(out, 0);
+            put(out, v[k]);
+            rec[k] = v[k];
+        }
+    }
+    return out;
+}
+
+std::vector<double> decode_lossy(const Bytes& in, int nI, int nJ, double eb)
+{
+    std::vector<double> rec(static_cast<size_t>(nI) * nJ);
+    const double step = 2 * eb;
+    size_t pos = 0;
+    for (int i = 0; i < nI; i++) {
+        for (int j = 0; j < nJ; j++) {
+            int k = i * nJ + j;
+            uint64_t symbol = get_varint(in, pos);
+            if (symbol == 0) {
+                rec[k] = get<double>(in, pos);
+            }
+            else {
+                rec[k] = reconstruct(
+                    predict(rec, i, j, nJ), step, unzigzag(symbol - 1));
+            }
+        }
+    }
+    return rec;
+}
+
+/**
+ * @brief Groups the k-th byte of every value together, which makes the
+ * slowly varying exponent bytes much easier to deflate
+ */
+Bytes encode_lossless(const std::vector<double>& v)
+{
+    const size_t n = v.size();
+    Bytes out(n * sizeof(double));
+    const auto* raw = reinterpret_cast<const unsigned char*>(v.data());
+    for (size_t b = 0; b < sizeof(double); b++) {
+        for (size_t k = 0; k < n; k++) {
+            out[b * n + k] = raw[k * sizeof(double) + b];
+        }
+    }
+    return out;
+}
+
+std::vector<double> decode_lossless(const Bytes& in, size_t n)
+{
+    if (in.size() != n * sizeof(double)) {
+        std::cerr << "Compressed snapshot is corrupted" << std::endl;
+        throw(-1);
+    }
+    std::vector<double> v(n);
+    auto* raw = reinterpret_cast<unsigned char*>(v.data());
+    for (size_t b = 0; b < sizeof(double); b++) {
+        for (size_t k = 0; k < n; k++) {
+            raw[k * sizeof(double) + b] = in[b * n + k];
+        }
+    }
+    return v;
+}
+
+#ifdef WITH_ZLIB
+Bytes deflate_bytes(const Bytes& in, int level)
+{
+    uLongf size = compressBound(in.size());
+    Bytes out(size);
+    if (compress2(out.data(), &size, in.data(), in.size(), level) != Z_OK) {
+        std::cerr << "zlib failed to compress snapshot" << std::endl;
+        throw(-1);
+    }
+    out.resize(size);
+    return out;
+}
+
+Bytes inflate_bytes(const Bytes& in, size_t raw_size)
+{
+    Bytes out(raw_size);
+    uLongf size = raw_size;
+    if (uncompress(out.data(), &size, in.data(), in.size()) != Z_OK
+        || size != raw_size) {
+        std::cerr << "zlib failed to decompress snapshot" << std::endl;
+        throw(-1);
+    }
+    return out;
+}
+#else
+Bytes deflate_bytes(const Bytes& in, int) { return in; }
+Bytes inflate_bytes(const Bytes& in, size_t) { return in; }
+#endif
+
+double field_range(const std::vector<double>& v)
+{
+    if (v.empty()) {
+        return 0.0;
+    }
+    auto minmax = std::minmax_element(v.begin(), v.end());
+    return *minmax.second - *minmax.first;
+}
+
+} // namespace
+
+const std::vector<double>& CompressedSnapshot::field(
+    const std::string& name) const
+{
+    for (size_t f = 0; f < names.size(); f++) {
+        if (names[f] == name) {
+            return data[f];
+        }
+    }
+    std::cerr << "Field '" << name << "' is not in the snapshot" << std::endl;
+    throw(-1);
+}
+
+CompressedWriter::CompressedWriter(const PointFunctions& pf_in,
+    const OutputSelection& selection_in, const FieldBound& default_bound_in,
+    const std::map<std::string, FieldBound>& field_bounds_in,
+    int compression_level_in, bool validate_writes_in)
+    : pf(pf_in)
+    , selection(selection_in)
+    , default_bound(default_bound_in)
+    , compression_level(compression_level_in)
+    , validate_writes(validate_writes_in)
+{
+    for (auto& entry : field_bounds_in) {
+        OutputSelection single({entry.first}, {"NONE"}, 1);
+        field_bounds.push_back(
+            std::make_pair(single.fields()[0].property, entry.second));
+    }
+#ifndef WITH_ZLIB
+    std::cerr << "templateFluids was built without zlib: compressed snapshots "
+                 "are quantized but not deflated"
+              << std::endl;
+#endif
+}
+
+std::vector<double> CompressedWriter::extract(
+    const CartesianGrid& grid, const OutputField& field) const
+{
+    auto range = selection.range(grid);
+    std::vector<double> v;
+    v.reserve(range.nTotal());
+    for (int i = range.i_begin; i < range.i_end; i += range.stride) {
+        for (int j = range.j_begin; j < range.j_end; j += range.stride) {
+            auto& p = grid.values(grid.IND(i, j));
+            v.push_back(default_if_nan((pf.*field.property)(p)));
+        }
+    }
+    return v;
+}
+
+FieldBound CompressedWriter::bound_for(const OutputField& field) const
+{
+    for (auto& entry : field_bounds) {
+        if (entry.first == field.property) {
+            return entry.second;
+        }
+    }
+    return default_bound;
+}
+
+void CompressedWriter::write(
+    CartesianGrid& grid, const std::string& file_name, const double& t) const
+{
+    auto range = selection.range(grid);
+    auto& fields = selection.fields();
+    std::vector<Bytes> payload(fields.size());
+    std::vector<uint64_t> raw_size(fields.size());
+    std::vector<uint8_t> mode(fields.size());
+    std::vector<double> eb(fields.size());
+    // An exception may not leave the parallel region, so failures are
+    // reported once it is over
+    std::vector<char> failed(fields.size(), 0);
+
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (size_t f = 0; f < fields.size(); f++) {
+        try {
+            auto v = extract(grid, fields[f]);
+            auto bound = bound_for(fields[f]);
+            eb[f] = bound.relative ? bound.value * field_range(v)
+                                   : bound.value;
+            Bytes raw;
+            if (eb[f] > 0.0) {
+                mode[f] = mode_lossy;
+                raw = encode_lossy(v, range.nI(), range.nJ(), eb[f]);
+            }
+            else {
+                mode[f] = mode_lossless;
+                eb[f] = 0.0;
+                raw = encode_lossless(v);
+            }
+            raw_size[f] = raw.size();
+            payload[f] = deflate_bytes(raw, compression_level);
+        }
+        catch (...) {
+            failed[f] = 1;
+        }
+    }
+    bool any_failed = false;
+    for (size_t f = 0; f < fields.size(); f++) {
+        if (failed[f]) {
+            std::cerr << "Could not compress field " << fields[f].name
+                      << " of " << file_name << std::endl;
+            any_failed = true;
+        }
+    }
+    if (any_failed) {
+        throw(-1);
+    }
+
+    Bytes header;
+    header.insert(header.end(), magic, magic + 4);
+    put<int32_t>(header, range.nI());
+    put<int32_t>(header, range.nJ());
+    put<double>(header, grid.xmin + grid.dx * range.j_begin);
+    put<double>(header, grid.ymin + grid.dy * range.i_begin);
+    put<double>(header, grid.dx * range.stride);
+    put<double>(header, grid.dy * range.stride);
+    put<double>(header, t);
+    put<int32_t>(header, static_cast<int32_t>(fields.size()));
+
+    std::ofstream output(file_name, std::ios::binary);
+    if (!output.is_open()) {
+        std::cerr << "Could not open file " << file_name << std::endl;
+        return;
+    }
+    output.write(reinterpret_cast<const char*>(header.data()), header.size());
+    for (size_t f = 0; f < fields.size(); f++) {
+        Bytes field_header;
+        std::string name(fields[f].name);
+        put<int32_t>(field_header, static_cast<int32_t>(name.size()));
+        field_header.insert(field_header.end(), name.begin(), name.end());
+        put<uint8_t>(field_header, mode[f]);
+        put<double>(field_header, eb[f]);
+        put<uint64_t>(field_header, raw_size[f]);
+        put<uint64_t>(field_header, payload[f].size());
+        output.write(reinterpret_cast<const char*>(field_header.data()),
+            field_header.size());
+        output.write(reinterpret_cast<const char*>(payload[f].data()),
+            payload[f].size());
+    }
+    output.close();
+
+    if (output.fail()) {
+        std::cout << "Failed while writing to file " << file_name << std::endl;
+        return;
+    }
+
+    if (validate_writes) {
+        for (auto& error : validate(grid, file_name)) {
+            std::cout << "Field " << error.name
+                      << ": max error = " << error.max_error
+                      << " (bound = " << error.bound << ")"
+                      << ((error.max_error > error.bound) ? " VIOLATED" : "")
+                      << std::endl;
+        }
+    }
+}
+
+std::vector<FieldError> CompressedWriter::validate(
+    const CartesianGrid& grid, const std::string& file_name) const
+{
+    auto snapshot = read_compressed_snapshot(file_name);
+    std::vector<FieldError> ret;
+    for (auto& field : selection.fields()) {
+        auto v = extract(grid, field);
+        auto& decoded = snapshot.field(field.name);
+        auto bound = bound_for(field);
+        FieldError error = {field.name,
+            bound.relative ? bound.value * field_range(v) : bound.value, 0.0};
+        for (size_t k = 0; k < v.size() && k < decoded.size(); k++) {
+            error.max_error
+                = std::max(error.max_error, std::fabs(v[k] - decoded[k]));
+        }
+        ret.push_back(error);
+    }
+    return ret;
+}
+
+CompressedSnapshot read_compressed_snapshot(const std::string& file_name)
+{
+    std::ifstream input(file_name, std::ios::binary);
+    if (!input.is_open()) {
+        std::cerr << "Could not open file " << file_name << std::endl;
+        throw(-1);
+    }
+    Bytes in((std::istreambuf_iterator<char>(input)),
+        std::istreambuf_iterator<char>());
+
+    if (in.size() < 4 || !std::equal(magic, magic + 4, in.begin())) {
+        std::cerr << file_name << " is not a compressed snapshot" << std::endl;
+        throw(-1);
+    }
+    size_t pos = 4;
+    CompressedSnapshot snapshot;
+    snapshot.nI = get<int32_t>(in, pos);
+    snapshot.nJ = get<int32_t>(in, pos);
+    snapshot.x0 = get<double>(in, pos);
+    snapshot.y0 = get<double>(in, pos);
+    snapshot.dx = get<double>(in, pos);
+    snapshot.dy = get<double>(in, pos);
+    snapshot.t = get<double>(in, pos);
+    int n_fields = get<int32_t>(in, pos);
+    const size_t n_points = static_cast<size_t>(snapshot.nI) * snapshot.nJ;
+
+    for (int f = 0; f < n_fields; f++) {
+        auto name_size = get<int32_t>(in, pos);
+        if (name_size < 0 || pos + name_size > in.size()) {
+            std::cerr << "Compressed snapshot is corrupted" << std::endl;
+            throw(-1);
+        }
+        snapshot.names.emplace_back(
+            in.begin() + pos, in.begin() + pos + name_size);
+        pos += name_size;
+        auto mode = get<uint8_t>(in, pos);
+        auto eb = get<double>(in, pos);
+        auto raw_size = get<uint64_t>(in, pos);
+        auto payload_size = get<uint64_t>(in, pos);
+        if (pos + payload_size > in.size()) {
+            std::cerr << "Compressed snapshot is truncated" << std::endl;
+            throw(-1);
+        }
+        Bytes payload(in.begin() + pos, in.begin() + pos + payload_size);
+        pos += payload_size;
+
+        auto raw = inflate_bytes(payload, raw_size);
+        if (mode == mode_lossy) {
+            snapshot.data.push_back(
+                decode_lossy(raw, snapshot.nI, snapshot.nJ, eb));
+        }
+        else {
+            snapshot.data.push_back(decode_lossless(raw, n_points));
+        }
+    }
+    return snapshot;
+}
+
+std::map<std::string, FieldBound> parse_field_bounds(
+    const std::vector<std::vector<std::string>>& groups,
+    bool relative_by_default)
+{
+    std::map<std::string, FieldBound> ret;
+    for (auto& group : groups) {
+        if (group.empty() || group[0] == "NONE") {
+            continue;
+        }
+        if (group.size() < 2 || group.size() > 3
+            || (group.size() == 3 && group[2] != "ABS" && group[2] != "REL")) {
+            std::cerr << "Field bounds must be given as 'field value [ABS|REL]'"
+                      << std::endl;
+            throw(-1);
+        }
+        bool relative
+            = (group.size() == 3) ? group[2] == "REL" : relative_by_default;
+        ret[group[0]] = {std::stod(group[1]), relative};
+    }
+    return ret;
+}
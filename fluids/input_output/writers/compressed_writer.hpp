@@ -0,0 +1,98 @@
+#ifndef COMPRESSED_WRITER_HPP
+#define COMPRESSED_WRITER_HPP
+
+#include "../../utils/point_functions.hpp"
+#include "output_selection.hpp"
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+class CartesianGrid;
+
+/**
+ * @brief Error bound of a field. Relative bounds are scaled by the range
+ * (max - min) of the field in the snapshot. A zero bound means lossless.
+ */
+struct FieldBound {
+    double value;
+    bool relative;
+};
+
+/**
+ * @brief Maximum pointwise error of a field after a write/read round trip
+ */
+struct FieldError {
+    std::string name;
+    double bound;     ///< Absolute bound used for the field
+    double max_error; ///< Largest |original - decoded|
+};
+
+/**
+ * @brief Decoded content of a compressed snapshot
+ *
+ * Fields are stored line by line (nI lines of nJ values); point (i, j) is at
+ * x = x0 + j*dx, y = y0 + i*dy.
+ */
+struct CompressedSnapshot {
+    int nI, nJ;
+    double x0, y0, dx, dy;
+    double t;
+    std::vector<std::string> names;
+    std::vector<std::vector<double>> data;
+
+    const std::vector<double>& field(const std::string& name) const;
+};
+
+/**
+ * \class CompressedWriter
+ * @brief Writes snapshots in an error-bounded compressed binary format (.tfz)
+ *
+ * Lossy fields are quantized on a 2*bound grid around a 2D Lorenzo
+ * prediction made from already reconstructed neighbours, so every point is
+ * within the bound once decoded. Quantization codes are stored as zigzag
+ * varints and points that cannot be predicted within the bound are kept
+ * verbatim. Lossless fields (bound 0) are byte-shuffled. Every field is then
+ * deflated with zlib.
+ */
+class CompressedWriter {
+public:
+    CompressedWriter(const PointFunctions& pf, const OutputSelection& selection,
+        const FieldBound& default_bound,
+        const std::map<std::string, FieldBound>& field_bounds,
+        int compression_level, bool validate_writes);
+
+    void write(CartesianGrid& grid, const std::string& file_name,
+        const double& t) const;
+
+    /**
+     * @brief Reads file_name back and compares it to the grid in memory
+     */
+    std::vector<FieldError> validate(
+        const CartesianGrid& grid, const std::string& file_name) const;
+
+private:
+    PointFunctions pf;
+    OutputSelection selection;
+    FieldBound default_bound;
+    std::vector<std::pair<alias::PointProperty, FieldBound>> field_bounds;
+    int compression_level;
+    bool validate_writes;
+
+    std::vector<double> extract(
+        const CartesianGrid& grid, const OutputField& field) const;
+    FieldBound bound_for(const OutputField& field) const;
+};
+
+CompressedSnapshot read_compressed_snapshot(const std::string& file_name);
+
+/**
+ * @brief Parses bounds given as groups of "field value [ABS|REL]"
+ *
+ * A group "NONE" (the default) gives no per-field bound.
+ */
+std::map<std::string, FieldBound> parse_field_bounds(
+    const std::vector<std::vector<std::string>>& groups,
+    bool relative_by_default);
+
+#endif /* COMPRESSED_WRITER_HPP */
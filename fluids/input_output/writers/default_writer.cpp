@@ -3,26 +3,34 @@
 #include "../../grid/karagiozis_grid.hpp"
 #include "../../utils/point_functions.hpp"
 #include "nan_checker.hpp"
+#include "output_selection.hpp"
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 
-void default_writer(
-    CartesianGrid& grid, std::string& file_name, PointFunctions& pf)
+void default_writer(CartesianGrid& grid, std::string& file_name,
+    PointFunctions& pf, const OutputSelection& selection)
 {
     std::ofstream output(file_name + ".txt");
 
-    output << "x,y,rho,u,v,E,T,p,mach,entropy" << std::endl;
-    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
-        auto p = grid.values(ind);
-        output << std::scientific << std::setprecision(15) << grid.X(ind) << ","
-               << grid.Y(ind) << "," << default_if_nan(pf.rho(p)) << ","
-               << default_if_nan(pf.u(p)) << "," << default_if_nan(pf.v(p))
-               << "," << default_if_nan(pf.e(p)) << ","
-               << default_if_nan(pf.temperature(p)) << ","
-               << default_if_nan(pf.pressure(p)) << ","
-               << default_if_nan(pf.mach_number(p)) << ","
-               << default_if_nan(pf.entropy(p)) << std::endl;
+    output << "x,y";
+    for (auto& field : selection.fields()) {
+        output << "," << field.name;
+    }
+    output << std::endl;
+
+    auto range = selection.range(grid);
+    for (int i = range.i_begin; i < range.i_end; i += range.stride) {
+        for (int j = range.j_begin; j < range.j_end; j += range.stride) {
+            int ind = grid.IND(i, j);
+            auto p = grid.values(ind);
+            output << std::scientific << std::setprecision(15) << grid.X(ind)
+                   << "," << grid.Y(ind);
+            for (auto& field : selection.fields()) {
+                output << "," << default_if_nan((pf.*field.property)(p));
+            }
+            output << std::endl;
+        }
     }
     /*    try {
             auto& local_grid = dynamic_cast<KaragiozisGrid&>(grid);
@@ -4,10 +4,11 @@
 #include <string>
 class CartesianGrid;
 class KaragiozisGrid;
+class OutputSelection;
 struct PointFunctions;
 
-void default_writer(
-    CartesianGrid& grid, std::string& file_name, PointFunctions& pf);
+void default_writer(CartesianGrid& grid, std::string& file_name,
+    PointFunctions& pf, const OutputSelection& selection);
 
 void default_writer(
     KaragiozisGrid& grid, std::ofstream& output, PointFunctions& pf);
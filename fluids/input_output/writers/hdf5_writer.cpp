@@ -0,0 +1,333 @@
+#include "hdf5_writer.hpp"
+#include "../../grid/cartesian_grid.hpp"
+#include "nan_checker.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifdef WITH_HDF5
+#include <hdf5.h>
+#endif
+
+namespace {
+
+std::string padded(int number)
+{
+    std::string str = std::to_string(number);
+    return std::string(8 - std::min<size_t>(8, str.length()), '0') + str;
+}
+
+std::string strip_path(const std::string& name)
+{
+    auto pos = name.find_last_of('/');
+    return (pos == std::string::npos) ? name : name.substr(pos + 1);
+}
+
+#ifdef WITH_HDF5
+bool file_exists(const std::string& name)
+{
+    std::ifstream f(name);
+    return f.good();
+}
+
+/**
+ * @brief Creates a 2D dataset, chunked and compressed if requested, and fills
+ * it with data
+ */
+bool write_dataset(hid_t parent, const char* name, hid_t mem_type,
+    const void* data, hsize_t nI, hsize_t nJ, int chunk_size,
+    int compression_level)
+{
+    hsize_t dims[2] = {nI, nJ};
+    hid_t space = H5Screate_simple(2, dims, nullptr);
+    hid_t dcpl = H5Pcreate(H5P_DATASET_CREATE);
+    if (chunk_size > 0) {
+        hsize_t chunk[2] = {std::min<hsize_t>(chunk_size, nI),
+            std::min<hsize_t>(chunk_size, nJ)};
+        H5Pset_chunk(dcpl, 2, chunk);
+        if (compression_level > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE)) {
+            H5Pset_shuffle(dcpl);
+            H5Pset_deflate(dcpl, std::min(compression_level, 9));
+        }
+    }
+    hid_t dset = H5Dcreate2(
+        parent, name, mem_type, space, H5P_DEFAULT, dcpl, H5P_DEFAULT);
+    bool ok = dset >= 0
+        && H5Dwrite(dset, mem_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data) >= 0;
+    if (dset >= 0) {
+        H5Dclose(dset);
+    }
+    H5Pclose(dcpl);
+    H5Sclose(space);
+    return ok;
+}
+
+bool write_grid_group(hid_t file, const CartesianGrid& grid,
+    const OutputRange& range, int chunk_size, int compression_level)
+{
+    hid_t group
+        = H5Gcreate2(file, "grid", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if (group < 0) {
+        return false;
+    }
+    std::vector<double> x, y;
+    std::vector<int> flags;
+    for (int j = range.j_begin; j < range.j_end; j += range.stride) {
+        x.push_back(grid.X(grid.IND(0, j)));
+    }
+    for (int i = range.i_begin; i < range.i_end; i += range.stride) {
+        y.push_back(grid.Y(grid.IND(i, 0)));
+        for (int j = range.j_begin; j < range.j_end; j += range.stride) {
+            flags.push_back(grid.flag(grid.IND(i, j)));
+        }
+    }
+    bool ok = write_dataset(
+                  group, "x", H5T_NATIVE_DOUBLE, x.data(), 1, range.nJ(), 0, 0)
+        && write_dataset(
+               group, "y", H5T_NATIVE_DOUBLE, y.data(), 1, range.nI(), 0, 0)
+        && write_dataset(group, "flags", H5T_NATIVE_INT, flags.data(),
+               range.nI(), range.nJ(), chunk_size, compression_level);
+    H5Gclose(group);
+    return ok;
+}
+
+typedef std::vector<std::pair<std::string, double>> StepList;
+
+herr_t collect_step(
+    hid_t group, const char* name, const H5L_info_t*, void* data)
+{
+    auto steps = static_cast<StepList*>(data);
+    std::string group_name(name);
+    if (group_name.compare(0, 5, "step_") != 0) {
+        return 0;
+    }
+    double t = 0.0;
+    hid_t attr
+        = H5Aopen_by_name(group, name, "time", H5P_DEFAULT, H5P_DEFAULT);
+    if (attr >= 0) {
+        H5Aread(attr, H5T_NATIVE_DOUBLE, &t);
+        H5Aclose(attr);
+    }
+    steps->push_back(std::make_pair(group_name, t));
+    return 0;
+}
+#endif
+
+} // namespace
+
+Hdf5Writer::Hdf5Writer(const std::string& base_name_in,
+    int snapshots_per_file_in, int chunk_size_in, int compression_level_in,
+    const PointFunctions& pf_in, const OutputSelection& selection_in)
+    : base_name(base_name_in)
+    , snapshots_per_file(snapshots_per_file_in)
+    , chunk_size(chunk_size_in)
+    , compression_level(compression_level_in)
+    , pf(pf_in)
+    , selection(selection_in)
+    , scanned_previous(false)
+{
+}
+
+std::string Hdf5Writer::file_name_for(int counter) const
+{
+    if (snapshots_per_file <= 0) {
+        return base_name + ".h5";
+    }
+    return base_name + "_" + padded(counter / snapshots_per_file) + ".h5";
+}
+
+bool Hdf5Writer::first_in_file(int counter) const
+{
+    if (snapshots_per_file <= 0) {
+        return counter == 0;
+    }
+    return counter % snapshots_per_file == 0;
+}
+
+#ifdef WITH_HDF5
+void Hdf5Writer::scan_previous(int counter)
+{
+    int last_file
+        = (snapshots_per_file <= 0) ? 0 : counter / snapshots_per_file;
+    for (int f = 0; f <= last_file; f++) {
+        auto name = file_name_for(f * std::max(snapshots_per_file, 1));
+        if (!file_exists(name)) {
+            continue;
+        }
+        hid_t file = H5Fopen(name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        if (file < 0) {
+            continue;
+        }
+        StepList steps;
+        H5Literate(file, H5_INDEX_NAME, H5_ITER_INC, nullptr, collect_step,
+            &steps);
+        H5Fclose(file);
+        for (auto& step : steps) {
+            if (std::stoi(step.first.substr(5)) < counter) {
+                snapshots.push_back({name, step.first, step.second});
+            }
+        }
+    }
+}
+
+void Hdf5Writer::write(CartesianGrid& grid, const double& t, int counter)
+{
+    if (!scanned_previous) {
+        if (counter > 0) {
+            scan_previous(counter);
+        }
+        scanned_previous = true;
+    }
+
+    auto file_name = file_name_for(counter);
+    auto group_name = "step_" + padded(counter);
+
+    hid_t file;
+    if (first_in_file(counter) || !file_exists(file_name)) {
+        file = H5Fcreate(
+            file_name.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    }
+    else {
+        file = H5Fopen(file_name.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+    }
+    if (file < 0) {
+        std::cerr << "Could not open file " << file_name << std::endl;
+        return;
+    }
+
+    auto range = selection.range(grid);
+    bool ok = true;
+    if (H5Lexists(file, "grid", H5P_DEFAULT) <= 0) {
+        ok = write_grid_group(
+            file, grid, range, chunk_size, compression_level);
+    }
+    if (H5Lexists(file, group_name.c_str(), H5P_DEFAULT) > 0) {
+        H5Ldelete(file, group_name.c_str(), H5P_DEFAULT);
+    }
+
+    hid_t group = H5Gcreate2(
+        file, group_name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+    if (group >= 0) {
+        hid_t scalar = H5Screate(H5S_SCALAR);
+        hid_t attr = H5Acreate2(group, "time", H5T_NATIVE_DOUBLE, scalar,
+            H5P_DEFAULT, H5P_DEFAULT);
+        ok = ok && attr >= 0 && H5Awrite(attr, H5T_NATIVE_DOUBLE, &t) >= 0;
+        if (attr >= 0) {
+            H5Aclose(attr);
+        }
+        H5Sclose(scalar);
+
+        std::vector<double> buffer(range.nTotal());
+        for (auto& field : selection.fields()) {
+            int k = 0;
+            for (int i = range.i_begin; i < range.i_end; i += range.stride) {
+                for (int j = range.j_begin; j < range.j_end;
+                     j += range.stride) {
+                    buffer[k++] = default_if_nan(
+                        (pf.*field.property)(grid.values(grid.IND(i, j))));
+                }
+            }
+            ok = ok
+                && write_dataset(group, field.long_name, H5T_NATIVE_DOUBLE,
+                       buffer.data(), range.nI(), range.nJ(), chunk_size,
+                       compression_level);
+        }
+        H5Gclose(group);
+    }
+    else {
+        ok = false;
+    }
+    H5Fclose(file);
+
+    if (!ok) {
+        std::cout << "Failed while writing to file " << file_name << std::endl;
+        return;
+    }
+
+    snapshots.erase(std::remove_if(snapshots.begin(), snapshots.end(),
+                        [&](const Snapshot& s) {
+                            return s.group_name == group_name;
+                        }),
+        snapshots.end());
+    snapshots.push_back({file_name, group_name, t});
+    write_xdmf(grid);
+}
+#else
+void Hdf5Writer::scan_previous(int) {}
+
+void Hdf5Writer::write(CartesianGrid&, const double&, int)
+{
+    std::cerr << "Output type 'HDF5' is not supported: "
+              << "templateFluids was built without HDF5" << std::endl;
+}
+#endif
+
+void Hdf5Writer::write_xdmf(const CartesianGrid& grid) const
+{
+    auto xdmf_name = base_name + ".xmf";
+    auto tmp_name = xdmf_name + ".tmp";
+    std::ofstream output(tmp_name);
+    if (!output.is_open()) {
+        std::cerr << "Could not open file " << tmp_name << std::endl;
+        return;
+    }
+
+    auto range = selection.range(grid);
+    std::string dims_2d
+        = std::to_string(range.nI()) + " " + std::to_string(range.nJ());
+    output << "<?xml version=\"1.0\" ?>" << std::endl
+           << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>" << std::endl
+           << "<Xdmf Version=\"2.0\">" << std::endl
+           << " <Domain>" << std::endl
+           << "  <Grid Name=\"TimeSeries\" GridType=\"Collection\" "
+              "CollectionType=\"Temporal\">"
+           << std::endl;
+
+    for (auto& snap : snapshots) {
+        auto h5 = strip_path(snap.file_name);
+        output << "   <Grid Name=\"" << snap.group_name
+               << "\" GridType=\"Uniform\">" << std::endl
+               << "    <Time Value=\"" << std::scientific
+               << std::setprecision(15) << snap.t << "\"/>" << std::endl
+               << "    <Topology TopologyType=\"2DRectMesh\" Dimensions=\""
+               << dims_2d << "\"/>" << std::endl
+               << "    <Geometry GeometryType=\"VXVY\">" << std::endl
+               << "     <DataItem Dimensions=\"" << range.nJ()
+               << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">"
+               << h5 << ":/grid/x</DataItem>" << std::endl
+               << "     <DataItem Dimensions=\"" << range.nI()
+               << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">"
+               << h5 << ":/grid/y</DataItem>" << std::endl
+               << "    </Geometry>" << std::endl
+               << "    <Attribute Name=\"Flags\" AttributeType=\"Scalar\" "
+                  "Center=\"Node\">"
+               << std::endl
+               << "     <DataItem Dimensions=\"" << dims_2d
+               << "\" NumberType=\"Int\" Precision=\"4\" Format=\"HDF\">" << h5
+               << ":/grid/flags</DataItem>" << std::endl
+               << "    </Attribute>" << std::endl;
+        for (auto& field : selection.fields()) {
+            output << "    <Attribute Name=\"" << field.long_name
+                   << "\" AttributeType=\"Scalar\" Center=\"Node\">"
+                   << std::endl
+                   << "     <DataItem Dimensions=\"" << dims_2d
+                   << "\" NumberType=\"Float\" Precision=\"8\" "
+                      "Format=\"HDF\">"
+                   << h5 << ":/" << snap.group_name << "/" << field.long_name
+                   << "</DataItem>" << std::endl
+                   << "    </Attribute>" << std::endl;
+        }
+        output << "   </Grid>" << std::endl;
+    }
+
+    output << "  </Grid>" << std::endl
+           << " </Domain>" << std::endl
+           << "</Xdmf>" << std::endl;
+    output.close();
+
+    if (output.fail() || std::rename(tmp_name.c_str(), xdmf_name.c_str())) {
+        std::cout << "Failed while writing to file " << xdmf_name << std::endl;
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef HDF5_WRITER_HPP
+#define HDF5_WRITER_HPP
+
+#include "../../utils/point_functions.hpp"
+#include "output_selection.hpp"
+#include <string>
+#include <vector>
+
+class CartesianGrid;
+
+/**
+ * \class Hdf5Writer
+ * @brief Writes snapshots as chunked, compressed datasets in HDF5 files
+ *
+ * Every snapshot becomes a group "/step_XXXXXXXX" holding one dataset per
+ * selected field (over the selected region) and a "time" attribute. The grid
+ * coordinates and flags are written once per file under "/grid". With
+ * snapshots_per_file = 0 the whole run goes to a single file, otherwise a new
+ * file is started every snapshots_per_file snapshots. After each write an
+ * XDMF descriptor (base_name.xmf) listing every snapshot is rewritten so the
+ * series can be opened directly in ParaView or VisIt. When a run continues
+ * from OUTPUT_COUNTER > 0, the snapshots already on disk are kept and listed.
+ */
+class Hdf5Writer {
+public:
+    Hdf5Writer(const std::string& base_name, int snapshots_per_file,
+        int chunk_size, int compression_level, const PointFunctions& pf,
+        const OutputSelection& selection = OutputSelection());
+
+    void write(CartesianGrid& grid, const double& t, int counter);
+
+private:
+    struct Snapshot {
+        std::string file_name;
+        std::string group_name;
+        double t;
+    };
+
+    std::string base_name;
+    int snapshots_per_file;
+    int chunk_size;
+    int compression_level;
+    PointFunctions pf;
+    OutputSelection selection;
+    std::vector<Snapshot> snapshots;
+    bool scanned_previous;
+
+    std::string file_name_for(int counter) const;
+    bool first_in_file(int counter) const;
+    void scan_previous(int counter);
+    void write_xdmf(const CartesianGrid& grid) const;
+};
+
+#endif /* HDF5_WRITER_HPP */
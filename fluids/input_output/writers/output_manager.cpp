@@ -0,0 +1,121 @@
+#include "output_manager.hpp"
+#include "../../utils/binary_io.hpp"
+#include "../../utils/parallel/decomposition.hpp"
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+OutputManager::OutputManager(Options& opt)
+    : partitioned(parallel::size() > 1 and opt.output_partitioned())
+    , whole(parallel::size() > 1 and parallel::is_root() and !partitioned
+              ? std::make_shared<CartesianGrid>(
+                  CartesianGrid::whole_domain(opt))
+              : nullptr)
+{
+    const double t_init = opt.t_init();
+    const double print_interval = opt.print_interval();
+    auto suffix
+        = partitioned ? "_rank" + std::to_string(parallel::rank()) : "";
+    streams.push_back(
+        {Writer(opt, suffix), print_interval, t_init + print_interval});
+
+    auto names = opt.output_streams();
+    if (names.empty() || names[0] == "NONE") {
+        return;
+    }
+    auto intervals = opt.output_stream_intervals();
+    auto strides = opt.output_stream_strides();
+    auto fields = opt.output_stream_fields();
+    auto boxes = opt.output_stream_boxes();
+
+    for (size_t s = 0; s < names.size(); s++) {
+        double interval = (s < intervals.size()) ? std::stod(intervals[s])
+                                                 : print_interval;
+        int stride = (s < strides.size()) ? std::stoi(strides[s]) : 1;
+        std::vector<std::string> stream_fields
+            = (s < fields.size()) ? fields[s] : std::vector<std::string>();
+        std::vector<std::string> stream_box
+            = (s < boxes.size()) ? boxes[s] : std::vector<std::string>();
+        if (interval <= 0) {
+            std::cerr << "Output stream '" << names[s]
+                      << "' needs a positive interval" << std::endl;
+            throw(-1);
+        }
+        streams.push_back(
+            {Writer(opt, opt.output_file_name() + "_" + names[s] + suffix, 0,
+                 OutputSelection(stream_fields, stream_box, stride)),
+                interval, t_init + interval});
+    }
+}
+
+void OutputManager::collect(const CartesianGrid& grid)
+{
+    auto& d = *grid.decomposition();
+    if (collected_counts.empty()) {
+        int procs = parallel::size();
+        for (int r = 0; r < procs; r++) {
+            parallel::Decomposition block(
+                d.global_nPointsI(), d.global_nPointsJ(), procs, r, d.halo());
+            collected_counts.push_back(4 * block.nPointsOwned());
+            for (int ind = 0; ind < block.nPointsTotal(); ind++) {
+                if (block.is_owned(ind)) {
+                    collected_points.push_back(block.global_ind(ind));
+                }
+            }
+        }
+    }
+    std::vector<double> owned;
+    owned.reserve(4 * d.nPointsOwned());
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        if (d.is_owned(ind)) {
+            auto& p = grid.values(ind);
+            owned.insert(owned.end(), {p.rho(), p.ru(), p.rv(), p.e()});
+        }
+    }
+    std::vector<double> all;
+    parallel::gather(owned, collected_counts, &all);
+    if (!whole) {
+        return;
+    }
+    for (size_t k = 0; k < collected_points.size(); k++) {
+        whole->set_values(Point(all[4 * k], all[4 * k + 1], all[4 * k + 2],
+                              all[4 * k + 3]),
+            collected_points[k]);
+    }
+}
+
+double OutputManager::next_output_time() const
+{
+    double next = streams[0].next;
+    for (auto& stream : streams) {
+        next = std::min(next, stream.next);
+    }
+    return next;
+}
+
+void OutputManager::save_state(std::ostream& os) const
+{
+    binary_io::write(os, static_cast<uint64_t>(streams.size()));
+    for (auto& stream : streams) {
+        binary_io::write(os, stream.writer.output_counter());
+        binary_io::write(os, stream.next);
+    }
+}
+
+void OutputManager::load_state(std::istream& is)
+{
+    uint64_t n_streams;
+    binary_io::read(is, n_streams);
+    if (n_streams != streams.size()) {
+        std::cerr << "Checkpoint has " << n_streams
+                  << " output streams but the configuration has "
+                  << streams.size() << std::endl;
+        throw(-1);
+    }
+    for (auto& stream : streams) {
+        int counter;
+        binary_io::read(is, counter);
+        binary_io::read(is, stream.next);
+        stream.writer.set_output_counter(counter);
+    }
+}
@@ -0,0 +1,133 @@
+#ifndef OUTPUT_MANAGER_HPP
+#define OUTPUT_MANAGER_HPP
+
+#include "../../utils/parallel/communicator.hpp"
+#include "../options.hpp"
+#include "writer.hpp"
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * \class OutputManager
+ * @brief Keeps every output stream and decides when each one is written
+ *
+ * The main stream is configured by PRINT_INTERVAL, OUTPUT_FIELDS, OUTPUT_BOX
+ * and OUTPUT_STRIDE and writes to OUTPUT_FILE_NAME. Extra streams are listed
+ * by name in OUTPUT_STREAMS; the n-th entry of OUTPUT_STREAM_INTERVALS and
+ * OUTPUT_STREAM_STRIDES and the n-th ";"-separated group of
+ * OUTPUT_STREAM_FIELDS and OUTPUT_STREAM_BOXES configure the n-th stream.
+ * Missing entries fall back to PRINT_INTERVAL, stride 1, every field and the
+ * whole grid. Stream files are named OUTPUT_FILE_NAME_<stream name>.
+ * When the grid is split among processes the blocks are collected on the
+ * first process, which writes the whole domain and must hold the whole grid
+ * for that. With OUTPUT_PARTITIONED = TRUE every process writes the points
+ * it owns instead, to files named as those of the whole domain with
+ * "_rank<N>" after the stream name. No process then holds more than its
+ * block, and together the files hold what the whole domain would.
+ */
+class OutputManager {
+public:
+    OutputManager(Options& opt);
+
+    /**
+     * @brief Writes every stream, used for the initial and final states
+     */
+    template <typename Grid>
+    void write_all(Grid& grid, const double& t)
+    {
+        if (grid.decomposition() and !partitioned) {
+            collect(grid);
+        }
+        for (auto& stream : streams) {
+            write(stream, grid, t);
+        }
+    }
+
+    /**
+     * @brief Writes the streams whose next output time was reached
+     *
+     * @return true if the main stream was written
+     */
+    template <typename Grid>
+    bool write_due(Grid& grid, const double& t)
+    {
+        bool main_written = false;
+        if (grid.decomposition() and !partitioned
+            and t >= next_output_time()) {
+            collect(grid);
+        }
+        for (size_t s = 0; s < streams.size(); s++) {
+            auto& stream = streams[s];
+            if (t >= stream.next) {
+                write(stream, grid, t);
+                while (stream.next <= t) {
+                    stream.next += stream.interval;
+                }
+                main_written = main_written || s == 0;
+            }
+        }
+        return main_written;
+    }
+
+    /**
+     * @brief Earliest time at which some stream must be written
+     */
+    double next_output_time() const;
+
+    /**
+     * @name Checkpointing: counters and next output time of every stream
+     * @{ */
+    void save_state(std::ostream& os) const;
+    void load_state(std::istream& is);
+    /**  @} */
+
+private:
+    struct Stream {
+        Writer writer;
+        double interval;
+        double next;
+    };
+    std::vector<Stream> streams;
+
+    /**
+     * @name Decomposed grids
+     * @{ */
+    const bool partitioned; ///< Each process writes its own block
+    /// Only on the first process, and only if the output is not partitioned
+    std::shared_ptr<CartesianGrid> whole;
+    std::vector<int> collected_counts;    ///< Values sent by each process
+    std::vector<int> collected_points;    ///< Global index of each point
+
+    /**
+     * @brief Copies the points owned by every process to whole
+     */
+    void collect(const CartesianGrid& grid);
+
+    template <typename Grid>
+    void write(Stream& stream, Grid& grid, const double& t)
+    {
+        if (!grid.decomposition()) {
+            stream.writer.write(grid, t);
+        }
+        else if (partitioned) {
+            // Blocks that own none of the selected points have no file
+            if (stream.writer.selects_points(grid)) {
+                stream.writer.write(grid, t);
+            }
+            else {
+                stream.writer.skip();
+            }
+        }
+        else if (whole) {
+            stream.writer.write(*whole, t);
+        }
+        else {
+            stream.writer.skip();
+        }
+    }
+    /**  @} */
+};
+
+#endif /* OUTPUT_MANAGER_HPP */
@@ -0,0 +1,147 @@
+#include "output_selection.hpp"
+#include "../../grid/cartesian_grid.hpp"
+#include "../../utils/point_functions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace {
+std::string to_lower(std::string str)
+{
+    std::transform(str.begin(), str.end(), str.begin(),
+        [](char c) { return std::tolower(c); });
+    return str;
+}
+
+bool matches(const OutputField& field, const std::string& name)
+{
+    auto lower = to_lower(name);
+    return lower == to_lower(field.name) || lower == to_lower(field.long_name);
+}
+} // namespace
+
+const std::vector<OutputField>& OutputSelection::all_fields()
+{
+    static const std::vector<OutputField> fields
+        = {{"rho", "Density", &PointFunctions::rho},
+            {"u", "VelocityX", &PointFunctions::u},
+            {"v", "VelocityY", &PointFunctions::v},
+            {"E", "Energy", &PointFunctions::e},
+            {"T", "Temperature", &PointFunctions::temperature},
+            {"p", "Pressure", &PointFunctions::pressure},
+            {"mach", "Mach", &PointFunctions::mach_number},
+            {"entropy", "Entropy", &PointFunctions::entropy}};
+    return fields;
+}
+
+OutputSelection::OutputSelection()
+    : selected(all_fields())
+    , has_box(false)
+    , box{0.0, 0.0, 0.0, 0.0}
+    , stride(1)
+{
+}
+
+OutputSelection::OutputSelection(const std::vector<std::string>& field_names,
+    const std::vector<std::string>& box_in, int stride_in)
+    : has_box(false)
+    , box{0.0, 0.0, 0.0, 0.0}
+    , stride(stride_in)
+{
+    if (field_names.empty() || to_lower(field_names[0]) == "all") {
+        selected = all_fields();
+    }
+    else {
+        // Keep the canonical order, whatever the order given by the user
+        for (auto& field : all_fields()) {
+            for (auto& name : field_names) {
+                if (matches(field, name)) {
+                    selected.push_back(field);
+                    break;
+                }
+            }
+        }
+        for (auto& name : field_names) {
+            if (!has_field(name)) {
+                std::cerr << "Output field '" << name << "' is not supported"
+                          << std::endl;
+                throw(-1);
+            }
+        }
+    }
+
+    if (!box_in.empty() && to_lower(box_in[0]) != "none") {
+        if (box_in.size() != 4) {
+            std::cerr << "Output box must be given as 'xmin xmax ymin ymax'"
+                      << std::endl;
+            throw(-1);
+        }
+        for (int k = 0; k < 4; k++) {
+            box[k] = std::stod(box_in[k]);
+        }
+        has_box = true;
+    }
+
+    if (stride < 1) {
+        std::cerr << "Output stride must be at least 1" << std::endl;
+        throw(-1);
+    }
+}
+
+bool OutputSelection::has_field(const std::string& name) const
+{
+    return std::any_of(selected.begin(), selected.end(),
+        [&](const OutputField& field) { return matches(field, name); });
+}
+
+OutputRange OutputSelection::range(const CartesianGrid& grid) const
+{
+    auto& d = grid.decomposition();
+    if (!d) {
+        return range(grid.nPointsI, grid.nPointsJ, grid.xmin, grid.ymin,
+            grid.dx, grid.dy);
+    }
+    // The box and stride apply to the whole grid, of which a block writes
+    // the points it owns
+    auto ret = range(d->global_nPointsI(), d->global_nPointsJ(),
+        grid.xmin - grid.dx * d->local_j().begin,
+        grid.ymin - grid.dy * d->local_i().begin, grid.dx, grid.dy);
+    restrict_to_block(
+        d->owned_i(), d->local_i().begin, &ret.i_begin, &ret.i_end);
+    restrict_to_block(
+        d->owned_j(), d->local_j().begin, &ret.j_begin, &ret.j_end);
+    return ret;
+}
+
+OutputRange OutputSelection::range(int nPointsI, int nPointsJ, double xmin,
+    double ymin, double dx, double dy) const
+{
+    OutputRange ret = {0, nPointsI, 0, nPointsJ, stride};
+    if (has_box) {
+        const double tol = 1e-10;
+        ret.j_begin = std::max(
+            0, static_cast<int>(std::ceil((box[0] - xmin) / dx - tol)));
+        ret.j_end = std::min(nPointsJ,
+            static_cast<int>(std::floor((box[1] - xmin) / dx + tol)) + 1);
+        ret.i_begin = std::max(
+            0, static_cast<int>(std::ceil((box[2] - ymin) / dy - tol)));
+        ret.i_end = std::min(nPointsI,
+            static_cast<int>(std::floor((box[3] - ymin) / dy + tol)) + 1);
+        ret.i_end = std::max(ret.i_end, ret.i_begin);
+        ret.j_end = std::max(ret.j_end, ret.j_begin);
+    }
+    return ret;
+}
+
+void OutputSelection::restrict_to_block(
+    const parallel::Range& owned, int local_begin, int* begin, int* end) const
+{
+    if (*begin < owned.begin) {
+        // First selected line of the block, on the stride of the whole grid
+        *begin += (owned.begin - *begin + stride - 1) / stride * stride;
+    }
+    *end = std::min(*end, owned.end);
+    *end = std::max(*end, *begin);
+    *begin -= local_begin;
+    *end -= local_begin;
+}
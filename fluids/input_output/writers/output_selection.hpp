@@ -0,0 +1,77 @@
+#ifndef OUTPUT_SELECTION_HPP
+#define OUTPUT_SELECTION_HPP
+
+#include "../../utils/useful_alias.hpp"
+#include <string>
+#include <vector>
+
+class CartesianGrid;
+namespace parallel {
+struct Range;
+}
+
+/**
+ * @brief A field that can be written: short name (csv header), long name
+ * (vtk/hdf5 dataset) and the PointFunctions member computing it
+ */
+struct OutputField {
+    const char* name;
+    const char* long_name;
+    alias::PointProperty property;
+};
+
+/**
+ * @brief Index range of the grid selected for output
+ *
+ * Lines i_begin, i_begin + stride, ... < i_end and likewise for columns.
+ */
+struct OutputRange {
+    int i_begin, i_end, j_begin, j_end, stride;
+    int nI() const { return (i_end - i_begin + stride - 1) / stride; }
+    int nJ() const { return (j_end - j_begin + stride - 1) / stride; }
+    int nTotal() const { return nI() * nJ(); }
+};
+
+/**
+ * \class OutputSelection
+ * @brief Which fields, which region and which resolution a writer outputs
+ *
+ * Fields are matched case-insensitively against either name ("rho", "T")
+ * or long name ("Density", "Temperature"); "ALL" selects every field. The box
+ * is given in physical coordinates as "xmin xmax ymin ymax", "NONE" selects
+ * the whole grid. The stride subsamples the selected region in both
+ * directions.
+ *
+ * On a grid split among processes the box and stride still apply to the
+ * whole domain, and the range of a block holds the selected points it owns:
+ * the blocks of every process together select what the whole grid would.
+ */
+class OutputSelection {
+public:
+    OutputSelection(); ///< Every field, whole grid, full resolution
+    OutputSelection(const std::vector<std::string>& field_names,
+        const std::vector<std::string>& box_in, int stride_in);
+
+    const std::vector<OutputField>& fields() const { return selected; }
+    bool has_field(const std::string& name) const;
+    OutputRange range(const CartesianGrid& grid) const;
+
+    static const std::vector<OutputField>& all_fields();
+
+private:
+    std::vector<OutputField> selected;
+    bool has_box;
+    double box[4];
+    int stride;
+
+    OutputRange range(int nPointsI, int nPointsJ, double xmin, double ymin,
+        double dx, double dy) const;
+    /**
+     * @brief Limits the global range [begin, end) of lines (or columns) to
+     * the ones owned, then makes it local to a block starting at local_begin
+     */
+    void restrict_to_block(const parallel::Range& owned, int local_begin,
+        int* begin, int* end) const;
+};
+
+#endif /* OUTPUT_SELECTION_HPP */
@@ -0,0 +1,137 @@
+#include "step_log.hpp"
+#include "../../utils/parallel/communicator.hpp"
+#include "../options.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+const size_t EARLY_FLUSH_BYTES = 1 << 16;
+}
+
+StepLog::StepLog(Options& opt)
+    : json(opt.step_log_format() == "JSONL")
+    , interval(std::max(1, opt.step_log_interval()))
+    , progress_interval(opt.progress_interval())
+    , flush_period(opt.step_log_flush_seconds())
+    , start(std::chrono::steady_clock::now())
+    , replica(opt.step_log() != "NONE" and !parallel::is_root())
+    , writing(false)
+    , stop(false)
+{
+    auto name = opt.step_log();
+    if (name == "NONE" or replica) {
+        return;
+    }
+    if (!json and opt.step_log_format() != "CSV") {
+        std::cerr << "Unknown STEP_LOG_FORMAT " << opt.step_log_format()
+                  << ", using CSV" << std::endl;
+    }
+    auto file_name = opt.output_base_path() + name;
+    // A restarted run keeps the records written before the checkpoint
+    output.open(file_name, opt.restart() ? std::ios::app : std::ios::trunc);
+    if (!output.is_open()) {
+        std::cerr << "Could not open file " << file_name << std::endl;
+        return;
+    }
+    if (!json and output.tellp() == 0) {
+        pending = "step,t,dt,wall_seconds,max_mach_number,max_u_plus_c,"
+                  "max_v_plus_c,shocks,revisit,l2_rho,l2_ru,l2_rv,l2_e,"
+                  "linf_rho,linf_ru,linf_rv,linf_e\n";
+    }
+    flusher = std::thread(&StepLog::flush_loop, this);
+}
+
+StepLog::~StepLog()
+{
+    if (!flusher.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+    }
+    wake.notify_one();
+    flusher.join();
+}
+
+void StepLog::record(const StepRecord& rec)
+{
+    if (replica) {
+        return;
+    }
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now()
+        - start;
+    const char* pattern = json
+        ? "{\"step\": %ld, \"t\": %.10e, \"dt\": %.6e, \"wall_seconds\": "
+          "%.6f, \"max_mach_number\": %.6e, \"max_u_plus_c\": %.6e, "
+          "\"max_v_plus_c\": %.6e, \"shocks\": %ld, \"revisit\": %ld, "
+          "\"residual_l2\": [%.6e, %.6e, %.6e, %.6e], "
+          "\"residual_linf\": [%.6e, %.6e, %.6e, %.6e]}\n"
+        : "%ld,%.10e,%.6e,%.6f,%.6e,%.6e,%.6e,%ld,%ld,%.6e,%.6e,%.6e,%.6e,"
+          "%.6e,%.6e,%.6e,%.6e\n";
+    char line[512];
+    int length = std::snprintf(line, sizeof(line), pattern, rec.step, rec.t,
+        rec.dt, wall.count(), rec.max_mach_number, rec.max_u_plus_c,
+        rec.max_v_plus_c, rec.shocks, rec.revisit, rec.residual.l2[0],
+        rec.residual.l2[1], rec.residual.l2[2], rec.residual.l2[3],
+        rec.residual.linf[0], rec.residual.linf[1], rec.residual.linf[2],
+        rec.residual.linf[3]);
+    if (length <= 0) {
+        return;
+    }
+    bool large;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.append(line, std::min<size_t>(length, sizeof(line) - 1));
+        large = pending.size() > EARLY_FLUSH_BYTES;
+    }
+    if (large) {
+        wake.notify_one();
+    }
+}
+
+void StepLog::flush()
+{
+    if (!output.is_open()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    write_pending(lock);
+}
+
+void StepLog::flush_loop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stop) {
+        wake.wait_for(lock, flush_period, [this] {
+            return stop or pending.size() > EARLY_FLUSH_BYTES;
+        });
+        write_pending(lock);
+    }
+    write_pending(lock);
+}
+
+/**
+ * @brief Writes the buffer without holding the lock, so record() does not
+ * wait on the file system. The lock is held again on return. Only one
+ * buffer is written at a time, which keeps the writes of flush() and of the
+ * background thread in order, and a flush() returns after the write it
+ * found in progress.
+ */
+void StepLog::write_pending(std::unique_lock<std::mutex>& lock)
+{
+    written.wait(lock, [this] { return !writing; });
+    if (pending.empty()) {
+        return;
+    }
+    std::string data;
+    data.swap(pending);
+    writing = true;
+    lock.unlock();
+    output << data;
+    output.flush();
+    lock.lock();
+    writing = false;
+    written.notify_all();
+}
@@ -0,0 +1,94 @@
+#ifndef STEP_LOG_HPP
+#define STEP_LOG_HPP
+
+#include "../../utils/residual_norms.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class Options;
+
+/**
+ * @brief Quantities logged for one time step
+ */
+struct StepRecord {
+    long step;
+    double t;
+    double dt;
+    double max_mach_number;
+    double max_u_plus_c;
+    double max_v_plus_c;
+    long shocks;  ///< Shock discontinuities or shocked points
+    long revisit; ///< Points close to discontinuities
+    ResidualNorms residual; ///< Norms of d(rho, ru, rv, e)/dt
+};
+
+/**
+ * \class StepLog
+ * @brief Buffered, machine readable per-step log for run monitoring
+ *
+ * Every STEP_LOG_INTERVAL steps a record is appended to an in-memory buffer,
+ * which a background thread writes to OUTPUT_BASE_PATH + STEP_LOG every
+ * STEP_LOG_FLUSH_SECONDS (or earlier if it grows large), so the file can be
+ * followed with tail -f at no cost to the solver thread. STEP_LOG_FORMAT
+ * selects CSV (with a header line) or JSONL. STEP_LOG = NONE disables the
+ * log. The console progress line is printed every PROGRESS_INTERVAL steps
+ * (0 disables it). Only the first process writes the log.
+ */
+class StepLog {
+public:
+    StepLog(Options& opt);
+    ~StepLog();
+    StepLog(const StepLog&) = delete;
+    StepLog& operator=(const StepLog&) = delete;
+
+    bool enabled() const { return replica or output.is_open(); }
+    /**
+     * @brief Whether step will be logged, so callers only compute the record
+     * (residuals in particular) when needed
+     */
+    bool due(long step) const
+    {
+        return enabled() and step % interval == 0;
+    }
+    void record(const StepRecord& rec);
+
+    bool progress_due(long step) const
+    {
+        return progress_interval > 0 and step % progress_interval == 0;
+    }
+
+    /**
+     * @brief Writes whatever is buffered and waits for it
+     */
+    void flush();
+
+private:
+    std::ofstream output;
+    const bool json;
+    const long interval;
+    const long progress_interval;
+    const std::chrono::duration<double> flush_period;
+    const std::chrono::steady_clock::time_point start;
+    /**
+     * Set on every process but the first in runs on several processes: they
+     * take part in the reductions behind each record without writing it
+     */
+    const bool replica;
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable written; ///< Notified when writing clears
+    std::string pending;
+    bool writing; ///< A buffer taken from pending is being written
+    bool stop;
+    std::thread flusher;
+
+    void flush_loop();
+    void write_pending(std::unique_lock<std::mutex>& lock);
+};
+
+#endif /* STEP_LOG_HPP */
@@ -0,0 +1,106 @@
+#include "../../../grid/test/cartesian_grid_test_interface.hpp"
+#include "../../../utils/point_functions.hpp"
+#include "../../options.hpp"
+#include "../compressed_writer.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <fstream>
+
+namespace {
+const int nI = 40;
+const int nJ = 50;
+
+// Smooth flow field on a 40x50 grid
+CartesianGridTestInterface smooth_grid(Options& opt)
+{
+    return CartesianGridTestInterface::fluid_grid(
+        opt, nI, nJ, 0.1, 0.1, [](int i, int j) {
+            double rho = 1.0 + 0.2 * std::sin(0.1 * i) * std::cos(0.13 * j);
+            return Point(rho, 0.1 * rho * std::cos(0.05 * i), 0.02 * rho,
+                40.0 + std::sin(0.07 * j));
+        });
+}
+
+size_t file_size(const std::string& file_name)
+{
+    std::ifstream input(file_name, std::ios::binary | std::ios::ate);
+    return static_cast<size_t>(input.tellg());
+}
+}
+
+TEST(CompressedWriterTest, testErrorBoundIsRespected)
+{
+    Options opt;
+    auto grid = smooth_grid(opt);
+    PointFunctions pf(opt.mach(), opt.gam());
+    CompressedWriter writer(pf, OutputSelection(), {1e-4, true},
+        parse_field_bounds({{"rho", "1e-6", "ABS"}, {"p", "0"}}, true), 6,
+        false);
+    writer.write(grid, "./compressed_test.tfz", 0.5);
+
+    auto snapshot = read_compressed_snapshot("./compressed_test.tfz");
+    ASSERT_EQ(snapshot.nI, nI);
+    ASSERT_EQ(snapshot.nJ, nJ);
+    ASSERT_EQ(snapshot.t, 0.5);
+    ASSERT_DOUBLE_EQ(snapshot.dx, 0.1);
+    ASSERT_EQ(snapshot.names.size(), OutputSelection::all_fields().size());
+
+    for (auto& error : writer.validate(grid, "./compressed_test.tfz")) {
+        ASSERT_LE(error.max_error, error.bound) << error.name;
+        if (error.name == "rho") {
+            ASSERT_EQ(error.bound, 1e-6);
+        }
+        if (error.name == "p") {
+            // Lossless
+            ASSERT_EQ(error.max_error, 0.0);
+        }
+    }
+
+    // Much smaller than the 8 bytes per value of the raw data
+    size_t raw = 8 * nI * nJ * OutputSelection::all_fields().size();
+    ASSERT_LT(file_size("./compressed_test.tfz"), raw / 2);
+}
+
+TEST(CompressedWriterTest, testSelectionAndLossless)
+{
+    Options opt;
+    auto grid = smooth_grid(opt);
+    PointFunctions pf(opt.mach(), opt.gam());
+    OutputSelection selection({"rho", "T"}, {"1.0", "2.0", "0.5", "1.5"}, 2);
+    CompressedWriter writer(pf, selection, {0, false}, {}, 6, false);
+    writer.write(grid, "./compressed_lossless.tfz", 1.0);
+
+    auto snapshot = read_compressed_snapshot("./compressed_lossless.tfz");
+    ASSERT_EQ(snapshot.nI, 6);
+    ASSERT_EQ(snapshot.nJ, 6);
+    ASSERT_DOUBLE_EQ(snapshot.x0, 1.0);
+    ASSERT_DOUBLE_EQ(snapshot.y0, 0.5);
+    ASSERT_DOUBLE_EQ(snapshot.dx, 0.2);
+    auto& rho = snapshot.field("rho");
+    ASSERT_EQ(rho[0], grid.rho(grid.IND(5, 10)));
+    ASSERT_EQ(rho[7], grid.rho(grid.IND(7, 12)));
+    ASSERT_THROW(snapshot.field("u"), int);
+}
+
+#ifdef WITH_ZLIB
+TEST(CompressedWriterTest, testFailedCompressionReachesTheCaller)
+{
+    Options opt;
+    auto grid = smooth_grid(opt);
+    PointFunctions pf(opt.mach(), opt.gam());
+    // zlib rejects the level in every field, inside the parallel loop
+    CompressedWriter writer(pf, OutputSelection(), {1e-4, true}, {}, 42,
+        false);
+    ASSERT_THROW(writer.write(grid, "./compressed_failed.tfz", 0.5), int);
+}
+#endif
+
+TEST(CompressedWriterTest, testBadInput)
+{
+    ASSERT_THROW(parse_field_bounds({{"rho"}}, true), int);
+    ASSERT_THROW(parse_field_bounds({{"rho", "1e-3", "PCT"}}, true), int);
+
+    std::ofstream("./not_compressed.tfz") << "garbage";
+    ASSERT_THROW(read_compressed_snapshot("./not_compressed.tfz"), int);
+}
@@ -0,0 +1,99 @@
+#include "../../../grid/test/cartesian_grid_test_interface.hpp"
+#include "../../../utils/point_functions.hpp"
+#include "../../options.hpp"
+#include "../hdf5_writer.hpp"
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <hdf5.h>
+#include <sstream>
+#include <vector>
+
+namespace {
+// 2x2 grid with density 1, 2, 2, 1 in index order
+CartesianGridTestInterface sample_grid(Options& opt)
+{
+    return CartesianGridTestInterface::fluid_grid(
+        opt, 2, 2, 0.01, 0.02, [](int i, int j) {
+            return Point(1.0 + (i + j) % 2, 0.0, 0.0, 40.0);
+        });
+}
+
+std::vector<double> read_field(const std::string& file_name,
+    const std::string& dataset, double& t)
+{
+    std::vector<double> values(4, 0.0);
+    hid_t file = H5Fopen(file_name.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    hid_t dset = H5Dopen2(file, dataset.c_str(), H5P_DEFAULT);
+    H5Dread(dset, H5T_NATIVE_DOUBLE, H5S_ALL, H5S_ALL, H5P_DEFAULT,
+        values.data());
+    H5Dclose(dset);
+    auto group_name = dataset.substr(0, dataset.find_last_of('/'));
+    hid_t attr = H5Aopen_by_name(
+        file, group_name.c_str(), "time", H5P_DEFAULT, H5P_DEFAULT);
+    H5Aread(attr, H5T_NATIVE_DOUBLE, &t);
+    H5Aclose(attr);
+    H5Fclose(file);
+    return values;
+}
+}
+
+TEST(Hdf5WriterTest, testSingleFileSeries)
+{
+    Options opt;
+    auto grid = sample_grid(opt);
+    PointFunctions pf(opt.mach(), opt.gam());
+    Hdf5Writer writer("./hdf5_single", 0, 64, 4, pf);
+
+    writer.write(grid, 0.0, 0);
+    grid.setRho(3.0, 0);
+    writer.write(grid, 0.5, 1);
+
+    double t;
+    auto rho = read_field("./hdf5_single.h5", "/step_00000000/Density", t);
+    ASSERT_EQ(t, 0.0);
+    ASSERT_EQ(rho[0], 1.0);
+    ASSERT_EQ(rho[1], 2.0);
+    ASSERT_EQ(rho[2], 2.0);
+    ASSERT_EQ(rho[3], 1.0);
+
+    rho = read_field("./hdf5_single.h5", "/step_00000001/Density", t);
+    ASSERT_EQ(t, 0.5);
+    ASSERT_EQ(rho[0], 3.0);
+
+    std::ifstream xdmf("./hdf5_single.xmf");
+    std::stringstream contents;
+    contents << xdmf.rdbuf();
+    ASSERT_NE(contents.str().find("hdf5_single.h5:/step_00000001/Density"),
+        std::string::npos);
+    ASSERT_NE(contents.str().find("hdf5_single.h5:/grid/x"), std::string::npos);
+}
+
+TEST(Hdf5WriterTest, testSnapshotsPerFile)
+{
+    Options opt;
+    auto grid = sample_grid(opt);
+    PointFunctions pf(opt.mach(), opt.gam());
+    Hdf5Writer writer("./hdf5_split", 2, 1, 0, pf);
+
+    for (int counter = 0; counter < 3; counter++) {
+        writer.write(grid, 0.1 * counter, counter);
+    }
+
+    double t;
+    read_field("./hdf5_split_00000000.h5", "/step_00000001/Density", t);
+    ASSERT_DOUBLE_EQ(t, 0.1);
+    read_field("./hdf5_split_00000001.h5", "/step_00000002/Density", t);
+    ASSERT_DOUBLE_EQ(t, 0.2);
+
+    // A continued run keeps the snapshots already on disk in the descriptor
+    Hdf5Writer continued("./hdf5_split", 2, 1, 0, pf);
+    continued.write(grid, 0.3, 3);
+    std::ifstream xdmf("./hdf5_split.xmf");
+    std::stringstream contents;
+    contents << xdmf.rdbuf();
+    ASSERT_NE(contents.str().find("hdf5_split_00000000.h5:/step_00000000"),
+        std::string::npos);
+    ASSERT_NE(contents.str().find("hdf5_split_00000001.h5:/step_00000003"),
+        std::string::npos);
+}
@@ -0,0 +1,122 @@
+#include "../../../grid/test/cartesian_grid_test_interface.hpp"
+#include "../../../utils/point_functions.hpp"
+#include "../../options.hpp"
+#include "../default_writer.hpp"
+#include "../output_manager.hpp"
+#include "../output_selection.hpp"
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <sstream>
+
+namespace {
+// 4x5 grid, dx = 0.1, dy = 0.2, density 1, 2, ... in index order
+CartesianGridTestInterface sample_grid(Options& opt)
+{
+    return CartesianGridTestInterface::fluid_grid(
+        opt, 4, 5, 0.1, 0.2, [](int i, int j) {
+            return Point(1.0 + 5 * i + j, 0.0, 0.0, 40.0);
+        });
+}
+}
+
+TEST(OutputSelectionTest, testFieldSelection)
+{
+    OutputSelection all;
+    ASSERT_EQ(all.fields().size(), OutputSelection::all_fields().size());
+
+    OutputSelection some({"P", "density"}, {"NONE"}, 1);
+    ASSERT_EQ(some.fields().size(), 2u);
+    // Canonical order is kept
+    ASSERT_EQ(std::string(some.fields()[0].name), "rho");
+    ASSERT_EQ(std::string(some.fields()[1].name), "p");
+    ASSERT_TRUE(some.has_field("Pressure"));
+    ASSERT_FALSE(some.has_field("u"));
+
+    ASSERT_THROW(OutputSelection({"vorticity"}, {"NONE"}, 1), int);
+    ASSERT_THROW(OutputSelection({"ALL"}, {"0.0", "1.0"}, 1), int);
+    ASSERT_THROW(OutputSelection({"ALL"}, {"NONE"}, 0), int);
+}
+
+TEST(OutputSelectionTest, testRange)
+{
+    Options opt;
+    auto grid = sample_grid(opt);
+
+    auto whole = OutputSelection().range(grid);
+    ASSERT_EQ(whole.nI(), 4);
+    ASSERT_EQ(whole.nJ(), 5);
+
+    auto box = OutputSelection({"ALL"}, {"0.1", "0.3", "0.2", "10"}, 1)
+                   .range(grid);
+    ASSERT_EQ(box.j_begin, 1);
+    ASSERT_EQ(box.j_end, 4);
+    ASSERT_EQ(box.i_begin, 1);
+    ASSERT_EQ(box.i_end, 4);
+
+    auto strided = OutputSelection({"ALL"}, {"NONE"}, 2).range(grid);
+    ASSERT_EQ(strided.nI(), 2);
+    ASSERT_EQ(strided.nJ(), 3);
+    ASSERT_EQ(strided.nTotal(), 6);
+}
+
+TEST(OutputSelectionTest, testDefaultWriter)
+{
+    Options opt;
+    auto grid = sample_grid(opt);
+    PointFunctions pf(opt.mach(), opt.gam());
+    std::string file_name = "./selection_test";
+
+    default_writer(grid, file_name, pf,
+        OutputSelection({"rho"}, {"0.0", "0.4", "0.2", "0.6"}, 2));
+
+    std::ifstream input(file_name + ".txt");
+    std::string line;
+    std::getline(input, line);
+    ASSERT_EQ(line, "x,y,rho");
+    std::vector<double> rho;
+    while (std::getline(input, line)) {
+        rho.push_back(std::stod(line.substr(line.find_last_of(',') + 1)));
+    }
+    // Lines 1 and 3, columns 0, 2 and 4
+    ASSERT_EQ(rho, std::vector<double>({6.0, 8.0, 10.0, 16.0, 18.0, 20.0}));
+}
+
+TEST(OutputSelectionTest, testOutputStreams)
+{
+    std::istringstream config("OUTPUT_TYPE = DEFAULT\n"
+                              "OUTPUT_BASE_PATH = ./\n"
+                              "OUTPUT_FILE_NAME = streams_test\n"
+                              "PRINT_INTERVAL = 1.0\n"
+                              "OUTPUT_STREAMS = coarse, near\n"
+                              "OUTPUT_STREAM_INTERVALS = 0.25, 0.5\n"
+                              "OUTPUT_STREAM_STRIDES = 2\n"
+                              "OUTPUT_STREAM_FIELDS = rho u; ALL\n"
+                              "OUTPUT_STREAM_BOXES = NONE; 0 0.1 0 0.2\n");
+    Options opt(config);
+    auto grid = sample_grid(opt);
+    OutputManager output(opt);
+
+    ASSERT_DOUBLE_EQ(output.next_output_time(), 0.25);
+    ASSERT_FALSE(output.write_due(grid, 0.25));
+    ASSERT_DOUBLE_EQ(output.next_output_time(), 0.5);
+    ASSERT_FALSE(output.write_due(grid, 0.5));
+    ASSERT_DOUBLE_EQ(output.next_output_time(), 0.75);
+    ASSERT_FALSE(output.write_due(grid, 0.75));
+    ASSERT_TRUE(output.write_due(grid, 1.0));
+
+    std::ifstream coarse("./streams_test_coarse_00000003.txt");
+    std::string line;
+    std::getline(coarse, line);
+    ASSERT_EQ(line, "x,y,rho,u");
+    int lines = 0;
+    while (std::getline(coarse, line)) {
+        lines++;
+    }
+    ASSERT_EQ(lines, 6);
+
+    std::ifstream near("./streams_test_near_00000001.txt");
+    ASSERT_TRUE(near.good());
+    std::ifstream main_stream("./streams_test_00000000.txt");
+    ASSERT_TRUE(main_stream.good());
+}
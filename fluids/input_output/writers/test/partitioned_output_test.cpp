@@ -0,0 +1,99 @@
+#include "../../../grid/cartesian_grid.hpp"
+#include "../../../utils/parallel/communicator.hpp"
+#include "../../cases/canonical_cases.hpp"
+#include "../../options.hpp"
+#include "../output_manager.hpp"
+#include "gtest/gtest.h"
+
+#include <cerrno>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <utility>
+#include <vector>
+
+namespace {
+std::string rank_directory(int rank)
+{
+    return "./partitioned_rank" + std::to_string(rank) + "/";
+}
+
+/**
+ * @brief Fields of each point of a DEFAULT output file, by the position of
+ * the point on the grid. Blocks place their points from their own origin, so
+ * their coordinates may differ from those of the whole grid in the last
+ * digit
+ */
+void read_points(const std::string& file_name, double h,
+    std::map<std::pair<long, long>, std::string>* points)
+{
+    std::ifstream input(file_name);
+    std::string line;
+    std::getline(input, line);
+    while (std::getline(input, line)) {
+        std::istringstream fields(line);
+        double x, y;
+        char comma;
+        fields >> x >> comma >> y;
+        std::string values;
+        std::getline(fields, values);
+        (*points)[{std::lround(y / h), std::lround(x / h)}] = values;
+    }
+}
+} // namespace
+
+TEST(PartitionedOutputTest, testBlocksWriteWhatTheWholeGridWould)
+{
+    // Every process writes the case files of its own
+    auto directory = rank_directory(parallel::rank());
+    ASSERT_TRUE(mkdir(directory.c_str(), 0755) == 0 or errno == EEXIST);
+    const int n = 37;
+    auto case_options = write_case_input(
+        create_canonical_case("SHOCK_TUBE", n, "SIMPLE"), directory);
+    // Boxes and strides whose points do not start at a block edge
+    std::vector<std::string> selections = {"OUTPUT_STRIDE = 1\n",
+        "OUTPUT_STRIDE = 3\nOUTPUT_BOX = 0.1 0.8 0.2 0.9\n"};
+    for (size_t s = 0; s < selections.size(); s++) {
+        auto options = case_options + selections[s]
+            + "OUTPUT_TYPE = DEFAULT\nOUTPUT_BASE_PATH = " + directory + "\n";
+        auto whole_name = "whole" + std::to_string(s);
+        auto block_name = "block" + std::to_string(s);
+        std::istringstream whole_config(
+            options + "OUTPUT_FILE_NAME = " + whole_name + "\n");
+        std::istringstream block_config(options + "OUTPUT_FILE_NAME = "
+            + block_name + "\nOUTPUT_PARTITIONED = TRUE\n");
+        Options whole_opt(whole_config);
+        Options block_opt(block_config);
+        CartesianGrid grid(whole_opt);
+        ASSERT_TRUE(grid.decomposition() != nullptr);
+        OutputManager(whole_opt).write_all(grid, 0.0);
+        OutputManager(block_opt).write_all(grid, 0.0);
+        // Waits for every process to close its files
+        parallel::any(false);
+        if (!parallel::is_root()) {
+            continue;
+        }
+
+        const double h = 1.0 / (n - 1);
+        std::map<std::pair<long, long>, std::string> whole, blocks;
+        read_points(directory + whole_name + "_00000000.txt", h, &whole);
+        for (int r = 0; r < parallel::size(); r++) {
+            read_points(rank_directory(r) + block_name + "_rank"
+                    + std::to_string(r) + "_00000000.txt",
+                h, &blocks);
+        }
+        // No ASSERT here: the other processes go on to the next selection
+        EXPECT_FALSE(whole.empty());
+        EXPECT_EQ(blocks, whole);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    parallel::Environment environment;
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
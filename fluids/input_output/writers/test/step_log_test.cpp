@@ -0,0 +1,112 @@
+#include "../../options.hpp"
+#include "../step_log.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+std::vector<std::string> read_lines(const std::string& name)
+{
+    std::ifstream input(name);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(input, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+StepRecord record_for(long step)
+{
+    return {step, 0.1 * step, 0.1, 0.5, 1.5, 1.2, 0, 3,
+        {{{1e-3, 2e-3, 3e-3, 4e-3}}, {{1e-2, 2e-2, 3e-2, 4e-2}}}};
+}
+}
+
+TEST(StepLogTest, testCsvRecordsEveryInterval)
+{
+    std::istringstream stream("OUTPUT_BASE_PATH = ./\n"
+                              "STEP_LOG = step_log_test.csv\n"
+                              "STEP_LOG_INTERVAL = 2\n"
+                              "PROGRESS_INTERVAL = 0\n");
+    Options opt(stream);
+    {
+        StepLog log(opt);
+        ASSERT_TRUE(log.enabled());
+        ASSERT_FALSE(log.progress_due(0));
+        for (long step = 0; step < 10; step++) {
+            if (log.due(step)) {
+                log.record(record_for(step));
+            }
+        }
+        log.flush();
+        auto lines = read_lines("./step_log_test.csv");
+        ASSERT_EQ(lines.size(), 6u);
+        EXPECT_EQ(lines[0].compare(0, 8, "step,t,d"), 0);
+        EXPECT_EQ(lines[3].compare(0, 2, "4,"), 0);
+    }
+    std::remove("./step_log_test.csv");
+}
+
+TEST(StepLogTest, testJsonLinesAreWrittenOnDestruction)
+{
+    std::istringstream stream("OUTPUT_BASE_PATH = ./\n"
+                              "STEP_LOG = step_log_test.jsonl\n"
+                              "STEP_LOG_FORMAT = JSONL\n"
+                              "STEP_LOG_FLUSH_SECONDS = 100\n");
+    Options opt(stream);
+    {
+        StepLog log(opt);
+        for (long step = 0; step < 3; step++) {
+            log.record(record_for(step));
+        }
+    }
+    auto lines = read_lines("./step_log_test.jsonl");
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(lines[2].compare(0, 11, "{\"step\": 2,"), 0);
+    EXPECT_NE(lines[2].find("\"revisit\": 3"), std::string::npos);
+    EXPECT_NE(lines[2].find("\"residual_linf\": [1.000000e-02"),
+        std::string::npos);
+    std::remove("./step_log_test.jsonl");
+}
+
+TEST(StepLogTest, testFlushWhileTheFlusherWrites)
+{
+    std::istringstream stream("OUTPUT_BASE_PATH = ./\n"
+                              "STEP_LOG = step_log_flush_test.csv\n"
+                              "STEP_LOG_FLUSH_SECONDS = 1e-5\n"
+                              "PROGRESS_INTERVAL = 0\n");
+    Options opt(stream);
+    // The flusher writes almost all the time, so flush() keeps finding a
+    // write in progress
+    const long steps = 50000;
+    {
+        StepLog log(opt);
+        for (long step = 0; step < steps; step++) {
+            log.record(record_for(step));
+            if (step % 100 == 0) {
+                log.flush();
+            }
+        }
+        log.flush();
+        auto lines = read_lines("./step_log_flush_test.csv");
+        ASSERT_EQ(lines.size(), static_cast<size_t>(steps + 1));
+        for (long step = 0; step < steps; step++) {
+            auto prefix = std::to_string(step) + ",";
+            ASSERT_EQ(lines[step + 1].compare(0, prefix.size(), prefix), 0);
+        }
+    }
+    std::remove("./step_log_flush_test.csv");
+}
+
+TEST(StepLogTest, testDisabledLogIsNeverDue)
+{
+    Options opt;
+    StepLog disabled(opt);
+    EXPECT_FALSE(disabled.enabled());
+    EXPECT_FALSE(disabled.due(0));
+}
@@ -2,7 +2,8 @@
 #include "nan_checker.hpp"
 #include <fstream>
 
-void vtk_writer(CartesianGrid& grid, std::string& file_name, PointFunctions& pf)
+void vtk_writer(CartesianGrid& grid, std::string& file_name,
+    PointFunctions& pf, const OutputSelection& selection)
 {
     std::ofstream output(file_name + ".vtk");
     if (!output.is_open()) {
@@ -10,6 +11,8 @@ void vtk_writer(CartesianGrid& grid, std::string& file_name, PointFunctions& pf)
         return;
     }
 
+    auto range = selection.range(grid);
+
     // Header
     output << "# vtk DataFile Version 3.0" << std::endl
            << "VTK output from templateFluids" << std::endl
@@ -17,17 +20,17 @@ void vtk_writer(CartesianGrid& grid, std::string& file_name, PointFunctions& pf)
            << "DATASET RECTILINEAR_GRID" << std::endl;
 
     // Grid dimensions and actual coordinates
-    output << "DIMENSIONS " << grid.nPointsJ << " " << grid.nPointsI << " 1"
+    output << "DIMENSIONS " << range.nJ() << " " << range.nI() << " 1"
            << std::endl;
 
-    output << "X_COORDINATES " << grid.nPointsJ << " float" << std::endl;
-    for (int j = 0; j < grid.nPointsJ; j++) {
+    output << "X_COORDINATES " << range.nJ() << " float" << std::endl;
+    for (int j = range.j_begin; j < range.j_end; j += range.stride) {
         output << grid.X(grid.IND(0, j)) << " ";
     }
     output << std::endl;
 
-    output << "Y_COORDINATES " << grid.nPointsI << " float" << std::endl;
-    for (int i = 0; i < grid.nPointsI; i++) {
+    output << "Y_COORDINATES " << range.nI() << " float" << std::endl;
+    for (int i = range.i_begin; i < range.i_end; i += range.stride) {
         output << grid.Y(grid.IND(i, 0)) << " ";
     }
     output << std::endl;
@@ -36,82 +39,39 @@ void vtk_writer(CartesianGrid& grid, std::string& file_name, PointFunctions& pf)
     output << 0.0 << std::endl;
 
     // Data
-    output << "POINT_DATA " << grid.nPointsTotal << std::endl;
-
-    // Density
-    output << "SCALARS Density float" << std::endl;
-    output << "LOOKUP_TABLE DEFAULT" << std::endl;
-    for (int i = 0; i < grid.nPointsI; i++) {
-        for (int j = 0; j < grid.nPointsJ; j++) {
-            int ind = grid.IND(i, j);
-            output << default_if_nan(pf.rho(grid.values(ind))) << " ";
-        }
-        output << std::endl;
-    }
+    output << "POINT_DATA " << range.nTotal() << std::endl;
 
-    // Energy
-    output << "SCALARS Energy float" << std::endl;
-    output << "LOOKUP_TABLE DEFAULT" << std::endl;
-    for (int i = 0; i < grid.nPointsI; i++) {
-        for (int j = 0; j < grid.nPointsJ; j++) {
-            int ind = grid.IND(i, j);
-            output << default_if_nan(pf.e(grid.values(ind))) << " ";
+    // Scalars; the velocity components go together in a vector below
+    for (auto& field : selection.fields()) {
+        if (field.property == &PointFunctions::u
+            || field.property == &PointFunctions::v) {
+            continue;
         }
-        output << std::endl;
-    }
-
-    // Pressure
-    output << "SCALARS Pressure float" << std::endl;
-    output << "LOOKUP_TABLE DEFAULT" << std::endl;
-    for (int i = 0; i < grid.nPointsI; i++) {
-        for (int j = 0; j < grid.nPointsJ; j++) {
-            int ind = grid.IND(i, j);
-            output << default_if_nan(pf.pressure(grid.values(ind))) << " ";
-        }
-        output << std::endl;
-    }
-
-    // Temperature
-    output << "SCALARS Temperature float" << std::endl;
-    output << "LOOKUP_TABLE DEFAULT" << std::endl;
-    for (int i = 0; i < grid.nPointsI; i++) {
-        for (int j = 0; j < grid.nPointsJ; j++) {
-            int ind = grid.IND(i, j);
-            output << default_if_nan(pf.temperature(grid.values(ind))) << " ";
-        }
-        output << std::endl;
-    }
-
-    // Mach
-    output << "SCALARS Mach float" << std::endl;
-    output << "LOOKUP_TABLE DEFAULT" << std::endl;
-    for (int i = 0; i < grid.nPointsI; i++) {
-        for (int j = 0; j < grid.nPointsJ; j++) {
-            int ind = grid.IND(i, j);
-            output << default_if_nan(pf.mach_number(grid.values(ind))) << " ";
-        }
-        output << std::endl;
-    }
-
-    // Entropy
-    output << "SCALARS Entropy float" << std::endl;
-    output << "LOOKUP_TABLE DEFAULT" << std::endl;
-    for (int i = 0; i < grid.nPointsI; i++) {
-        for (int j = 0; j < grid.nPointsJ; j++) {
-            int ind = grid.IND(i, j);
-            output << default_if_nan(pf.entropy(grid.values(ind))) << " ";
+        output << "SCALARS " << field.long_name << " float" << std::endl;
+        output << "LOOKUP_TABLE DEFAULT" << std::endl;
+        for (int i = range.i_begin; i < range.i_end; i += range.stride) {
+            for (int j = range.j_begin; j < range.j_end; j += range.stride) {
+                int ind = grid.IND(i, j);
+                output << default_if_nan((pf.*field.property)(grid.values(ind)))
+                       << " ";
+            }
+            output << std::endl;
         }
-        output << std::endl;
     }
 
     // Velocity
-    output << "VECTORS Velocity float" << std::endl;
-    for (int i = 0; i < grid.nPointsI; i++) {
-        for (int j = 0; j < grid.nPointsJ; j++) {
-            int ind = grid.IND(i, j);
-            output << default_if_nan(pf.u(grid.values(ind))) << " "
-                   << default_if_nan(pf.v(grid.values(ind))) << " 0"
-                   << std::endl;
+    bool has_u = selection.has_field("u");
+    bool has_v = selection.has_field("v");
+    if (has_u || has_v) {
+        output << "VECTORS Velocity float" << std::endl;
+        for (int i = range.i_begin; i < range.i_end; i += range.stride) {
+            for (int j = range.j_begin; j < range.j_end; j += range.stride) {
+                int ind = grid.IND(i, j);
+                output << (has_u ? default_if_nan(pf.u(grid.values(ind))) : 0.0)
+                       << " "
+                       << (has_v ? default_if_nan(pf.v(grid.values(ind))) : 0.0)
+                       << " 0" << std::endl;
+            }
         }
     }
 
@@ -3,11 +3,12 @@
 
 #include "../../grid/cartesian_grid.hpp"
 #include "../../utils/point_functions.hpp"
+#include "output_selection.hpp"
 #include <iomanip>
 #include <iostream>
 #include <string>
 
-void vtk_writer(
-    CartesianGrid& grid, std::string& file_name, PointFunctions& pf);
+void vtk_writer(CartesianGrid& grid, std::string& file_name,
+    PointFunctions& pf, const OutputSelection& selection);
 
 #endif /* VTK_WRITER_HPP */
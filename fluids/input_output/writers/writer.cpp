@@ -1,9 +1,30 @@
 #include "writer.hpp"
 
-Writer::Writer(Options& opt)
-    : base_name(opt.output_file_name())
+Writer::Writer(Options& opt, const std::string& name_suffix)
+    : Writer(opt, opt.output_file_name() + name_suffix, opt.output_counter(),
+          OutputSelection(
+              opt.output_fields(), opt.output_box(), opt.output_stride()))
+{
+}
+
+Writer::Writer(Options& opt, const std::string& base_name_in, int counter_in,
+    const OutputSelection& selection_in)
+    : base_name(base_name_in)
     , output_type(opt.output_type())
-    , counter(opt.output_counter())
+    , counter(counter_in)
     , pf(PointFunctions(opt.mach(), opt.gam()))
+    , selection(selection_in)
 {
+    if (output_type == "HDF5") {
+        hdf5 = std::make_shared<Hdf5Writer>(base_name,
+            opt.hdf5_snapshots_per_file(), opt.hdf5_chunk_size(),
+            opt.hdf5_compression_level(), pf, selection);
+    }
+    else if (output_type == "COMPRESSED") {
+        bool relative = opt.compression_error_type() == "REL";
+        compressed = std::make_shared<CompressedWriter>(pf, selection,
+            FieldBound{opt.compression_error_bound(), relative},
+            parse_field_bounds(opt.compression_field_bounds(), relative),
+            opt.compression_level(), opt.compression_validate());
+    }
 }
@@ -4,17 +4,30 @@
 #include "../../grid/cartesian_grid.hpp"
 #include "../../utils/point_functions.hpp"
 #include "../options.hpp"
+#include "compressed_writer.hpp"
 #include "default_writer.hpp"
+#include "hdf5_writer.hpp"
+#include "output_selection.hpp"
 #include "vtk_writer.hpp"
 #include <iostream>
+#include <memory>
 #include <string>
 
 class Writer {
 public:
-    Writer(Options& opt);
+    /**
+     * @brief Main output stream, written to OUTPUT_FILE_NAME + name_suffix
+     */
+    Writer(Options& opt, const std::string& name_suffix = "");
+    Writer(Options& opt, const std::string& base_name_in, int counter_in,
+        const OutputSelection& selection_in);
     template <typename Grid>
     void write(Grid& grid, const double& t)
     {
+        if (output_type == "NONE") {
+            counter++;
+            return;
+        }
         std::cout << std::endl
                   << "On write " << counter << "; t=" << t << std::endl;
         std::string number = std::to_string(counter);
@@ -23,10 +36,16 @@ public:
         auto file_name = base_name + "_" + padded_number;
 
         if (output_type == "DEFAULT") {
-            default_writer(grid, file_name, pf);
+            default_writer(grid, file_name, pf, selection);
         }
         else if (output_type == "VTK") {
-            vtk_writer(grid, file_name, pf);
+            vtk_writer(grid, file_name, pf, selection);
+        }
+        else if (output_type == "HDF5") {
+            hdf5->write(grid, t, counter);
+        }
+        else if (output_type == "COMPRESSED") {
+            compressed->write(grid, file_name + ".tfz", t);
         }
         else {
             std::cerr << "Output type '" << output_type << "' is not supported"
@@ -35,11 +54,30 @@ public:
         counter++;
     }
 
+    /**
+     * @return Whether some point of grid is selected for output
+     */
+    bool selects_points(const CartesianGrid& grid) const
+    {
+        return selection.range(grid).nTotal() > 0;
+    }
+
+    /**
+     * @brief Counts an output written elsewhere (by another process)
+     */
+    void skip() { counter++; }
+
+    int output_counter() const { return counter; }
+    void set_output_counter(int counter_in) { counter = counter_in; }
+
 private:
     std::string base_name;
     std::string output_type;
     int counter;
     PointFunctions pf;
+    OutputSelection selection;
+    std::shared_ptr<Hdf5Writer> hdf5;
+    std::shared_ptr<CompressedWriter> compressed;
 };
 
 #endif /* WRITER_HPP */
@@ -1,11 +1,43 @@
 #include "input_output/options.hpp"
+#include "time_integrators/benchmark_runner.hpp"
+#include "time_integrators/ensemble.hpp"
+#include "time_integrators/precision_check.hpp"
 #include "time_integrators/solver.hpp"
+#include "utils/parallel/communicator.hpp"
 #include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
 
-int main() {
-  std::ifstream config_file("./solver.cfg");
-  Options opt(config_file);
+int main(int argc, char** argv) {
+  parallel::Environment environment;
+  std::string config_path = argc > 1 ? argv[1] : "./solver.cfg";
+  std::ifstream config_file(config_path);
+  if (!config_file.is_open()) {
+    std::cerr << "Could not open file " << config_path << std::endl;
+    return 1;
+  }
+  std::stringstream config;
+  config << config_file.rdbuf();
+  Options opt(config);
+
+  if (opt.benchmark()) {
+    BenchmarkRunner runner(opt);
+    runner.run();
+    return 0;
+  }
+
+  if (opt.precision_check()) {
+    PrecisionCheck check(config.str());
+    check.run();
+    return 0;
+  }
+
+  if (opt.ensemble()) {
+    Ensemble ensemble(config.str());
+    ensemble.run();
+    return 0;
+  }
 
   Solver solver(opt);
   solver.run();
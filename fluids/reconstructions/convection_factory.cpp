@@ -12,7 +12,8 @@
 #include "weno_convection.hpp"
 
 std::shared_ptr<Convection> create_convection(Options& opt, PointFunctions& pf,
-    std::shared_ptr<Derivatives> der, std::string overwrite_conv)
+    const SolverContext& context, std::shared_ptr<Derivatives> der,
+    std::string overwrite_conv)
 {
     if (overwrite_conv == "NONE") {
         overwrite_conv = opt.convection();
@@ -24,23 +25,24 @@ std::shared_ptr<Convection> create_convection(Options& opt, PointFunctions& pf,
         return std::make_shared<SkewSymmetric>(pf, der);
     }
     if (overwrite_conv == "SPLIT_CONVECTION") {
-        return std::make_shared<SplitConvection>(pf, der, create_flux(opt, pf));
+        return std::make_shared<SplitConvection>(
+            pf, der, create_flux(opt, pf, context));
     }
     if (overwrite_conv == "SIMPLE_FLUX") {
         return std::make_shared<SimpleFluxConvection>(
-            pf, der, create_flux(opt, pf));
+            pf, der, create_flux(opt, pf, context));
     }
     if (overwrite_conv == "WENO_CONVECTION") {
-        auto bkp_conv
-            = std::make_shared<SplitConvection>(pf, der, create_flux(opt, pf));
+        auto bkp_conv = std::make_shared<SplitConvection>(
+            pf, der, create_flux(opt, pf, context));
         return std::make_shared<WenoConvection>(
-            pf, create_flux(opt, pf), bkp_conv);
+            pf, create_flux(opt, pf, context), bkp_conv);
     }
     if (overwrite_conv == "MIX_CONVECTION") {
-        auto main_conv
-            = create_convection(opt, pf, der, opt.mix_convection_main());
-        auto aux_conv
-            = create_convection(opt, pf, der, opt.mix_convection_aux());
+        auto main_conv = create_convection(
+            opt, pf, context, der, opt.mix_convection_main());
+        auto aux_conv = create_convection(
+            opt, pf, context, der, opt.mix_convection_aux());
         return std::make_shared<MixConvection>(
             pf, der, main_conv, aux_conv, opt.mix_param());
     }
@@ -7,8 +7,10 @@ class Convection;
 class Derivatives;
 class Options;
 struct PointFunctions;
+struct SolverContext;
 
 std::shared_ptr<Convection> create_convection(Options& opt, PointFunctions& pf,
-    std::shared_ptr<Derivatives> der, std::string overwrite_conv = "NONE");
+    const SolverContext& context, std::shared_ptr<Derivatives> der,
+    std::string overwrite_conv = "NONE");
 
 #endif /* CONVECTION_FACTORY_HPP */
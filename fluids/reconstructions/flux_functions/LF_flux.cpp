@@ -1,9 +1,11 @@
 #include "LF_flux.hpp"
-#include "../../utils/global_vars.hpp"
 #include "../../utils/operators_overloads.hpp"
+#include "../../utils/solver_context.hpp"
 
-LaxFriedrichsFlux::LaxFriedrichsFlux(PointFunctions& pf_in, Options& opt_in)
+LaxFriedrichsFlux::LaxFriedrichsFlux(
+    PointFunctions& pf_in, Options& opt_in, const SolverContext& context_in)
     : FluxInterface(pf_in, opt_in)
+    , context(context_in)
 {
 }
 
@@ -15,12 +17,12 @@ Flux LaxFriedrichsFlux::fluxX(const Point& p) const
 
 Flux LaxFriedrichsFlux::fluxXPositive(const Point& p) const
 {
-    return 0.5 * (this->fluxX(p) + max_u_plus_c * p);
+    return 0.5 * (this->fluxX(p) + context.max_u_plus_c * p);
 }
 
 Flux LaxFriedrichsFlux::fluxXNegative(const Point& p) const
 {
-    return 0.5 * (this->fluxX(p) + (-1) * max_u_plus_c * p);
+    return 0.5 * (this->fluxX(p) + (-1) * context.max_u_plus_c * p);
 }
 
 Flux LaxFriedrichsFlux::fluxY(const Point& p) const
@@ -31,9 +33,9 @@ Flux LaxFriedrichsFlux::fluxY(const Point& p) const
 
 Flux LaxFriedrichsFlux::fluxYPositive(const Point& p) const
 {
-    return 0.5 * (this->fluxY(p) + max_v_plus_c * p);
+    return 0.5 * (this->fluxY(p) + context.max_v_plus_c * p);
 }
 Flux LaxFriedrichsFlux::fluxYNegative(const Point& p) const
 {
-    return 0.5 * (this->fluxY(p) + (-1) * max_v_plus_c * p);
+    return 0.5 * (this->fluxY(p) + (-1) * context.max_v_plus_c * p);
 }
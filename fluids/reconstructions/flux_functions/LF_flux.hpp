@@ -3,9 +3,16 @@
 
 #include "flux_interface.hpp"
 
+struct SolverContext;
+
+/**
+ * \class LaxFriedrichsFlux
+ * @brief Splits the fluxes with the largest wave speeds of the run
+ */
 class LaxFriedrichsFlux : public FluxInterface {
 public:
-    LaxFriedrichsFlux(PointFunctions& pf_in, Options& opt_in);
+    LaxFriedrichsFlux(PointFunctions& pf_in, Options& opt_in,
+        const SolverContext& context_in);
     Flux fluxX(const Point& p) const override;
     Flux fluxXPositive(const Point& p) const override;
     Flux fluxXNegative(const Point& p) const override;
@@ -13,6 +20,9 @@ public:
     Flux fluxY(const Point& p) const override;
     Flux fluxYPositive(const Point& p) const override;
     Flux fluxYNegative(const Point& p) const override;
+
+private:
+    const SolverContext& context;
 };
 
 #endif /* LF_FLUX_HPP */
@@ -7,8 +7,8 @@
 #include "steger_warming_flux.hpp"
 #include <iostream>
 
-std::shared_ptr<FluxInterface> create_flux(
-    Options& opt, PointFunctions& pf, std::string flux_type_override)
+std::shared_ptr<FluxInterface> create_flux(Options& opt, PointFunctions& pf,
+    const SolverContext& context, std::string flux_type_override)
 {
     if (flux_type_override == "NONE") { // NO_OVERRIDE
         flux_type_override = opt.flux();
@@ -20,7 +20,7 @@ std::shared_ptr<FluxInterface> create_flux(
         return std::make_shared<StegerWarmingFlux>(pf, opt);
     }
     if (flux_type_override == "LF_FLUX") {
-        return std::make_shared<LaxFriedrichsFlux>(pf, opt);
+        return std::make_shared<LaxFriedrichsFlux>(pf, opt, context);
     }
     std::cerr << "Flux type " << flux_type_override
               << " not found! Using SIMPLE instead" << std::endl;
@@ -10,7 +10,9 @@
 #include <memory>
 #include <string>
 
-std::shared_ptr<FluxInterface> create_flux(
-    Options& opt, PointFunctions& pf, std::string flux_type_override = "NONE");
+struct SolverContext;
+
+std::shared_ptr<FluxInterface> create_flux(Options& opt, PointFunctions& pf,
+    const SolverContext& context, std::string flux_type_override = "NONE");
 
 #endif /* FLUX_FACTORY_HPP */
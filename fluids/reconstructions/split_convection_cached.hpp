@@ -2,6 +2,8 @@
 #define SPLIT_CONVECTION_CACHED_HPP
 
 #include "abstract_convection.hpp"
+#include "../utils/flux_def.hpp"
+#include "../utils/memory/grid_allocator.hpp"
 #include <memory>
 #include <vector>
 
@@ -18,10 +20,10 @@ public:
 
 private:
     std::shared_ptr<FluxInterface> flux;
-    std::vector<Flux> fluxXPos;
-    std::vector<Flux> fluxXNeg;
-    std::vector<Flux> fluxYPos;
-    std::vector<Flux> fluxYNeg;
+    memory::GridArray<StoredFlux> fluxXPos;
+    memory::GridArray<StoredFlux> fluxXNeg;
+    memory::GridArray<StoredFlux> fluxYPos;
+    memory::GridArray<StoredFlux> fluxYNeg;
 };
 
 #endif /* SPLIT_CONVECTION_CACHED_HPP */
@@ -1,12 +1,12 @@
 #ifndef WENO_CONVECTION_HPP
 #define WENO_CONVECTION_HPP
 
+#include "../utils/point_def.hpp"
 #include "abstract_convection.hpp"
 #include <memory>
 #include <array>
 
 class FluxInterface;
-struct Point;
 
 class WenoConvection : public Convection {
 public:
@@ -0,0 +1,319 @@
+#ifndef ADAPTIVE_RUNGE_KUTTA_INTEGRATOR_HPP
+#define ADAPTIVE_RUNGE_KUTTA_INTEGRATOR_HPP
+
+#include "../grid/ghias_shock_grid.hpp"
+#include "../grid/shock_grid.hpp"
+#include "../utils/filters/minimal_filter.hpp"
+#include "../utils/filters/minimal_filter_factory.hpp"
+#include "../utils/operators_overloads.hpp"
+#include "time_integrator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * \class AdaptiveRungeKuttaIntegrator
+ * @brief Bogacki-Shampine 3(2) embedded pair with error control
+ *
+ * The third order solution is advanced and the difference to the embedded
+ * second order one estimates the local error, measured in the RMS norm
+ * scaled by ADAPTIVE_ATOL + ADAPTIVE_RTOL |U| over the fluid points. A PI
+ * controller proposes the next step from the last two errors, and the step
+ * taken is the smallest of that proposal and the CFL-limited step of
+ * get_dt. Steps whose error is above 1 (or that produce NaN) are rejected:
+ * the grid, including the shock positions moved by
+ * grid_specific_pre_update, is restored and the step is retried with a
+ * smaller dt, up to ADAPTIVE_MAX_REJECTIONS times in a row. A run stopped
+ * by rejections ends at the last accepted state.
+ *
+ * The last stage is evaluated at the new solution, so when nothing changes
+ * the grid between steps (no filter, no moving shocks) it is reused as the
+ * first stage of the next step, and a step costs three evaluations of the
+ * time derivative.
+ */
+template <typename Grid, typename Variation>
+class AdaptiveRungeKuttaIntegrator : private TimeIntegrator<Grid> {
+public:
+    AdaptiveRungeKuttaIntegrator(Options& opt_in, Grid& grid_in,
+        std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in,
+        SolverContext& context_in);
+    void run();
+    long steps() const { return step; }
+    long rejections() const { return rejected; }
+    /**
+     * @brief Last step tried, accepted or not
+     */
+    double step_size() const { return dt; }
+    /**
+     * @brief Step the controller proposes for the next step
+     */
+    double proposed_step_size() const { return proposed_dt; }
+
+private:
+    typedef TimeIntegrator<Grid> Base;
+    using Base::final_time;
+    using Base::found_nan;
+    using Base::grid;
+    using Base::max_steps;
+    using Base::output;
+    using Base::step_log;
+    using Base::steady;
+    using Base::tool;
+
+    Grid aux_grid;
+    const bool should_filter;
+    std::shared_ptr<MinimalFilter> minimal_filter;
+    const double rtol;
+    const double atol;
+    const int max_rejections;
+    /**
+     * Whether the grid changes at the start of a step, so it must be saved
+     * to reject a step and the last stage cannot be reused
+     */
+    const bool changes_before_stages;
+    std::vector<Point> next_values;
+    double dt;
+    double proposed_dt;
+    long step;
+    long rejected;
+
+    double error_norm(const Variation& k1, const Variation& k2,
+        const Variation& k3, const Variation& k4, double dt) const;
+};
+
+template <typename Grid, typename Variation>
+AdaptiveRungeKuttaIntegrator<Grid, Variation>::AdaptiveRungeKuttaIntegrator(
+    Options& opt_in, Grid& grid_in,
+    std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in,
+    SolverContext& context_in)
+    : Base(opt_in, grid_in, std::move(tool_in), pf_in, context_in)
+    , aux_grid(opt_in)
+    , should_filter(opt_in.should_filter())
+    , minimal_filter(create_minimal_filter(opt_in.filter_order()))
+    , rtol(opt_in.adaptive_rtol())
+    , atol(opt_in.adaptive_atol())
+    , max_rejections(opt_in.adaptive_max_rejections())
+    , changes_before_stages(should_filter
+          or std::is_base_of<ShockGrid, Grid>::value
+          or std::is_base_of<GhiasShockGrid, Grid>::value)
+    , next_values(grid.nPointsTotal)
+    , dt(0.0)
+    , proposed_dt(0.0)
+    , step(0)
+    , rejected(0)
+{
+}
+
+template <typename Grid, typename Variation>
+void AdaptiveRungeKuttaIntegrator<Grid, Variation>::run()
+{
+    // PI controller exponents for an embedded method of order 2
+    const double alpha = 0.7 / 3;
+    const double beta = 0.4 / 3;
+    const double safety = 0.9;
+    int n = grid.nPointsTotal;
+    double previous_error = 1.0;
+    bool k1_ready = false;
+    Variation k1(n), k2(n), k3(n), k4(n);
+    double start_time = Base::start_run(step);
+    // Time the last accepted step reached, which labels the final output
+    double end_time = start_time;
+    std::stringstream saved_grid;
+    auto& timers = PhaseTimers::instance();
+    for (double t = start_time; t < final_time; t += dt) {
+        if (max_steps > 0 and step >= max_steps) {
+            break;
+        }
+        timers.begin_step();
+        double stable_dt;
+        {
+            ScopedPhaseTimer timer(TimerPhase::GetDt);
+            stable_dt = Base::get_dt(grid);
+        }
+        if (found_nan) {
+            break;
+        }
+        if (proposed_dt <= 0.0) {
+            proposed_dt = stable_dt;
+        }
+        if (changes_before_stages) {
+            saved_grid.str("");
+            grid.save_state(saved_grid);
+        }
+        double error;
+        int rejections = 0;
+        while (true) {
+            dt = std::min(proposed_dt, stable_dt);
+            double next_print = output.next_output_time();
+            if (t + dt >= next_print) {
+                dt = next_print - t;
+            }
+            Base::print_progress(step, t, dt);
+            {
+                ScopedPhaseTimer timer(TimerPhase::PreUpdate);
+                grid.grid_specific_pre_update(dt);
+            }
+            if (should_filter) {
+                ScopedPhaseTimer timer(TimerPhase::Filter);
+                minimal_filter->filter_grid(&grid);
+            }
+            {
+                ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+                aux_grid.update_values(&grid);
+            }
+            if (!k1_ready) {
+                k1.compute_norms = steady.enabled() or step_log->due(step);
+                tool->time_derivative(k1, grid, t);
+                k1_ready = !changes_before_stages;
+            }
+            {
+                ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+                for (int ind = 0; ind < n; ind++) {
+                    aux_grid.set_values(
+                        grid.values(ind) + (dt / 2) * k1.grid_variation[ind],
+                        ind);
+                }
+            }
+            tool->update_values(&aux_grid, t + dt / 2);
+            tool->time_derivative(k2, aux_grid, t + dt / 2);
+            {
+                ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+                for (int ind = 0; ind < n; ind++) {
+                    aux_grid.set_values(grid.values(ind)
+                            + (3 * dt / 4) * k2.grid_variation[ind],
+                        ind);
+                }
+            }
+            tool->update_values(&aux_grid, t + 3 * dt / 4);
+            tool->time_derivative(k3, aux_grid, t + 3 * dt / 4);
+            {
+                ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+                for (int ind = 0; ind < n; ind++) {
+                    next_values[ind] = grid.values(ind)
+                        + (2 * dt / 9) * k1.grid_variation[ind]
+                        + (dt / 3) * k2.grid_variation[ind]
+                        + (4 * dt / 9) * k3.grid_variation[ind];
+                    aux_grid.set_values(next_values[ind], ind);
+                }
+            }
+            tool->update_values(&aux_grid, t + dt);
+            k4.compute_norms = steady.enabled() or step_log->due(step + 1);
+            tool->time_derivative(k4, aux_grid, t + dt);
+            error = error_norm(k1, k2, k3, k4, dt);
+            if (error <= 1.0) {
+                break;
+            }
+            // Rejected: restore the grid and retry with a smaller step
+            rejected++;
+            if (changes_before_stages) {
+                saved_grid.clear();
+                saved_grid.seekg(0);
+                grid.load_state(saved_grid);
+            }
+            if (++rejections > max_rejections) {
+                break;
+            }
+            proposed_dt = dt
+                * std::max(0.2, safety * std::pow(error, -1 / 3.));
+        }
+        if (error > 1.0) {
+            std::cout << std::endl
+                      << "Step rejected " << max_rejections
+                      << " times at t=" << t << ", stopping" << std::endl;
+            break;
+        }
+        Base::log_step(step, t, dt, k1.norms);
+        auto norms = k1.norms;
+        {
+            ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+            for (int ind = 0; ind < n; ind++) {
+                grid.set_values(next_values[ind], ind);
+            }
+        }
+        Base::end_step(t, dt, step);
+        end_time = t + dt;
+        // PI controller
+        error = std::max(error, 1e-10);
+        double factor = safety * std::pow(error, -alpha)
+            * std::pow(previous_error, beta);
+        proposed_dt = dt * std::min(5.0, std::max(0.2, factor));
+        previous_error = error;
+        if (k1_ready) {
+            std::swap(k1, k4);
+        }
+        if (Base::steady_state_reached(norms, t + dt, step)) {
+            break;
+        }
+    }
+    Base::finish_run(std::min(end_time, final_time));
+    std::cout << std::endl
+              << step << " steps accepted, " << rejected << " rejected"
+              << std::endl;
+    std::cout << "Exit adaptive runge" << std::endl;
+}
+
+/**
+ * @brief Scaled RMS norm of the difference between the third and second
+ * order solutions, infinite if the step produced NaN
+ */
+template <typename Grid, typename Variation>
+double AdaptiveRungeKuttaIntegrator<Grid, Variation>::error_norm(
+    const Variation& k1, const Variation& k2, const Variation& k3,
+    const Variation& k4, double dt) const
+{
+    double sum = 0.0;
+    int count = 0;
+    int n = grid.nPointsTotal;
+#ifndef DEBUG
+#pragma omp parallel for reduction(+ : sum, count)
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        if (!grid.ind_is_valid(ind)) {
+            continue;
+        }
+        auto& old_p = grid.values(ind);
+        auto& new_p = next_values[ind];
+        auto& a = k1.grid_variation[ind];
+        auto& b = k2.grid_variation[ind];
+        auto& c = k3.grid_variation[ind];
+        auto& d = k4.grid_variation[ind];
+        auto term = [&](double e1, double e2, double e3, double e4,
+                        double y_old, double y_new) {
+            double err = dt
+                * (-5 / 72. * e1 + 1 / 12. * e2 + 1 / 9. * e3 - 1 / 8. * e4);
+            double scale
+                = atol + rtol * std::max(std::fabs(y_old), std::fabs(y_new));
+            return err * err / (scale * scale);
+        };
+        sum += term(a.rho, b.rho, c.rho, d.rho, old_p.rho(), new_p.rho());
+        sum += term(a.ru, b.ru, c.ru, d.ru, old_p.ru(), new_p.ru());
+        sum += term(a.rv, b.rv, c.rv, d.rv, old_p.rv(), new_p.rv());
+        sum += term(a.e, b.e, c.e, d.e, old_p.e(), new_p.e());
+        count += 4;
+    }
+    if (count == 0) {
+        return 0.0;
+    }
+    double error = std::sqrt(sum / count);
+    return error == error ? error : std::numeric_limits<double>::infinity();
+}
+
+#endif /* ADAPTIVE_RUNGE_KUTTA_INTEGRATOR_HPP */
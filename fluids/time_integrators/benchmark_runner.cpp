@@ -0,0 +1,241 @@
+#include "benchmark_runner.hpp"
+#include "../input_output/cases/canonical_cases.hpp"
+#include "../input_output/options.hpp"
+#include "../utils/timers/phase_timers.hpp"
+#include "omp.h"
+#include "solver.hpp"
+#include <cerrno>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+
+namespace {
+std::string bool_string(bool value) { return value ? "TRUE" : "FALSE"; }
+
+void make_directory(const std::string& path)
+{
+    if (mkdir(path.c_str(), 0755) != 0 and errno != EEXIST) {
+        std::cerr << "Could not create directory " << path << std::endl;
+        throw(-1);
+    }
+}
+
+/**
+ * @brief Resets the resident set high-water mark of the process (Linux only,
+ * ignored elsewhere)
+ */
+void reset_peak_memory()
+{
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs.is_open()) {
+        clear_refs << "5";
+    }
+}
+
+/**
+ * @return VmHWM in kB, or -1 if unavailable
+ */
+long peak_memory_kb()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            return std::stol(line.substr(6));
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Silences std::cout while in scope
+ */
+class QuietOutput {
+public:
+    QuietOutput()
+        : previous(std::cout.rdbuf(sink.rdbuf()))
+    {
+    }
+    ~QuietOutput() { std::cout.rdbuf(previous); }
+
+private:
+    std::ostringstream sink;
+    std::streambuf* previous;
+};
+} // namespace
+
+BenchmarkRunner::BenchmarkRunner(Options& opt_in)
+    : opt(opt_in)
+{
+}
+
+std::vector<int> BenchmarkRunner::thread_counts()
+{
+    std::vector<int> counts;
+    auto requested = opt.benchmark_threads();
+    if (requested.size() == 1 and requested[0] == "ALL") {
+        int max_threads = 1;
+#ifndef DEBUG
+        max_threads = omp_get_num_procs();
+#endif
+        for (int threads = 1; threads < max_threads; threads *= 2) {
+            counts.push_back(threads);
+        }
+        counts.push_back(max_threads);
+        return counts;
+    }
+    for (auto& threads : requested) {
+        counts.push_back(std::stoi(threads));
+    }
+    return counts;
+}
+
+std::string BenchmarkRunner::scheme_options()
+{
+    std::ostringstream os;
+    os.precision(17);
+    os << "CFL = " << opt.cfl() << "\n"
+       << "PRANDTL = " << opt.prandtl() << "\n"
+       << "MIX_PARAM = " << opt.mix_param() << "\n"
+       << "FLUX = " << opt.flux() << "\n"
+       << "CONVECTION = " << opt.convection() << "\n"
+       << "MIX_CONVECTION_MAIN = " << opt.mix_convection_main() << "\n"
+       << "MIX_CONVECTION_AUX = " << opt.mix_convection_aux() << "\n"
+       << "DISSIPATION = " << opt.dissipation() << "\n"
+       << "DERIVATIVE_ORDER = " << opt.derivative_order() << "\n"
+       << "LUISA_DETECTOR = " << opt.luisa_detector() << "\n"
+       << "DETECTOR_SENSITIVITY = " << opt.detector_sensitivity() << "\n"
+       << "SHOULD_FILTER = " << bool_string(opt.should_filter()) << "\n"
+       << "FILTER_ORDER = " << opt.filter_order() << "\n";
+    return os.str();
+}
+
+BenchmarkResult BenchmarkRunner::run_case(const std::string& case_name,
+    const std::string& solver_type, int n, int threads)
+{
+    auto directory = opt.output_base_path() + "benchmark/" + case_name + "_"
+        + solver_type + "_" + std::to_string(n) + "/";
+    make_directory(directory);
+    auto input = create_canonical_case(case_name, n, solver_type);
+
+    std::ostringstream config;
+    config << write_case_input(input, directory) << scheme_options()
+           << "MAX_STEPS = " << opt.benchmark_steps() << "\n"
+           << "T_MAX = 1e10\n"
+           << "PRINT_INTERVAL = 1e10\n"
+           << "OUTPUT_TYPE = NONE\n"
+           << "OUTPUT_BASE_PATH = " << directory << "\n"
+           << "TIMING = TRUE\n"
+           << "OMP_THREADS = " << threads << "\n";
+    std::istringstream config_stream(config.str());
+    Options run_opt(config_stream);
+
+    reset_peak_memory();
+    {
+        QuietOutput quiet;
+        Solver solver(run_opt);
+        solver.run();
+    }
+
+    auto& timers = PhaseTimers::instance();
+    BenchmarkResult result{};
+    result.case_name = case_name;
+    result.solver_type = solver_type;
+    result.n = n;
+    result.threads = threads;
+    result.steps = timers.steps();
+    result.seconds = timers.run_time();
+    result.mpoints = timers.points_per_second() * 1e-6;
+    result.efficiency = 1.0;
+    result.peak_memory_kb = peak_memory_kb();
+    if (result.steps < opt.benchmark_steps()) {
+        std::cerr << "Benchmark " << case_name << " " << solver_type << " " << n
+                  << " stopped after " << result.steps << " steps"
+                  << std::endl;
+    }
+    return result;
+}
+
+void BenchmarkRunner::run()
+{
+    make_directory(opt.output_base_path());
+    make_directory(opt.output_base_path() + "benchmark/");
+    auto threads = thread_counts();
+    print_header(std::cout);
+
+    std::vector<BenchmarkResult> results;
+    for (auto& case_name : opt.benchmark_cases()) {
+        for (auto& size : opt.benchmark_sizes()) {
+            int n = std::stoi(size);
+            for (auto& solver_type : opt.benchmark_solvers()) {
+                if (!case_supports_solver(case_name, solver_type)) {
+                    continue;
+                }
+                double base_rate = 0.0;
+                for (auto t : threads) {
+                    auto result = run_case(case_name, solver_type, n, t);
+                    if (t == threads.front()) {
+                        base_rate = result.mpoints / t;
+                    }
+                    result.efficiency = (base_rate > 0.0)
+                        ? result.mpoints / (base_rate * t)
+                        : 0.0;
+                    print_row(std::cout, result);
+                    results.push_back(result);
+                }
+            }
+        }
+    }
+
+    auto report = opt.benchmark_report();
+    if (report == "NONE") {
+        return;
+    }
+    std::ofstream output(report);
+    if (!output.is_open()) {
+        std::cerr << "Could not open file " << report << std::endl;
+        return;
+    }
+    write_csv(output, results);
+}
+
+void BenchmarkRunner::print_header(std::ostream& os)
+{
+    os << std::left << std::setw(12) << "case" << std::setw(13) << "solver"
+       << std::right << std::setw(6) << "n" << std::setw(9) << "threads"
+       << std::setw(7) << "steps" << std::setw(11) << "time(s)"
+       << std::setw(11) << "Mpts/s" << std::setw(8) << "eff"
+       << std::setw(12) << "peak(MB)" << std::endl;
+}
+
+void BenchmarkRunner::print_row(std::ostream& os, const BenchmarkResult& r)
+{
+    auto flags = os.flags();
+    auto precision = os.precision();
+    os << std::left << std::setw(12) << r.case_name << std::setw(13)
+       << r.solver_type << std::right << std::setw(6) << r.n << std::setw(9)
+       << r.threads << std::setw(7) << r.steps << std::fixed
+       << std::setprecision(4) << std::setw(11) << r.seconds
+       << std::setprecision(2) << std::setw(11) << r.mpoints << std::setw(8)
+       << r.efficiency << std::setprecision(1) << std::setw(12)
+       << r.peak_memory_kb / 1024.0 << std::endl;
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void BenchmarkRunner::write_csv(
+    std::ostream& os, const std::vector<BenchmarkResult>& results)
+{
+    os << "case,solver,n,threads,steps,seconds,mpoint_updates_per_second,"
+          "parallel_efficiency,peak_memory_kb"
+       << std::endl;
+    os.precision(9);
+    for (auto& r : results) {
+        os << r.case_name << "," << r.solver_type << "," << r.n << ","
+           << r.threads << "," << r.steps << "," << r.seconds << ","
+           << r.mpoints << "," << r.efficiency << "," << r.peak_memory_kb
+           << std::endl;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef BENCHMARK_RUNNER_HPP
+#define BENCHMARK_RUNNER_HPP
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class Options;
+
+/**
+ * @brief Measurements of one benchmark run
+ */
+struct BenchmarkResult {
+    std::string case_name;
+    std::string solver_type;
+    int n;
+    int threads;
+    long steps;
+    double seconds;      ///< Time spent inside the time steps
+    double mpoints;      ///< Million point updates per second
+    double efficiency;   ///< Parallel efficiency against the fewest threads
+    long peak_memory_kb; ///< Resident set high-water mark during the run
+};
+
+/**
+ * \class BenchmarkRunner
+ * @brief Runs the canonical cases end to end (BENCHMARK = TRUE)
+ *
+ * Every combination of BENCHMARK_CASES, BENCHMARK_SIZES, BENCHMARK_SOLVERS
+ * and BENCHMARK_THREADS is generated under OUTPUT_BASE_PATH/benchmark/ and
+ * run through Solver for BENCHMARK_STEPS Runge-Kutta steps, without output.
+ * The numerical scheme options (CFL, FLUX, CONVECTION, ...) are taken from
+ * the configuration. Results are printed as they come and, if
+ * BENCHMARK_REPORT is not NONE, written to that file as CSV.
+ */
+class BenchmarkRunner {
+public:
+    BenchmarkRunner(Options& opt_in);
+    void run();
+
+    static void print_header(std::ostream& os);
+    static void print_row(std::ostream& os, const BenchmarkResult& result);
+    static void write_csv(
+        std::ostream& os, const std::vector<BenchmarkResult>& results);
+
+private:
+    Options& opt;
+
+    std::vector<int> thread_counts();
+    std::string scheme_options();
+    BenchmarkResult run_case(const std::string& case_name,
+        const std::string& solver_type, int n, int threads);
+};
+
+#endif /* BENCHMARK_RUNNER_HPP */
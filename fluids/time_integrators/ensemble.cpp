@@ -0,0 +1,150 @@
+#include "ensemble.hpp"
+#include "../input_output/options.hpp"
+#include "../input_output/readers/default_reader.hpp"
+#include "../utils/grid_components_container_def.hpp"
+#include "../utils/grid_constants_container_def.hpp"
+#include "../utils/parallel/communicator.hpp"
+#include "../utils/timers/phase_timers.hpp"
+#include "omp.h"
+#include "solver.hpp"
+#include <cerrno>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <utility>
+
+namespace {
+void make_directory(const std::string& path)
+{
+    if (mkdir(path.c_str(), 0755) != 0 and errno != EEXIST) {
+        std::cerr << "Could not create directory " << path << std::endl;
+        throw(-1);
+    }
+}
+} // namespace
+
+Ensemble::Ensemble(std::string config_in)
+    : config(std::move(config_in))
+{
+}
+
+std::vector<EnsembleMember> Ensemble::members(
+    const std::vector<std::string>& machs,
+    const std::vector<std::string>& reynolds)
+{
+    std::vector<EnsembleMember> result;
+    for (auto& mach : machs) {
+        for (auto& re : reynolds) {
+            EnsembleMember member{};
+            member.name = "M" + mach + "_Re" + re;
+            member.mach = mach;
+            member.reynolds = re;
+            result.push_back(member);
+        }
+    }
+    return result;
+}
+
+std::vector<EnsembleMember> Ensemble::run()
+{
+    if (parallel::size() > 1) {
+        std::cerr << "ENSEMBLE runs on a single process" << std::endl;
+        throw(-1);
+    }
+    std::istringstream config_stream(config);
+    Options opt(config_stream);
+    auto sweep = members(opt.ensemble_mach(), opt.ensemble_reynolds());
+    int concurrency = opt.ensemble_concurrency();
+    // The HDF5 library serializes nothing unless built thread safe
+    if (opt.output_type() == "HDF5" and concurrency != 1) {
+        std::cerr << "HDF5 output needs ENSEMBLE_CONCURRENCY = 1" << std::endl;
+        throw(-1);
+    }
+    if (opt.input_type() == "DEFAULT") {
+        // MACH and REYNOLDS leave the case files as read, so every member
+        // starts from the same memory input
+        GridConstantsContainer constants;
+        GridComponentsContainer components;
+        default_reader(opt, components, constants);
+        opt.set_memory_input(std::move(constants), std::move(components));
+    }
+    auto base = opt.output_base_path() + "ensemble/";
+    make_directory(opt.output_base_path());
+    make_directory(base);
+
+    Solver::configure_process(opt);
+    // Members write to none of the process wide state, as long as the
+    // timers are off
+    PhaseTimers::instance().set_enabled(false);
+#ifndef DEBUG
+    if (concurrency <= 0) {
+        concurrency = omp_get_max_threads();
+    }
+    omp_set_max_active_levels(1);
+#pragma omp parallel for schedule(dynamic, 1) num_threads(concurrency)
+#endif
+    for (size_t m = 0; m < sweep.size(); m++) {
+        run_member(sweep[m], opt, base);
+    }
+    print_report(std::cout, sweep);
+    return sweep;
+}
+
+void Ensemble::run_member(
+    EnsembleMember& member, const Options& input, const std::string& base)
+{
+    auto directory = base + member.name + "/";
+    std::ostringstream overrides;
+    overrides << "\nENSEMBLE = FALSE\n"
+              << "TIMING = FALSE\n"
+              << "OUTPUT_BASE_PATH = " << directory << "\n";
+    if (member.mach != "NONE") {
+        overrides << "MACH = " << member.mach << "\n";
+    }
+    if (member.reynolds != "NONE") {
+        overrides << "REYNOLDS = " << member.reynolds << "\n";
+    }
+    auto start = std::chrono::steady_clock::now();
+    try {
+        make_directory(directory);
+        std::istringstream config_stream(config + overrides.str());
+        Options run_opt(config_stream);
+        if (input.has_memory_input()) {
+            run_opt.share_memory_input(input);
+        }
+        Solver solver(run_opt);
+        solver.run_case();
+        member.finished = true;
+    }
+    catch (int) {
+        member.finished = false;
+    }
+    std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - start;
+    member.seconds = elapsed.count();
+}
+
+void Ensemble::print_report(
+    std::ostream& os, const std::vector<EnsembleMember>& members)
+{
+    auto flags = os.flags();
+    auto precision = os.precision();
+    os << std::endl
+       << std::left << std::setw(24) << "member" << std::setw(10) << "status"
+       << std::right << std::setw(11) << "time(s)" << std::endl;
+    int failed = 0;
+    for (auto& m : members) {
+        os << std::left << std::setw(24) << m.name << std::setw(10)
+           << (m.finished ? "done" : "failed") << std::right << std::fixed
+           << std::setprecision(2) << std::setw(11) << m.seconds << std::endl;
+        failed += m.finished ? 0 : 1;
+    }
+    if (failed > 0) {
+        os << failed << " of " << members.size() << " members failed"
+           << std::endl;
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
@@ -0,0 +1,63 @@
+#ifndef ENSEMBLE_HPP
+#define ENSEMBLE_HPP
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+class Options;
+
+/**
+ * @brief One run of an ensemble and how it ended
+ */
+struct EnsembleMember {
+    std::string name;     ///< Directory of the member under ensemble/
+    std::string mach;     ///< MACH of the member, NONE keeps the config one
+    std::string reynolds; ///< REYNOLDS of the member, NONE keeps the config
+    bool finished;        ///< False if the run threw
+    double seconds;       ///< Wall time of the run
+};
+
+/**
+ * \class Ensemble
+ * @brief Runs a sweep of small cases concurrently in one process
+ * (ENSEMBLE = TRUE)
+ *
+ * Every combination of ENSEMBLE_MACH and ENSEMBLE_REYNOLDS is a member: the
+ * configuration text with MACH and REYNOLDS replaced, writing to
+ * OUTPUT_BASE_PATH/ensemble/<name>/. Up to ENSEMBLE_CONCURRENCY members
+ * (0 for one per OpenMP thread) run at the same time, one thread each, so
+ * cases too small to keep a node busy share it. The case files are read
+ * once: the members share the flags and boundary points of the grid and
+ * each copies only the initial values and immersed and shock points it
+ * evolves. The phase timers are process wide and stay off during an
+ * ensemble.
+ */
+class Ensemble {
+public:
+    explicit Ensemble(std::string config_in);
+    /**
+     * @return The members and how each of them ended
+     */
+    std::vector<EnsembleMember> run();
+
+    /**
+     * @brief The members of a sweep, Mach numbers outermost
+     */
+    static std::vector<EnsembleMember> members(
+        const std::vector<std::string>& machs,
+        const std::vector<std::string>& reynolds);
+    static void print_report(
+        std::ostream& os, const std::vector<EnsembleMember>& members);
+
+private:
+    std::string config;
+
+    /**
+     * @param input Options holding the memory input the member shares
+     */
+    void run_member(EnsembleMember& member, const Options& input,
+        const std::string& base);
+};
+
+#endif /* ENSEMBLE_HPP */
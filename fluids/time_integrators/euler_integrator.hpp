@@ -1,51 +1,42 @@
 #ifndef EULER_INTEGRATOR_HPP
 #define EULER_INTEGRATOR_HPP
 
-#include "../input_output/writers/writer.hpp"
-#include "../utils/point_functions.hpp"
-#include "time_integrator_tool.hpp"
+#include "../utils/timers/phase_timers.hpp"
+#include "time_integrator.hpp"
 #include "time_integrator_types.hpp"
 #include <algorithm>
 #include <iostream>
 #include <memory>
 #include <utility>
 
+/**
+ * \class EulerIntegrator
+ * @brief First order explicit Euler integrator
+ */
 template <typename Grid, typename Variation>
-class EulerIntegrator {
+class EulerIntegrator : private TimeIntegrator<Grid> {
 public:
     EulerIntegrator(Options& opt_in, Grid& grid_in,
-        std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in);
+        std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in,
+        SolverContext& context_in);
     void run();
 
 private:
-    std::shared_ptr<TimeIntegratorTool> tool;
-    Grid& grid;
-    Variation var;
-    PointFunctions& pf;
-    const double initial_time;
-    const double final_time;
-    const double cfl;
-    Writer writer;
-    const double print_interval;
-    const double reynolds;
-
-    double get_dt(const CartesianGrid& grid_in);
+    typedef TimeIntegrator<Grid> Base;
+    using Base::final_time;
+    using Base::found_nan;
+    using Base::grid;
+    using Base::max_steps;
+    using Base::step_log;
+    using Base::steady;
+    using Base::tool;
 };
 
 template <typename Grid, typename Variation>
 EulerIntegrator<Grid, Variation>::EulerIntegrator(Options& opt_in,
     Grid& grid_in, std::shared_ptr<TimeIntegratorTool> tool_in,
-    PointFunctions& pf_in)
-    : tool(std::move(tool_in))
-    , grid(grid_in)
-    , var(Variation(grid.nPointsTotal))
-    , pf(pf_in)
-    , initial_time(opt_in.t_init())
-    , final_time(opt_in.t_max())
-    , cfl(opt_in.cfl())
-    , writer(Writer(opt_in))
-    , print_interval(opt_in.print_interval())
-    , reynolds(opt_in.reynolds())
+    PointFunctions& pf_in, SolverContext& context_in)
+    : Base(opt_in, grid_in, std::move(tool_in), pf_in, context_in)
 {
 }
 
@@ -53,44 +44,49 @@ template <typename Grid, typename Variation>
 void EulerIntegrator<Grid, Variation>::run()
 {
     double dt;
-    double next_print = initial_time + print_interval;
     Variation k(grid.nPointsTotal);
-    writer.write(grid, initial_time);
-    for (double t = initial_time; t < final_time; t += dt) {
-        dt = get_dt(grid);
-        std::cout << std::scientific << "t=" << t << " dt=" << dt << std::endl;
-        fflush(nullptr);
-        tool->time_derivative(k, grid, t);
-        for (int ind = 0; ind < grid.nPointsTotal; ind++) {
-            grid.set_values(grid.values(ind) + dt * k.grid_variation[ind], ind);
+    long step = 0;
+    double start_time = Base::start_run(step);
+    // Time the last step reached, which labels the final output
+    double end_time = start_time;
+    auto& timers = PhaseTimers::instance();
+    for (double t = start_time; t < final_time; t += dt) {
+        if (max_steps > 0 and step >= max_steps) {
+            break;
         }
-        tool->update_values(&grid, t);
-        if (t + dt >= next_print) {
-            writer.write(grid, t);
-            next_print += print_interval;
+        timers.begin_step();
+        {
+            ScopedPhaseTimer timer(TimerPhase::GetDt);
+            dt = Base::get_dt(grid);
         }
-    }
-}
-
-template <typename Grid, typename Variation>
-double EulerIntegrator<Grid, Variation>::get_dt(const CartesianGrid& grid_in)
-{
-    double dt = 1e10;
-    for (int ind = 0; ind < grid_in.nPointsTotal; ind++) {
-        auto point = grid.values(ind);
-        double c = pf.sound_speed(point);
-        double u = fabs(pf.u(point));
-        double v = fabs(pf.v(point));
-        const double dx = grid.dx;
-        const double dy = grid.dy;
-        double new_dt = 1 / 2.
-            * std::min({dx / (u + c), dy / (v + c), dx * dx * reynolds / 2.,
-                  dy * dy * reynolds / 2.});
-        if (new_dt < dt) {
-            dt = new_dt;
+        if (found_nan) {
+            break;
+        }
+        Base::print_progress(step, t, dt);
+        {
+            ScopedPhaseTimer timer(TimerPhase::PreUpdate);
+            grid.grid_specific_pre_update(dt);
+        }
+        k.compute_norms = steady.enabled() or step_log->due(step);
+        tool->time_derivative(k, grid, t);
+        Base::log_step(step, t, dt, k.norms);
+        {
+            ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+            for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+                grid.set_values(
+                    grid.values(ind) + dt * k.grid_variation[ind], ind);
+            }
+        }
+        Base::end_step(t, dt, step);
+        end_time = t + dt;
+        if (Base::steady_state_reached(k.norms, t + dt, step)) {
+            break;
         }
     }
-    return cfl * dt;
+    Base::finish_run(std::min(end_time, final_time));
 }
 
 #endif /* EULER_INTEGRATOR_HPP */
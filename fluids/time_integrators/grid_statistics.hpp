@@ -0,0 +1,36 @@
+/**
+ * \file grid_statistics.hpp
+ * @brief Per-grid counts reported by the integrators' step log
+ */
+#ifndef GRID_STATISTICS_HPP
+#define GRID_STATISTICS_HPP
+
+#include "../grid/cartesian_grid.hpp"
+#include "../grid/ghias_shock_grid.hpp"
+#include "../grid/karagiozis_grid.hpp"
+#include "../grid/shock_grid.hpp"
+
+/**
+ * @name Shock and revisit counts
+ * Number of shock discontinuities (or shocked points, on GhiasShockGrid) and
+ * of points close to discontinuities. Grids without them report 0.
+ * @{ */
+inline long shock_count(const CartesianGrid& /*grid*/) { return 0; }
+inline long shock_count(ShockGrid& grid) { return grid.shock_points().size(); }
+inline long shock_count(const GhiasShockGrid& grid)
+{
+    return grid.to_revisit().size();
+}
+
+inline long revisit_count(const CartesianGrid& /*grid*/) { return 0; }
+inline long revisit_count(const KaragiozisGrid& grid)
+{
+    return grid.to_revisit().size();
+}
+inline long revisit_count(const GhiasShockGrid& grid)
+{
+    return grid.to_revisit().size();
+}
+/** @} */
+
+#endif /* GRID_STATISTICS_HPP */
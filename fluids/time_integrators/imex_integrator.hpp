@@ -0,0 +1,264 @@
+#ifndef IMEX_INTEGRATOR_HPP
+#define IMEX_INTEGRATOR_HPP
+
+#include "../utils/filters/residual_smoother.hpp"
+#include "../utils/krylov/gmres.hpp"
+#include "../utils/operators_overloads.hpp"
+#include "time_integrator.hpp"
+#include "time_integrator_types.hpp"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * \class ImexIntegrator
+ * @brief IMEX Runge-Kutta integrator: convection explicit, dissipation
+ * implicit
+ *
+ * Uses the ARS(2,2,2) scheme of Ascher, Ruuth and Spiteri (second order,
+ * L-stable implicit part, stiffly accurate), so dt is only limited by the
+ * convective CFL condition. Each implicit stage solves
+ * U - h D(U) = R, D being the dissipation terms, with IMEX_NEWTON_ITERATIONS
+ * Jacobian-free Newton-Krylov iterations: the Jacobian of D is applied by
+ * finite differences and the linear systems are solved by GMRES,
+ * preconditioned with ADI line solves of the viscous operator.
+ */
+template <typename Grid, typename Variation>
+class ImexIntegrator : private TimeIntegrator<Grid> {
+public:
+    ImexIntegrator(Options& opt_in, Grid& grid_in,
+        std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in,
+        SolverContext& context_in);
+    void run();
+
+private:
+    typedef memory::GridArray<Flux> Vector;
+    typedef TimeIntegrator<Grid> Base;
+    using Base::final_time;
+    using Base::found_nan;
+    using Base::grid;
+    using Base::max_steps;
+    using Base::output;
+    using Base::pf;
+    using Base::reynolds;
+    using Base::step_log;
+    using Base::steady;
+    using Base::tool;
+
+    Grid stage_grid;
+    const double prandtl;
+    const int newton_iterations;
+    const double krylov_tolerance;
+    std::shared_ptr<Gmres> gmres;
+    std::shared_ptr<ResidualSmoother> preconditioner;
+
+    void load_stage(const Vector& state, double t);
+    void dissipation(const Vector& state, double t, Variation* d);
+    void solve_implicit(const Vector& rhs, double h, double t, Vector* state,
+        Variation* d);
+};
+
+template <typename Grid, typename Variation>
+ImexIntegrator<Grid, Variation>::ImexIntegrator(Options& opt_in,
+    Grid& grid_in, std::shared_ptr<TimeIntegratorTool> tool_in,
+    PointFunctions& pf_in, SolverContext& context_in)
+    : Base(opt_in, grid_in, std::move(tool_in), pf_in, context_in)
+    , stage_grid(opt_in)
+    , prandtl(opt_in.prandtl())
+    , newton_iterations(opt_in.imex_newton_iterations())
+    , krylov_tolerance(opt_in.imex_krylov_tolerance())
+    , gmres(std::make_shared<Gmres>(opt_in.imex_krylov_iterations(),
+          opt_in.imex_krylov_iterations(), opt_in.imex_krylov_tolerance()))
+    , preconditioner(std::make_shared<ResidualSmoother>(opt_in.cfl()))
+{
+    // The dissipation is implicit
+    Base::viscous_limit = false;
+}
+
+template <typename Grid, typename Variation>
+void ImexIntegrator<Grid, Variation>::run()
+{
+    const double gamma = 1 - 1 / std::sqrt(2.);
+    const double delta = 1 - 1 / (2 * gamma);
+    int n = grid.nPointsTotal;
+    double dt;
+    Variation e1(n), e2(n), d(n);
+    e1.terms = e2.terms = DerivativeTerms::Convection;
+    d.terms = DerivativeTerms::Dissipation;
+    Vector base(n), rhs(n), state(n), implicit2(n);
+    long step = 0;
+    double start_time = Base::start_run(step);
+    // Time the last step reached, which labels the final output
+    double end_time = start_time;
+    for (double t = start_time; t < final_time; t += dt) {
+        if (max_steps > 0 and step >= max_steps) {
+            break;
+        }
+        PhaseTimers::instance().begin_step();
+        {
+            ScopedPhaseTimer timer(TimerPhase::GetDt);
+            dt = Base::get_dt(grid);
+        }
+        if (found_nan) {
+            break;
+        }
+        double next_print = output.next_output_time();
+        if (t + dt >= next_print) {
+            dt = next_print - t;
+        }
+        Base::print_progress(step, t, dt);
+        {
+            ScopedPhaseTimer timer(TimerPhase::PreUpdate);
+            grid.grid_specific_pre_update(dt);
+        }
+        {
+            ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+            stage_grid.update_values(&grid);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+            for (int ind = 0; ind < n; ind++) {
+                auto& p = grid.values(ind);
+                base[ind] = {p.rho(), p.ru(), p.rv(), p.e()};
+            }
+            preconditioner->update_viscous_coefficients(
+                grid, pf, gamma * dt, reynolds, prandtl);
+        }
+        // Explicit convection of the first stage
+        tool->time_derivative(e1, grid, t);
+        // Second stage: U2 - gamma dt D(U2) = U + gamma dt E1
+        rhs = base;
+        axpy(gamma * dt, e1.grid_variation, &rhs);
+        solve_implicit(rhs, gamma * dt, t + gamma * dt, &state, &d);
+        {
+            ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+            implicit2 = state;
+            axpy(-1.0, rhs, &implicit2);
+            scale(1 / (gamma * dt), &implicit2);
+        }
+        tool->time_derivative(e2, stage_grid, t + gamma * dt);
+        // Third stage, which is also the new state
+        rhs = base;
+        axpy(delta * dt, e1.grid_variation, &rhs);
+        axpy((1 - delta) * dt, e2.grid_variation, &rhs);
+        axpy((1 - gamma) * dt, implicit2, &rhs);
+        solve_implicit(rhs, gamma * dt, t + dt, &state, &d);
+        ResidualNorms norms = ResidualNorms();
+        if (steady.enabled() or step_log->due(step)) {
+            // Full time derivative at the start of the step: convection of
+            // the first stage plus the dissipation of the same state
+            dissipation(base, t, &d);
+            axpy(1.0, e1.grid_variation, &d.grid_variation);
+            norms = residual_norms(d.grid_variation);
+        }
+        Base::log_step(step, t, dt, norms);
+        {
+            ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+            for (int ind = 0; ind < n; ind++) {
+                auto& f = state[ind];
+                grid.set_values(Point(f.rho, f.ru, f.rv, f.e), ind);
+            }
+        }
+        Base::end_step(t, dt, step);
+        end_time = t + dt;
+        if (Base::steady_state_reached(norms, t + dt, step)) {
+            break;
+        }
+    }
+    Base::finish_run(std::min(end_time, final_time));
+    std::cout << "Exit imex" << std::endl;
+}
+
+/**
+ * @brief Copies state into the stage grid and applies the boundary
+ * conditions
+ */
+template <typename Grid, typename Variation>
+void ImexIntegrator<Grid, Variation>::load_stage(const Vector& state, double t)
+{
+    {
+        ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+        int n = grid.nPointsTotal;
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+        for (int ind = 0; ind < n; ind++) {
+            auto& f = state[ind];
+            stage_grid.set_values(Point(f.rho, f.ru, f.rv, f.e), ind);
+        }
+    }
+    tool->update_values(&stage_grid, t);
+}
+
+template <typename Grid, typename Variation>
+void ImexIntegrator<Grid, Variation>::dissipation(
+    const Vector& state, double t, Variation* d)
+{
+    load_stage(state, t);
+    tool->time_derivative(*d, stage_grid, t);
+}
+
+/**
+ * @brief Solves state - h D(state) = rhs. On return the stage grid holds
+ * the solution, boundary conditions applied, and so does state.
+ */
+template <typename Grid, typename Variation>
+void ImexIntegrator<Grid, Variation>::solve_implicit(
+    const Vector& rhs, double h, double t, Vector* state, Variation* d)
+{
+    auto& u = *state;
+    int n = grid.nPointsTotal;
+    u = rhs;
+    Vector f0(n), newton_rhs(n), correction(n), shifted(n);
+    auto op = [&](const Vector& v, Vector* out) {
+        double v_norm = norm(v);
+        if (v_norm == 0.0) {
+            std::fill(out->begin(), out->end(), Flux {0.0, 0.0, 0.0, 0.0});
+            return;
+        }
+        double eps = std::sqrt(std::numeric_limits<double>::epsilon())
+            * (1 + norm(u)) / v_norm;
+        shifted = u;
+        axpy(eps, v, &shifted);
+        dissipation(shifted, t, d);
+        // out = v - h (D(u + eps v) - D(u)) / eps
+        *out = v;
+        axpy(-h / eps, d->grid_variation, out);
+        axpy(h / eps, f0, out);
+    };
+    auto precondition = [&](const Vector& v, Vector* out) {
+        *out = v;
+        preconditioner->smooth(grid, out);
+    };
+    for (int it = 0; it < newton_iterations; it++) {
+        dissipation(u, t, d);
+        f0 = d->grid_variation;
+        // newton_rhs = rhs + h D(u) - u
+        newton_rhs = rhs;
+        axpy(h, f0, &newton_rhs);
+        axpy(-1.0, u, &newton_rhs);
+        if (norm(newton_rhs) <= krylov_tolerance * h * norm(f0)) {
+            break;
+        }
+        std::fill(correction.begin(), correction.end(),
+            Flux {0.0, 0.0, 0.0, 0.0});
+        gmres->solve(op, precondition, newton_rhs, &correction);
+        axpy(1.0, correction, &u);
+    }
+    load_stage(u, t);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        auto& p = stage_grid.values(ind);
+        u[ind] = {p.rho(), p.ru(), p.rv(), p.e()};
+    }
+}
+
+#endif /* IMEX_INTEGRATOR_HPP */
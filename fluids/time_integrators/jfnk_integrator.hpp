@@ -0,0 +1,370 @@
+#ifndef JFNK_INTEGRATOR_HPP
+#define JFNK_INTEGRATOR_HPP
+
+#include "../utils/filters/residual_smoother.hpp"
+#include "../utils/krylov/gmres.hpp"
+#include "../utils/operators_overloads.hpp"
+#include "time_integrator.hpp"
+#include "time_integrator_types.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * \class JfnkIntegrator
+ * @brief Steady solver: Jacobian-free Newton-Krylov with pseudo-transient
+ * continuation
+ *
+ * The time derivative R(U) is taken as the residual of the steady problem.
+ * Every iteration solves (I - tau J) dU = tau R(U) once, tau being the local
+ * step of each point at the current CFL number and J the Jacobian of R,
+ * applied by finite differences. The linear systems are solved by GMRES,
+ * preconditioned with ADI line solves of a scalar approximation of the same
+ * operator (see ResidualSmoother::update_implicit_coefficients). The CFL
+ * number grows as the residual drops (switched evolution relaxation,
+ * CFL * R_0 / R, up to JFNK_MAX_CFL), so the iterations go from pseudo time
+ * marching to Newton's method. Updates that produce non-physical states are
+ * discarded and retried from the same state with a smaller CFL number.
+ *
+ * Boundary conditions are applied after each update and before each
+ * residual evaluation, as in the time integrators. The values they impose
+ * are not unknowns: their residual is left out of the Newton system and of
+ * the STEADY_STATE criteria. t is a pseudo time,
+ * advanced (with the shocks of shock fitting grids) by the explicit step at
+ * the CFL option, whatever the local steps are. The run stops on the
+ * STEADY_STATE criteria, after JFNK_MAX_ITERATIONS iterations or MAX_STEPS,
+ * not at T_MAX.
+ */
+template <typename Grid, typename Variation>
+class JfnkIntegrator : private TimeIntegrator<Grid> {
+public:
+    JfnkIntegrator(Options& opt_in, Grid& grid_in,
+        std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in,
+        SolverContext& context_in);
+    void run();
+    long iterations() const { return accepted; }
+    long retries() const { return retried; }
+
+private:
+    typedef memory::GridArray<Flux> Vector;
+    typedef TimeIntegrator<Grid> Base;
+    using Base::cfl;
+    using Base::found_nan;
+    using Base::grid;
+    using Base::local_dt; ///< Stable explicit step of each point at CFL 1
+    using Base::pf;
+    using Base::reynolds;
+    using Base::step_log;
+    using Base::steady;
+    using Base::tool;
+
+    const double max_cfl;
+    const long max_iterations;
+    Grid work_grid;
+    const double prandtl;
+    std::shared_ptr<Gmres> gmres;
+    std::shared_ptr<ResidualSmoother> preconditioner;
+    /** Pseudo time step of each point in the current iteration */
+    std::vector<double> tau;
+    /**
+     * 1 for the values left to the residual, 0 for the ones imposed by
+     * boundary conditions or by the grid (ghost points)
+     */
+    Vector free_values;
+    long accepted;
+    long retried;
+
+    void load_state(const Vector& state, double t);
+    void find_free_values(const Vector& state, double t);
+    void mask(Vector* variation) const;
+    bool is_physical(const Vector& state) const;
+};
+
+template <typename Grid, typename Variation>
+JfnkIntegrator<Grid, Variation>::JfnkIntegrator(Options& opt_in,
+    Grid& grid_in, std::shared_ptr<TimeIntegratorTool> tool_in,
+    PointFunctions& pf_in, SolverContext& context_in)
+    : Base(opt_in, grid_in, std::move(tool_in), pf_in, context_in, true)
+    , max_cfl(std::max(opt_in.cfl(), opt_in.jfnk_max_cfl()))
+    , max_iterations(opt_in.max_steps() > 0
+              ? std::min(opt_in.max_steps(), opt_in.jfnk_max_iterations())
+              : opt_in.jfnk_max_iterations())
+    , work_grid(opt_in)
+    , prandtl(opt_in.prandtl())
+    , gmres(std::make_shared<Gmres>(opt_in.jfnk_krylov_iterations(),
+          opt_in.jfnk_krylov_iterations(), opt_in.jfnk_krylov_tolerance()))
+    , preconditioner(std::make_shared<ResidualSmoother>(opt_in.cfl()))
+    , tau(grid.nPointsTotal)
+    , free_values(grid.nPointsTotal)
+    , accepted(0)
+    , retried(0)
+{
+    // The steps are taken at CFL 1 and scaled by the CFL of each iteration
+    Base::dt_cfl = 1.0;
+    local_dt.resize(grid.nPointsTotal);
+    if (!opt_in.steady_state()) {
+        std::cerr << "JFNK always runs to a steady state, using the "
+                     "STEADY_STATE criteria"
+                  << std::endl;
+    }
+}
+
+template <typename Grid, typename Variation>
+void JfnkIntegrator<Grid, Variation>::run()
+{
+    int n = grid.nPointsTotal;
+    Variation residual(n), perturbed(n);
+    Vector state(n), rhs(n), correction(n), shifted(n), trial(n);
+    long step = 0;
+    double t = Base::start_run(step);
+    // Jacobian of the residual times v, by forward differences around state
+    auto op = [&](const Vector& v, Vector* out) {
+        double v_norm = norm(v);
+        if (v_norm == 0.0) {
+            std::fill(out->begin(), out->end(), Flux {0.0, 0.0, 0.0, 0.0});
+            return;
+        }
+        double eps = std::sqrt(std::numeric_limits<double>::epsilon())
+            * (1 + norm(state)) / v_norm;
+        shifted = state;
+        axpy(eps, v, &shifted);
+        load_state(shifted, t);
+        tool->time_derivative(perturbed, work_grid, t);
+        mask(&perturbed.grid_variation);
+        // out = v - tau (R(state + eps v) - R(state)) / eps
+        auto& r = residual.grid_variation;
+        auto& rp = perturbed.grid_variation;
+        auto& result = *out;
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+        for (int ind = 0; ind < n; ind++) {
+            double h = tau[ind] / eps;
+            result[ind] = v[ind];
+            result[ind].rho -= h * (rp[ind].rho - r[ind].rho);
+            result[ind].ru -= h * (rp[ind].ru - r[ind].ru);
+            result[ind].rv -= h * (rp[ind].rv - r[ind].rv);
+            result[ind].e -= h * (rp[ind].e - r[ind].e);
+        }
+    };
+    auto precondition = [&](const Vector& v, Vector* out) {
+        ScopedPhaseTimer timer(TimerPhase::ResidualSmoothing);
+        *out = v;
+        preconditioner->smooth(grid, out);
+    };
+    double reference = 0.0;
+    double cfl_cut = 1.0;
+    bool retry = false;
+    double end_time = t;
+    auto& timers = PhaseTimers::instance();
+    while (step < max_iterations) {
+        timers.begin_step();
+        double dt;
+        {
+            ScopedPhaseTimer timer(TimerPhase::GetDt);
+            dt = Base::get_dt(grid);
+        }
+        if (found_nan) {
+            break;
+        }
+        // A retried update starts from the same state and residual
+        if (!retry) {
+            {
+                ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+                for (int ind = 0; ind < n; ind++) {
+                    auto& p = grid.values(ind);
+                    state[ind] = {p.rho(), p.ru(), p.rv(), p.e()};
+                }
+                work_grid.update_values(&grid);
+            }
+            find_free_values(state, t);
+            tool->time_derivative(residual, grid, t);
+            mask(&residual.grid_variation);
+            auto norms = residual_norms(residual.grid_variation);
+            Base::log_step(step, t, cfl * dt, norms);
+            if (steady.update(norms)) {
+                std::cout << std::endl
+                          << "Steady state after " << step
+                          << " iterations: " << steady.reason() << std::endl;
+                timers.end_step(grid.nPointsTotal);
+                break;
+            }
+        }
+        // Switched evolution relaxation
+        double residual_norm = norm(residual.grid_variation);
+        if (reference == 0.0) {
+            reference = residual_norm;
+        }
+        double step_cfl = residual_norm > 0.0
+            ? std::min(max_cfl, cfl * cfl_cut * reference / residual_norm)
+            : max_cfl;
+        step_cfl = std::max(step_cfl, cfl * cfl_cut);
+        // Shocks (and t) move with a stable explicit step
+        double grid_dt = cfl * dt;
+        dt *= step_cfl;
+        {
+            ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+            for (int ind = 0; ind < n; ind++) {
+                tau[ind] = step_cfl * local_dt[ind];
+                rhs[ind] = residual.grid_variation[ind] * tau[ind];
+            }
+            preconditioner->update_implicit_coefficients(
+                grid, pf, tau, reynolds, prandtl);
+        }
+        std::fill(
+            correction.begin(), correction.end(), Flux {0.0, 0.0, 0.0, 0.0});
+        auto linear = gmres->solve(op, precondition, rhs, &correction);
+        if (step_log->progress_due(step)) {
+            std::cout << std::scientific << "\r\bstep=" << step
+                      << " cfl=" << step_cfl
+                      << " residual=" << steady.relative_residual()
+                      << " krylov=" << linear.iterations << std::flush;
+        }
+        // The Jacobian of a retry is taken around the same state again
+        trial = state;
+        axpy(1.0, correction, &trial);
+        retry = !is_physical(trial);
+        if (retry) {
+            retried++;
+            cfl_cut *= 0.1;
+            timers.end_step(grid.nPointsTotal);
+            if (cfl_cut < 1e-3) {
+                std::cout << std::endl
+                          << "JFNK update failed at the smallest CFL number"
+                          << std::endl;
+                break;
+            }
+            continue;
+        }
+        cfl_cut = std::min(1.0, 2 * cfl_cut);
+        {
+            ScopedPhaseTimer timer(TimerPhase::PreUpdate);
+            grid.grid_specific_pre_update(grid_dt);
+        }
+        {
+            ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+            for (int ind = 0; ind < n; ind++) {
+                auto& f = trial[ind];
+                grid.set_values(Point(f.rho, f.ru, f.rv, f.e), ind);
+            }
+        }
+        Base::end_step(t, grid_dt, step);
+        accepted++;
+        t += grid_dt;
+        end_time = t;
+    }
+    Base::finish_run(end_time);
+    std::cout << "Exit jfnk" << std::endl;
+}
+
+/**
+ * @brief Copies state into the work grid and applies the boundary
+ * conditions
+ */
+template <typename Grid, typename Variation>
+void JfnkIntegrator<Grid, Variation>::load_state(const Vector& state, double t)
+{
+    {
+        ScopedPhaseTimer timer(TimerPhase::StageUpdate);
+        int n = grid.nPointsTotal;
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+        for (int ind = 0; ind < n; ind++) {
+            auto& f = state[ind];
+            work_grid.set_values(Point(f.rho, f.ru, f.rv, f.e), ind);
+        }
+    }
+    tool->update_values(&work_grid, t);
+}
+
+/**
+ * @brief Shifts every value of state and keeps as free the ones whose shift
+ * survives the boundary conditions and grid specific updates
+ *
+ * The shifted values are single precision numbers, so they are stored
+ * exactly whatever the storage precision and the storage rounding of the
+ * tool, and a value the updates leave alone reads back equal.
+ */
+template <typename Grid, typename Variation>
+void JfnkIntegrator<Grid, Variation>::find_free_values(
+    const Vector& state, double t)
+{
+    int n = grid.nPointsTotal;
+    Vector shifted(n);
+    auto shift = [](double value) {
+        return round_to_single(value + 1e-3 * (1 + fabs(value)));
+    };
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        auto& f = state[ind];
+        shifted[ind]
+            = {shift(f.rho), shift(f.ru), shift(f.rv), shift(f.e)};
+    }
+    load_state(shifted, t);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        auto& p = work_grid.values(ind);
+        auto& f = shifted[ind];
+        free_values[ind] = {p.rho() == f.rho ? 1.0 : 0.0,
+            p.ru() == f.ru ? 1.0 : 0.0, p.rv() == f.rv ? 1.0 : 0.0,
+            p.e() == f.e ? 1.0 : 0.0};
+    }
+}
+
+template <typename Grid, typename Variation>
+void JfnkIntegrator<Grid, Variation>::mask(Vector* variation) const
+{
+    auto& var = *variation;
+    int n = grid.nPointsTotal;
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        var[ind].rho *= free_values[ind].rho;
+        var[ind].ru *= free_values[ind].ru;
+        var[ind].rv *= free_values[ind].rv;
+        var[ind].e *= free_values[ind].e;
+    }
+}
+
+/**
+ * @brief Whether every fluid point has positive density and pressure
+ */
+template <typename Grid, typename Variation>
+bool JfnkIntegrator<Grid, Variation>::is_physical(const Vector& state) const
+{
+    bool physical = true;
+    int n = grid.nPointsTotal;
+#ifndef DEBUG
+#pragma omp parallel for reduction(&& : physical)
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        if (!grid.ind_is_valid(ind)) {
+            continue;
+        }
+        auto& f = state[ind];
+        Point p(f.rho, f.ru, f.rv, f.e);
+        physical = physical && f.rho > 0.0 && pf.pressure(p) > 0.0;
+    }
+    return physical;
+}
+
+#endif /* JFNK_INTEGRATOR_HPP */
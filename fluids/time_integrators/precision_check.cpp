@@ -0,0 +1,113 @@
+#include "precision_check.hpp"
+#include "../input_output/options.hpp"
+#include "../utils/parallel/communicator.hpp"
+#include "solver.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <sys/stat.h>
+#include <utility>
+
+namespace {
+void make_directory(const std::string& path)
+{
+    if (mkdir(path.c_str(), 0755) != 0 and errno != EEXIST) {
+        std::cerr << "Could not create directory " << path << std::endl;
+        throw(-1);
+    }
+}
+
+std::array<double, 4> components(const Point& p)
+{
+    return {{p.rho(), p.ru(), p.rv(), p.e()}};
+}
+} // namespace
+
+std::array<FieldDifference, 4> field_differences(
+    const std::vector<Point>& reference, const std::vector<Point>& other)
+{
+    std::array<FieldDifference, 4> differences {};
+    if (reference.size() != other.size()) {
+        std::cerr << "Cannot compare fields of " << reference.size()
+                  << " and " << other.size() << " points" << std::endl;
+        throw(-1);
+    }
+    for (size_t ind = 0; ind < reference.size(); ind++) {
+        auto ref = components(reference[ind]);
+        auto value = components(other[ind]);
+        for (size_t c = 0; c < differences.size(); c++) {
+            auto& d = differences[c];
+            double diff = std::fabs(value[c] - ref[c]);
+            d.max_abs = std::max(d.max_abs, diff);
+            d.rms += diff * diff;
+            d.reference = std::max(d.reference, std::fabs(ref[c]));
+        }
+    }
+    for (auto& d : differences) {
+        d.rms = reference.empty() ? 0.0 : std::sqrt(d.rms / reference.size());
+    }
+    return differences;
+}
+
+PrecisionCheck::PrecisionCheck(std::string config_in)
+    : config(std::move(config_in))
+{
+}
+
+void PrecisionCheck::run()
+{
+#ifdef SINGLE_PRECISION_STORAGE
+    std::cerr << "PRECISION_CHECK needs a build with double storage"
+              << std::endl;
+    throw(-1);
+#endif
+    if (parallel::size() > 1) {
+        std::cerr << "PRECISION_CHECK runs on a single process" << std::endl;
+        throw(-1);
+    }
+    std::istringstream config_stream(config);
+    Options opt(config_stream);
+    auto base = opt.output_base_path();
+    make_directory(base);
+    auto reference = run_case("NONE", base + "precision_double/");
+    auto single = run_case("SINGLE", base + "precision_single/");
+    print_report(std::cout, field_differences(reference, single));
+}
+
+std::vector<Point> PrecisionCheck::run_case(
+    const std::string& rounding, const std::string& directory)
+{
+    make_directory(directory);
+    std::istringstream config_stream(config + "\nPRECISION_CHECK = FALSE\n"
+        + "STORAGE_ROUNDING = " + rounding + "\n"
+        + "OUTPUT_BASE_PATH = " + directory + "\n");
+    Options run_opt(config_stream);
+    Solver solver(run_opt, true);
+    solver.run();
+    return solver.final_values();
+}
+
+void PrecisionCheck::print_report(
+    std::ostream& os, const std::array<FieldDifference, 4>& differences)
+{
+    const char* names[] = {"rho", "ru", "rv", "e"};
+    os << std::endl
+       << "Single against double precision storage" << std::endl
+       << std::left << std::setw(8) << "field" << std::right
+       << std::setw(14) << "max|diff|" << std::setw(14) << "rms(diff)"
+       << std::setw(14) << "max|value|" << std::setw(14) << "relative"
+       << std::endl;
+    os << std::scientific << std::setprecision(4);
+    for (size_t c = 0; c < differences.size(); c++) {
+        auto& d = differences[c];
+        double relative = d.reference > 0.0 ? d.max_abs / d.reference : 0.0;
+        os << std::left << std::setw(8) << names[c] << std::right
+           << std::setw(14) << d.max_abs << std::setw(14) << d.rms
+           << std::setw(14) << d.reference << std::setw(14) << relative
+           << std::endl;
+    }
+    os << std::defaultfloat;
+}
@@ -0,0 +1,51 @@
+#ifndef PRECISION_CHECK_HPP
+#define PRECISION_CHECK_HPP
+
+#include "../utils/point_def.hpp"
+#include <array>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Difference of one conservative variable between two runs
+ */
+struct FieldDifference {
+    double max_abs;   ///< Largest absolute difference over the points
+    double rms;       ///< Root mean square of the differences
+    double reference; ///< Largest absolute value of the reference field
+};
+
+/**
+ * @brief Differences of rho, ru, rv and e between reference and other
+ */
+std::array<FieldDifference, 4> field_differences(
+    const std::vector<Point>& reference, const std::vector<Point>& other);
+
+/**
+ * \class PrecisionCheck
+ * @brief Runs a case with double and with single precision storage and
+ * reports how far the final fields are apart (PRECISION_CHECK = TRUE)
+ *
+ * Both runs read the configuration text the check was made with. The
+ * single precision run rounds the state as SINGLE_PRECISION_STORAGE stores
+ * it (STORAGE_ROUNDING = SINGLE), so the check needs a double storage
+ * build. Outputs go to OUTPUT_BASE_PATH/precision_double/ and
+ * OUTPUT_BASE_PATH/precision_single/.
+ */
+class PrecisionCheck {
+public:
+    explicit PrecisionCheck(std::string config_in);
+    void run();
+
+    static void print_report(
+        std::ostream& os, const std::array<FieldDifference, 4>& differences);
+
+private:
+    std::string config;
+
+    std::vector<Point> run_case(
+        const std::string& rounding, const std::string& directory);
+};
+
+#endif /* PRECISION_CHECK_HPP */
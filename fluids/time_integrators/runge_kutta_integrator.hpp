@@ -1,200 +1,269 @@
 #ifndef RUNGE_KUTTA_INTEGRATOR_HPP
 #define RUNGE_KUTTA_INTEGRATOR_HPP
 
-#include "../input_output/writers/writer.hpp"
-#include "../utils/point_functions.hpp"
 #include "../utils/filters/minimal_filter.hpp"
 #include "../utils/filters/minimal_filter_factory.hpp"
-#include "../utils/global_vars.hpp"
-#include "time_integrator_tool.hpp"
-#include <cstdio>
+#include "../utils/filters/residual_smoother.hpp"
+#include "../utils/operators_overloads.hpp"
+#include "time_integrator.hpp"
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 template <typename Grid, typename Variation>
-class RungeKuttaIntegrator {
+class RungeKuttaIntegrator : private TimeIntegrator<Grid> {
 public:
     RungeKuttaIntegrator(Options& opt_in, Grid& grid_in,
-        std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in);
+        std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in,
+        SolverContext& context_in);
     void run();
 
+    /**
+     * @name Step control
+     * run() is start(), step() until finished(), then finish(). Code that
+     * embeds the solver (see Simulation) drives the steps itself
+     * @{ */
+    void start();
+    /**
+     * @return true if the step ended at a print time (PRINT_INTERVAL)
+     */
+    bool step();
+    /**
+     * @brief Writes the final output. A run stopped before finished() writes
+     * it at the time reached
+     */
+    void finish();
+    /**
+     * @brief Whether T_MAX, MAX_STEPS, a steady state or a NaN ended the run
+     */
+    bool finished() const;
+    double time() const { return t; }
+    long steps() const { return step_number; }
+    /**
+     * @brief Step of the last step() and, with LOCAL_TIME_STEPPING, the step
+     * each point took (empty otherwise)
+     */
+    double step_size() const { return dt; }
+    const std::vector<double>& local_steps() const { return local_dt; }
+    /**
+     * @brief Shortens the step that would pass t_stop so that it ends there
+     */
+    void stop_at(double t_stop) { stop_time = t_stop; }
+    /**  @} */
+
 private:
-    std::shared_ptr<TimeIntegratorTool> tool;
-    Grid& grid;
-    PointFunctions& pf;
-    const double initial_time;
-    const double final_time;
-    const double cfl;
-    Writer writer;
+    typedef TimeIntegrator<Grid> Base;
+    using Base::final_time;
+    using Base::found_nan;
+    using Base::grid;
+    using Base::initial_time;
+    using Base::local_dt;
+    using Base::max_steps;
+    using Base::output;
+    using Base::pf;
+    using Base::step_log;
+    using Base::steady;
+    using Base::tool;
+
+    Variation k1;
+    Variation k2;
+    Variation k3;
+    double t;
+    double dt;
+    long step_number;
+    double stop_time;
+    bool stopped; ///< Steady state or NaN
     Grid aux_grid;
-    const double print_interval;
-    const double reynolds;
     const bool should_filter;
     std::shared_ptr<MinimalFilter> minimal_filter;
-    bool found_nan;
+    /**
+     * With LOCAL_TIME_STEPPING (steady runs only) every point advances with
+     * its own CFL-limited step, kept in local_dt; t is then a pseudo time
+     * advanced by the smallest step
+     */
+    const bool local_time_stepping;
+    /**
+     * Implicit residual smoothing, nullptr unless RESIDUAL_SMOOTHING is set
+     */
+    std::shared_ptr<ResidualSmoother> smoother;
 
-    double get_dt(const CartesianGrid& grid_in);
-    double get_dt(const ShockGrid& grid_in);
+    double step_at(int ind, double dt) const
+    {
+        return local_time_stepping ? local_dt[ind] : dt;
+    }
+    void smooth(Variation& k)
+    {
+        if (smoother) {
+            ScopedPhaseTimer timer(TimerPhase::ResidualSmoothing);
+            smoother->smooth(grid, &k.grid_variation);
+        }
+    }
 };
 
 template <typename Grid, typename Variation>
 RungeKuttaIntegrator<Grid, Variation>::RungeKuttaIntegrator(Options& opt_in,
     Grid& grid_in, std::shared_ptr<TimeIntegratorTool> tool_in,
-    PointFunctions& pf_in)
-    : tool(std::move(tool_in))
-    , grid(grid_in)
-    , pf(pf_in)
-    , initial_time(opt_in.t_init())
-    , final_time(opt_in.t_max())
-    , cfl(opt_in.cfl())
-    , writer(Writer(opt_in))
+    PointFunctions& pf_in, SolverContext& context_in)
+    : Base(opt_in, grid_in, std::move(tool_in), pf_in, context_in)
+    , k1(grid.nPointsTotal)
+    , k2(grid.nPointsTotal)
+    , k3(grid.nPointsTotal)
+    , t(initial_time)
+    , dt(0.0)
+    , step_number(0)
+    , stop_time(std::numeric_limits<double>::infinity())
+    , stopped(false)
     , aux_grid(opt_in)
-    , print_interval(opt_in.print_interval())
-    , reynolds(opt_in.reynolds())
     , should_filter(opt_in.should_filter())
     , minimal_filter(create_minimal_filter(opt_in.filter_order()))
-    , found_nan(false)
+    , local_time_stepping(
+          opt_in.steady_state() and opt_in.local_time_stepping())
+    , smoother(opt_in.residual_smoothing()
+              ? std::make_shared<ResidualSmoother>(
+                  opt_in.residual_smoothing_cfl())
+              : nullptr)
 {
+    if (local_time_stepping) {
+        local_dt.resize(grid.nPointsTotal);
+    }
+    if (opt_in.local_time_stepping() and !local_time_stepping) {
+        std::cerr << "LOCAL_TIME_STEPPING needs STEADY_STATE, ignoring it"
+                  << std::endl;
+    }
 }
 
 template <typename Grid, typename Variation>
 void RungeKuttaIntegrator<Grid, Variation>::run()
 {
-    double dt;
-    double next_print = initial_time + print_interval;
-    Variation k1(grid.nPointsTotal);
-    Variation k2(grid.nPointsTotal);
-    Variation k3(grid.nPointsTotal);
-    writer.write(grid, initial_time);
-    grid.specific_print();
-    for (double t = initial_time; t < final_time; t += dt) {
-        dt = get_dt(grid);
-        if (found_nan) {
-            break;
-        }
-        if (t + dt >= next_print) {
-            dt = next_print - t;
+    start();
+    while (!finished()) {
+        step();
+    }
+    finish();
+}
+
+template <typename Grid, typename Variation>
+void RungeKuttaIntegrator<Grid, Variation>::start()
+{
+    t = Base::start_run(step_number);
+}
+
+template <typename Grid, typename Variation>
+bool RungeKuttaIntegrator<Grid, Variation>::finished() const
+{
+    return stopped or !(t < final_time)
+        or (max_steps > 0 and step_number >= max_steps);
+}
+
+template <typename Grid, typename Variation>
+bool RungeKuttaIntegrator<Grid, Variation>::step()
+{
+    PhaseTimers::instance().begin_step();
+    {
+        ScopedPhaseTimer timer(TimerPhase::GetDt);
+        dt = Base::get_dt(grid);
+    }
+    if (found_nan) {
+        stopped = true;
+        return false;
+    }
+    bool reaches_stop = false;
+    double next_print = std::min(output.next_output_time(), stop_time);
+    if (t + dt >= next_print) {
+        double clipped = next_print - t;
+        if (local_time_stepping) {
+            for (auto& local : local_dt) {
+                local *= clipped / dt;
+            }
         }
-        printf("\r\bt=%e dt=%e", t, dt);
-        fflush(nullptr);
+        dt = clipped;
+        reaches_stop = next_print == stop_time;
+    }
+    if (smoother) {
+        ScopedPhaseTimer timer(TimerPhase::ResidualSmoothing);
+        smoother->update_coefficients(grid, pf, dt, local_dt);
+    }
+    Base::print_progress(step_number, t, dt);
+    {
+        ScopedPhaseTimer timer(TimerPhase::PreUpdate);
         grid.grid_specific_pre_update(dt);
-        if (should_filter) {
-            minimal_filter->filter_grid(&grid);
-        }
+    }
+    if (should_filter) {
+        ScopedPhaseTimer timer(TimerPhase::Filter);
+        minimal_filter->filter_grid(&grid);
+    }
+    {
+        ScopedPhaseTimer timer(TimerPhase::StageUpdate);
         aux_grid.update_values(&grid);
-        // Compute k1
-        tool->time_derivative(k1, grid, t);
-// Compute k2
+    }
+    // Compute k1
+    k1.compute_norms = steady.enabled() or step_log->due(step_number);
+    tool->time_derivative(k1, grid, t);
+    smooth(k1);
+    Base::log_step(step_number, t, dt, k1.norms);
+    // Compute k2
+    {
+        ScopedPhaseTimer timer(TimerPhase::StageUpdate);
 #ifndef DEBUG
 #pragma omp parallel for
 #endif
         for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+            double h = step_at(ind, dt);
             aux_grid.set_values(
-                grid.values(ind) + (dt / 2.) * k1.grid_variation[ind], ind);
+                grid.values(ind) + (h / 2.) * k1.grid_variation[ind], ind);
         }
-        tool->update_values(&aux_grid, t + dt / 2);
-        tool->time_derivative(k2, aux_grid, t + dt / 2);
-// Compute k3
+    }
+    tool->update_values(&aux_grid, t + dt / 2);
+    tool->time_derivative(k2, aux_grid, t + dt / 2);
+    smooth(k2);
+    // Compute k3
+    {
+        ScopedPhaseTimer timer(TimerPhase::StageUpdate);
 #ifndef DEBUG
 #pragma omp parallel for
 #endif
         for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+            double h = step_at(ind, dt);
             aux_grid.set_values(grid.values(ind)
-                    + (-dt) * k1.grid_variation[ind]
-                    + (2 * dt) * k2.grid_variation[ind],
+                    + (-h) * k1.grid_variation[ind]
+                    + (2 * h) * k2.grid_variation[ind],
                 ind);
         }
-        tool->update_values(&aux_grid, t + dt);
-        tool->time_derivative(k3, aux_grid, t + dt);
-// Update grid
+    }
+    tool->update_values(&aux_grid, t + dt);
+    tool->time_derivative(k3, aux_grid, t + dt);
+    smooth(k3);
+    // Update grid
+    {
+        ScopedPhaseTimer timer(TimerPhase::StageUpdate);
 #ifndef DEBUG
 #pragma omp parallel for
 #endif
         for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+            double h = step_at(ind, dt);
             grid.set_values(grid.values(ind)
-                    + (1 / 6. * dt) * k1.grid_variation[ind]
-                    + (4 / 6. * dt) * k2.grid_variation[ind]
-                    + (1 / 6. * dt) * k3.grid_variation[ind],
+                    + (1 / 6. * h) * k1.grid_variation[ind]
+                    + (4 / 6. * h) * k2.grid_variation[ind]
+                    + (1 / 6. * h) * k3.grid_variation[ind],
                 ind);
         }
-        tool->update_values(&grid, t + dt);
-        grid.grid_specific_pos_update(dt);
-        if (t + dt >= next_print) {
-            writer.write(grid, t + dt);
-            grid.specific_print();
-            next_print += print_interval;
-        }
-    }
-    writer.write(grid, final_time);
-    std::cout << "Exit runge" << std::endl;
-}
-
-template <typename Grid, typename Variation>
-double RungeKuttaIntegrator<Grid, Variation>::get_dt(
-    const CartesianGrid& grid_in)
-{
-    double dt = 1e10;
-    max_mach_number = max_u_plus_c = max_v_plus_c = 0.0;
-#ifndef DEBUG
-#pragma omp parallel for reduction(                                            \
-    min : dt), reduction(max : max_mach_number, max_u_plus_c, max_v_plus_c)
-#endif
-    for (int ind = 0; ind < grid_in.nPointsTotal; ind++) {
-        auto point = grid.values(ind);
-        double c = pf.sound_speed(point);
-        double u = fabs(pf.u(point));
-        double v = fabs(pf.v(point));
-        const double dx = grid.dx;
-        const double dy = grid.dy;
-        double new_dt
-            = 1 / 2. * std::min({dx / (u + c), dy / (v + c),
-                           dx * dx * reynolds / 2., dy * dy * reynolds / 2.});
-        if (new_dt < dt) {
-            dt = new_dt;
-        }
-        auto new_mach = pf.mach_number(point);
-        if (max_mach_number < new_mach) {
-            max_mach_number = new_mach;
-        }
-        auto new_u_plus_c = u + c;
-        if (max_u_plus_c < new_u_plus_c) {
-            max_u_plus_c = new_u_plus_c;
-        }
-        auto new_v_plus_c = v + c;
-        if (max_v_plus_c < new_v_plus_c) {
-            max_v_plus_c = new_v_plus_c;
-        }
-        if (point.rho() != point.rho() || point.ru() != point.ru()
-            || point.rv() != point.rv() || point.e() != point.e()) {
-            found_nan = true;
-            std::cout << std::endl
-                      << "NaN found at ind=" << ind << " x=" << grid.X(ind)
-                      << " y=" << grid.Y(ind) << std::endl;
-        }
     }
-    if (max_mach_number > 1) {
-        max_mach_number = 1;
+    bool printed = Base::end_step(t, dt, step_number);
+    if (Base::steady_state_reached(k1.norms, t + dt, step_number)) {
+        stopped = true;
     }
-    return cfl * dt;
+    // Lands on stop_time exactly, so that advancing to it ends there
+    t = reaches_stop ? stop_time : t + dt;
+    return printed;
 }
 
 template <typename Grid, typename Variation>
-double RungeKuttaIntegrator<Grid, Variation>::get_dt(const ShockGrid& grid_in)
+void RungeKuttaIntegrator<Grid, Variation>::finish()
 {
-    auto dt = get_dt(dynamic_cast<const CartesianGrid&>(grid_in));
-    for (auto& sp : grid.shock_points()) {
-        double shock_dt;
-        if (sp.is_x()) {
-            shock_dt = fabs(grid.dx * cos(sp.theta) / sp.w);
-        }
-        else {
-            shock_dt = fabs(grid.dy * sin(sp.theta) / sp.w);
-        }
-        if (dt > shock_dt) {
-            dt = shock_dt * cfl;
-        }
-    }
-    return dt;
+    Base::finish_run(std::min(t, final_time));
+    std::cout << "Exit runge" << std::endl;
 }
+
 #endif /* RUNGE_KUTTA_INTEGRATOR_HPP */
@@ -5,27 +5,55 @@
 #include "../grid/karagiozis_grid.hpp"
 #include "../grid/shock_grid.hpp"
 #include "../input_output/options.hpp"
+#include "../utils/memory/grid_allocator.hpp"
+#include "../utils/memory/thread_affinity.hpp"
 #include "../utils/operators_overloads.hpp"
+#include "../utils/parallel/communicator.hpp"
+#include "../utils/timers/phase_timers.hpp"
+#include "adaptive_runge_kutta_integrator.hpp"
 #include "euler_integrator.hpp"
+#include "imex_integrator.hpp"
+#include "jfnk_integrator.hpp"
 #include "omp.h"
 #include "runge_kutta_integrator.hpp"
 #include "time_integrator_tool.hpp"
 #include "time_integrator_tool_factory.hpp"
+#include "traversal_tuner.hpp"
+#include <fstream>
+#include <iostream>
 #include <memory>
 
-Solver::Solver(Options& opt_in)
+Solver::Solver(Options& opt_in, bool keep_final_values_in)
     : opt(opt_in)
     , pf(PointFunctions(opt.mach(), opt.gam()))
+    , keep_final_values(keep_final_values_in)
 {
 }
 
 void Solver::run()
+{
+    configure_process(opt);
+    PhaseTimers::instance().set_enabled(opt.timing());
+    run_case();
+}
+
+void Solver::configure_process(Options& opt)
 {
 #ifndef DEBUG
     if (opt.omp_threads() > 0) {
         omp_set_num_threads(opt.omp_threads());
     }
 #endif
+    memory::pin_threads(opt.thread_affinity());
+    memory::set_first_touch(opt.first_touch());
+    memory::set_huge_pages(opt.huge_pages());
+}
+
+void Solver::run_case()
+{
+    if (parallel::size() > 1) {
+        check_decomposition_support(opt);
+    }
     if (opt.solver_type() == "SIMPLE") {
         setup_and_run<CartesianGrid>();
     }
@@ -51,18 +79,128 @@ template <typename Grid>
 void Solver::setup_and_run()
 {
     Grid grid(opt);
-    auto tool = create_time_integrator_tool(opt, pf, grid);
+    auto tool = create_tool(opt, pf, context, grid);
     if (tool == nullptr) {
         return;
     }
+    // Drops what the tuning timed. Runs without TIMING leave the timers
+    // alone, so concurrent runs do not write to them
+    auto& timers = PhaseTimers::instance();
+    if (opt.timing()) {
+        timers.reset();
+    }
     if (opt.integrator_type() == "EULER") {
-        auto integrator
-            = EulerIntegrator<Grid, CartesianVariation>(opt, grid, tool, pf);
+        auto integrator = EulerIntegrator<Grid, CartesianVariation>(
+            opt, grid, tool, pf, context);
         integrator.run();
     }
     if (opt.integrator_type() == "RUNGE_KUTTA") {
         auto integrator = RungeKuttaIntegrator<Grid, CartesianVariation>(
-            opt, grid, tool, pf);
+            opt, grid, tool, pf, context);
         integrator.run();
     }
+    if (opt.integrator_type() == "ADAPTIVE_RUNGE_KUTTA") {
+        auto integrator = AdaptiveRungeKuttaIntegrator<Grid,
+            CartesianVariation>(opt, grid, tool, pf, context);
+        integrator.run();
+    }
+    if (opt.integrator_type() == "IMEX") {
+        auto integrator = ImexIntegrator<Grid, CartesianVariation>(
+            opt, grid, tool, pf, context);
+        integrator.run();
+    }
+    if (opt.integrator_type() == "JFNK") {
+        auto integrator = JfnkIntegrator<Grid, CartesianVariation>(
+            opt, grid, tool, pf, context);
+        integrator.run();
+    }
+    if (opt.timing()) {
+        report_timings(timers);
+    }
+    if (keep_final_values) {
+        final_values_c.resize(grid.nPointsTotal);
+        for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+            final_values_c[ind] = grid.values(ind);
+        }
+    }
+}
+
+template <typename Grid>
+std::shared_ptr<TimeIntegratorTool> Solver::create_tool(Options& opt,
+    PointFunctions& pf, const SolverContext& context, Grid& grid)
+{
+    auto tool = create_time_integrator_tool(opt, pf, context, grid);
+    if (tool == nullptr) {
+        return nullptr;
+    }
+    tool->set_traversal({opt.tile_rows(), opt.tile_cols(), 1});
+    if (opt.storage_rounding() == "SINGLE") {
+        tool->set_storage_rounding(true);
+        grid.round_to_single();
+    }
+    else if (opt.storage_rounding() != "NONE") {
+        std::cerr << "Storage rounding " << opt.storage_rounding()
+                  << " not found!!!" << std::endl;
+        throw(-1);
+    }
+    // Decomposed grids compute their interior by halo distance, not in tiles
+    if (opt.tile_autotune() and !grid.decomposition()) {
+        auto traversal = tune_traversal(tool.get(), grid);
+        std::cout << "Time derivative traversal: " << traversal << std::endl;
+    }
+    return tool;
+}
+
+template std::shared_ptr<TimeIntegratorTool> Solver::create_tool(
+    Options&, PointFunctions&, const SolverContext&, CartesianGrid&);
+template std::shared_ptr<TimeIntegratorTool> Solver::create_tool(
+    Options&, PointFunctions&, const SolverContext&, GhiasGrid&);
+template std::shared_ptr<TimeIntegratorTool> Solver::create_tool(
+    Options&, PointFunctions&, const SolverContext&, KaragiozisGrid&);
+template std::shared_ptr<TimeIntegratorTool> Solver::create_tool(
+    Options&, PointFunctions&, const SolverContext&, ShockGrid&);
+template std::shared_ptr<TimeIntegratorTool> Solver::create_tool(
+    Options&, PointFunctions&, const SolverContext&, GhiasShockGrid&);
+
+void Solver::check_decomposition_support(Options& opt)
+{
+    bool supported = true;
+    // Shocks move, merge and appear across blocks, and the GHIAS_SHOCK
+    // detector scales each grid line by its extremes over the whole line
+    auto solver = opt.solver_type();
+    if (solver == "SHOCK" or solver == "GHIAS_SHOCK") {
+        std::cerr << "Solver " << solver
+                  << " does not support domain decomposition" << std::endl;
+        supported = false;
+    }
+    auto integrator = opt.integrator_type();
+    if (integrator != "RUNGE_KUTTA" and integrator != "EULER") {
+        std::cerr << "Integrator " << integrator
+                  << " does not support domain decomposition" << std::endl;
+        supported = false;
+    }
+    if (opt.should_filter() or opt.residual_smoothing()) {
+        std::cerr << "Filters and residual smoothing do not support domain "
+                     "decomposition"
+                  << std::endl;
+        supported = false;
+    }
+    if (!supported) {
+        throw(-1);
+    }
+}
+
+void Solver::report_timings(const PhaseTimers& timers)
+{
+    timers.print_summary(std::cout);
+    auto json_file = opt.timing_json();
+    if (json_file == "NONE") {
+        return;
+    }
+    std::ofstream output(json_file);
+    if (!output.is_open()) {
+        std::cerr << "Could not open file " << json_file << std::endl;
+        return;
+    }
+    timers.write_json(output);
 }
@@ -1,25 +1,70 @@
 #ifndef SOLVER_HPP
 #define SOLVER_HPP
 
+#include "../utils/point_def.hpp"
 #include "../utils/point_functions.hpp"
+#include "../utils/solver_context.hpp"
 #include <memory>
+#include <vector>
 
 class Options;
 class Derivatives;
 class Convection;
 class Dissipation;
 class Boundary;
+class PhaseTimers;
+class TimeIntegratorTool;
 
 class Solver {
 public:
-    Solver(Options& opt_in);
+    /**
+     * @param keep_final_values_in Keeps a copy of the grid values when the
+     * run finishes, see final_values()
+     */
+    Solver(Options& opt_in, bool keep_final_values_in = false);
+    /**
+     * @brief Applies the process wide settings of opt (threads, affinity,
+     * memory placement, timers) and runs the case
+     */
     void run();
+    /**
+     * @brief Runs the case without touching the process wide settings.
+     * Solvers with their own Options can run their cases concurrently
+     * when TIMING is FALSE (see Ensemble)
+     */
+    void run_case();
+    /**
+     * @brief Sets threads, thread affinity and memory placement from opt
+     */
+    static void configure_process(Options& opt);
+    /**
+     * @brief Time integrator tool for grid, with the traversal and storage
+     * rounding of opt applied. Defined for the five grid types
+     *
+     * @return nullptr if the tool options are not supported
+     */
+    template <typename Grid>
+    static std::shared_ptr<TimeIntegratorTool> create_tool(Options& opt,
+        PointFunctions& pf, const SolverContext& context, Grid& grid);
+    /**
+     * @brief Stops runs on several processes that use features which do not
+     * work on a decomposed grid yet: shocks, whose points would have to move
+     * between blocks, the IMEX, JFNK and adaptive integrators, filters and
+     * residual smoothing
+     */
+    static void check_decomposition_support(Options& opt);
+
+    const std::vector<Point>& final_values() const { return final_values_c; }
 
 private:
     Options& opt;
     PointFunctions pf;
+    SolverContext context;
+    bool keep_final_values;
+    std::vector<Point> final_values_c;
     template <typename Grid>
     void setup_and_run();
+    void report_timings(const PhaseTimers& timers);
 };
 
 #endif /* SOLVER_HPP */
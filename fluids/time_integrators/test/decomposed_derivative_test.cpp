@@ -0,0 +1,71 @@
+#include "../../grid/cartesian_grid.hpp"
+#include "../../input_output/cases/canonical_cases.hpp"
+#include "../../input_output/options.hpp"
+#include "../../utils/parallel/communicator.hpp"
+#include "../../utils/point_functions.hpp"
+#include "../../utils/solver_context.hpp"
+#include "../../utils/timers/phase_timers.hpp"
+#include "../solver.hpp"
+#include "../time_integrator_tool.hpp"
+#include "../time_integrator_types.hpp"
+#include "gtest/gtest.h"
+
+#include <cerrno>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+
+TEST(DecomposedDerivativeTest, testOwnedPointsMatchTheWholeGrid)
+{
+    // Every process writes the case files of its own
+    auto directory
+        = "./decomposed_rank" + std::to_string(parallel::rank()) + "/";
+    ASSERT_TRUE(mkdir(directory.c_str(), 0755) == 0 or errno == EEXIST);
+    auto input = create_canonical_case("SHOCK_TUBE", 37, "SIMPLE");
+    std::istringstream config(write_case_input(input, directory)
+        + "OUTPUT_TYPE = NONE\nOUTPUT_BASE_PATH = " + directory + "\n");
+    Options opt(config);
+    PointFunctions pf(opt.mach(), opt.gam());
+    SolverContext context;
+    CartesianGrid grid(opt);
+    auto whole = CartesianGrid::whole_domain(opt);
+    ASSERT_TRUE(grid.decomposition() != nullptr);
+    auto& d = *grid.decomposition();
+    ASSERT_FALSE(d.inner_points().empty());
+    ASSERT_FALSE(d.outer_points().empty());
+    auto tool = Solver::create_tool(opt, pf, context, grid);
+    auto whole_tool = Solver::create_tool(opt, pf, context, whole);
+
+    auto& timers = PhaseTimers::instance();
+    for (bool timing : {false, true}) {
+        // Stale ghost points, which the halo exchange must refresh before
+        // the outer points read them
+        for (auto ind : d.ghost_points()) {
+            grid.set_values(Point(10.0, 1.0, 1.0, 100.0), ind);
+        }
+        timers.set_enabled(timing);
+        CartesianVariation var(grid.nPointsTotal);
+        CartesianVariation whole_var(whole.nPointsTotal);
+        tool->time_derivative(var, grid, 0.0);
+        whole_tool->time_derivative(whole_var, whole, 0.0);
+        timers.set_enabled(false);
+        for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+            if (!d.is_owned(ind)) {
+                continue;
+            }
+            auto& actual = var.grid_variation[ind];
+            auto& expected = whole_var.grid_variation[d.global_ind(ind)];
+            EXPECT_EQ(actual.rho, expected.rho) << "at " << ind;
+            EXPECT_EQ(actual.ru, expected.ru) << "at " << ind;
+            EXPECT_EQ(actual.rv, expected.rv) << "at " << ind;
+            EXPECT_EQ(actual.e, expected.e) << "at " << ind;
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    parallel::Environment environment;
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include "../../grid/ghias_grid.hpp"
+#include "../../grid/karagiozis_grid.hpp"
+#include "../../input_output/cases/canonical_cases.hpp"
+#include "../../input_output/options.hpp"
+#include "../../input_output/readers/reader.hpp"
+#include "../../utils/operators_overloads.hpp"
+#include "../../utils/parallel/communicator.hpp"
+#include "../../utils/point_functions.hpp"
+#include "../../utils/solver_context.hpp"
+#include "../grid_statistics.hpp"
+#include "../solver.hpp"
+#include "../time_integrator_tool.hpp"
+#include "../time_integrator_types.hpp"
+#include "gtest/gtest.h"
+
+#include <cerrno>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+
+namespace {
+/**
+ * @brief Advances the cylinder past the body with Euler steps on the block
+ * of this process and on the whole grid, and compares every owned point
+ * after each step
+ */
+template <typename Grid>
+void compare_with_whole_grid(const std::string& solver_type)
+{
+    // Every process writes the case files of its own
+    auto directory = "./interface_rank" + std::to_string(parallel::rank())
+        + "_" + solver_type + "/";
+    ASSERT_TRUE(mkdir(directory.c_str(), 0755) == 0 or errno == EEXIST);
+    auto input = create_canonical_case("CYLINDER", 37, solver_type);
+    std::istringstream config(write_case_input(input, directory)
+        + "OUTPUT_TYPE = NONE\nOUTPUT_BASE_PATH = " + directory + "\n");
+    Options opt(config);
+    PointFunctions pf(opt.mach(), opt.gam());
+    SolverContext context;
+    Grid grid(opt);
+    Grid whole(Reader(opt, false), opt);
+    ASSERT_TRUE(grid.decomposition() != nullptr);
+    auto& d = *grid.decomposition();
+    auto tool = Solver::create_tool(opt, pf, context, grid);
+    auto whole_tool = Solver::create_tool(opt, pf, context, whole);
+    EXPECT_EQ(std::lround(parallel::sum(revisit_count(grid))),
+        revisit_count(whole));
+
+    const double dt = 1e-4;
+    double t = 0.0;
+    for (int step = 0; step < 5; step++) {
+        CartesianVariation var(grid.nPointsTotal);
+        CartesianVariation whole_var(whole.nPointsTotal);
+        tool->time_derivative(var, grid, t);
+        whole_tool->time_derivative(whole_var, whole, t);
+        for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+            grid.set_values(
+                grid.values(ind) + dt * var.grid_variation[ind], ind);
+        }
+        for (int ind = 0; ind < whole.nPointsTotal; ind++) {
+            whole.set_values(
+                whole.values(ind) + dt * whole_var.grid_variation[ind], ind);
+        }
+        t += dt;
+        tool->update_values(&grid, t);
+        whole_tool->update_values(&whole, t);
+        for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+            if (!d.is_owned(ind)) {
+                continue;
+            }
+            auto actual = grid.values(ind);
+            auto expected = whole.values(d.global_ind(ind));
+            EXPECT_EQ(actual.rho(), expected.rho()) << "at " << ind;
+            EXPECT_EQ(actual.ru(), expected.ru()) << "at " << ind;
+            EXPECT_EQ(actual.rv(), expected.rv()) << "at " << ind;
+            EXPECT_EQ(actual.e(), expected.e()) << "at " << ind;
+        }
+    }
+}
+} // namespace
+
+TEST(DecomposedInterfaceTest, testGhiasBlocksMatchTheWholeGrid)
+{
+    compare_with_whole_grid<GhiasGrid>("GHIAS");
+}
+
+TEST(DecomposedInterfaceTest, testKaragiozisBlocksMatchTheWholeGrid)
+{
+    compare_with_whole_grid<KaragiozisGrid>("KARAGIOZIS");
+}
+
+int main(int argc, char** argv)
+{
+    parallel::Environment environment;
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
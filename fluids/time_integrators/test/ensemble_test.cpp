@@ -0,0 +1,86 @@
+#include "../../grid/cartesian_grid.hpp"
+#include "../../input_output/cases/canonical_cases.hpp"
+#include "../../input_output/options.hpp"
+#include "../../input_output/readers/default_reader.hpp"
+#include "../../utils/grid_components_container_def.hpp"
+#include "../../utils/grid_constants_container_def.hpp"
+#include "../ensemble.hpp"
+#include "gtest/gtest.h"
+
+#include <cerrno>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+namespace {
+/**
+ * @brief Configuration of a channel of n x n points written to directory,
+ * followed by the configuration lines in extra
+ */
+std::string channel_config(
+    int n, const std::string& directory, const std::string& extra)
+{
+    if (mkdir(directory.c_str(), 0755) != 0 and errno != EEXIST) {
+        throw(-1);
+    }
+    auto input = create_canonical_case("CHANNEL", n, "SIMPLE");
+    return write_case_input(input, directory) + "OUTPUT_TYPE = NONE\n"
+        + "OUTPUT_BASE_PATH = " + directory + "\n" + extra;
+}
+} // namespace
+
+TEST(EnsembleTest, testMembersSweepMachOutermost)
+{
+    auto members = Ensemble::members({"0.1", "0.2"}, {"10", "100", "1000"});
+    std::vector<std::string> names{"M0.1_Re10", "M0.1_Re100", "M0.1_Re1000",
+        "M0.2_Re10", "M0.2_Re100", "M0.2_Re1000"};
+    ASSERT_EQ(members.size(), names.size());
+    for (size_t m = 0; m < members.size(); m++) {
+        ASSERT_EQ(members[m].name, names[m]);
+        ASSERT_EQ(members[m].mach, m < 3 ? "0.1" : "0.2");
+        ASSERT_EQ(members[m].reynolds, names[m].substr(names[m].find('e') + 1));
+    }
+
+    auto single = Ensemble::members({"NONE"}, {"NONE"});
+    ASSERT_EQ(single.size(), 1u);
+    ASSERT_EQ(single[0].mach, "NONE");
+    ASSERT_EQ(single[0].reynolds, "NONE");
+}
+
+TEST(EnsembleTest, testFailedMemberIsIsolated)
+{
+    Ensemble ensemble(channel_config(8, "./ensemble_isolation/",
+        "ENSEMBLE = TRUE\nENSEMBLE_MACH = 0.1 abc 0.2\n"
+        "ENSEMBLE_CONCURRENCY = 2\nMAX_STEPS = 3\nT_MAX = 1e10\n"));
+    auto members = ensemble.run();
+    ASSERT_EQ(members.size(), 3u);
+    ASSERT_TRUE(members[0].finished);
+    ASSERT_FALSE(members[1].finished);
+    ASSERT_EQ(members[1].mach, "abc");
+    ASSERT_TRUE(members[2].finished);
+}
+
+TEST(EnsembleTest, testMembersShareTheTopology)
+{
+    std::istringstream config(channel_config(8, "./ensemble_topology/", ""));
+    Options input(config);
+    GridConstantsContainer constants;
+    GridComponentsContainer components;
+    default_reader(input, components, constants);
+    input.set_memory_input(constants, components);
+
+    Options first, second;
+    first.share_memory_input(input);
+    second.share_memory_input(input);
+    CartesianGrid first_grid(first);
+    CartesianGrid second_grid(second);
+    ASSERT_EQ(first_grid.topology(), input.memory_topology());
+    ASSERT_EQ(second_grid.topology(), input.memory_topology());
+    ASSERT_EQ(first_grid.flags_data(), second_grid.flags_data());
+    ASSERT_EQ(first_grid.boundary().size(), components.boundary_c.size());
+    // The values are the state of each member
+    ASSERT_NE(first_grid.values_data(), second_grid.values_data());
+    second_grid.setRho(2.0, 0);
+    ASSERT_NE(first_grid.rho(0), 2.0);
+}
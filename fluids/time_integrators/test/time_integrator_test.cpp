@@ -1,39 +1,332 @@
+#include "../../boundary/boundary.hpp"
+#include "../../derivatives/derivatives_factory.hpp"
+#include "../../grid/cartesian_grid.hpp"
+#include "../../grid/karagiozis_grid.hpp"
+#include "../../grid/shock_grid.hpp"
+#include "../../input_output/cases/canonical_cases.hpp"
+#include "../../input_output/options.hpp"
+#include "../../input_output/writers/compressed_writer.hpp"
+#include "../../reconstructions/abstract_convection.hpp"
+#include "../../reconstructions/abstract_dissipation.hpp"
+#include "../../reconstructions/convection_factory.hpp"
+#include "../../reconstructions/dissipation_factory.hpp"
+#include "../../utils/operators_overloads.hpp"
+#include "../../utils/point_functions.hpp"
+#include "../../utils/solver_context.hpp"
+#include "../../utils/timers/phase_timers.hpp"
+#include "../adaptive_runge_kutta_integrator.hpp"
+#include "../jfnk_integrator.hpp"
+#include "../runge_kutta_integrator.hpp"
+#include "../solver.hpp"
+#include "../time_integrator_types.hpp"
 #include "gtest/gtest.h"
+#include <omp.h>
 
-#include <iostream>
+#include <cerrno>
 #include <memory>
+#include <set>
 #include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
 
-#include "../../boundary/boundary.hpp"
-#include "../../derivatives/regular_derivatives.hpp"
-#include "../../grid/test/cartesian_grid_test_interface.hpp"
-#include "sample_inputs.inc"
-
-class TimeIntegratorTest : public testing::Test {
-protected:
-    virtual void SetUp()
-    {
-
-        std::istringstream initial_conditions(initial_conditions_sample);
-        std::istringstream mesh_details(grid_info_sample);
-        std::istringstream boundary_file(boundary_sample);
-        Options opt;
-
-        grid = std::make_shared<CartesianGridTestInterface>(opt,
-            std::move(initial_conditions), std::move(mesh_details),
-            std::move(boundary_file));
-        pf = std::make_shared<PointFunctions>(opt.mach(), opt.gam());
-        der = std::make_shared<RegularDerivatives>(
-            *pf, grid->shiftX(), grid->shiftY(), grid->dx, grid->dy);
-        boundary = std::make_shared<Boundary>(*pf, *der);
-        nPointsTotal = grid->nPointsTotal;
-        nPointsI = grid->nPointsI;
-        nPointsJ = grid->nPointsJ;
-    }
-    std::shared_ptr<CartesianGridTestInterface> grid;
-    std::shared_ptr<RegularDerivatives> der;
-    std::shared_ptr<PointFunctions> pf;
-    std::shared_ptr<Boundary> boundary;
-    int nPointsI, nPointsJ, nPointsTotal;
-    Flux result;
-};
+namespace {
+/**
+ * @brief Options of a canonical case of n x n points, written to its own
+ * directory, followed by the configuration lines in extra. shock replaces
+ * the shock file of the case if not empty
+ */
+std::unique_ptr<Options> case_options(const std::string& case_name, int n,
+    const std::string& solver_type, const std::string& extra,
+    const std::string& shock = "")
+{
+    auto directory = "./" + case_name + "_" + solver_type + "_"
+        + std::to_string(n) + "/";
+    if (mkdir(directory.c_str(), 0755) != 0 and errno != EEXIST) {
+        throw(-1);
+    }
+    auto input = create_canonical_case(case_name, n, solver_type);
+    if (!shock.empty()) {
+        input.shock = shock;
+    }
+    std::istringstream config(write_case_input(input, directory)
+        + "OUTPUT_TYPE = NONE\n"
+        + "OUTPUT_BASE_PATH = " + directory + "\n"
+        + "T_MAX = 1e10\n"
+        + "PRINT_INTERVAL = 1e10\n" + extra);
+    return std::make_unique<Options>(config);
+}
+
+/**
+ * @brief Shock file of a fitted shock across the middle of the shock tube,
+ * between the Sod states
+ */
+std::string shock_tube_shock(int n, double gam)
+{
+    double p0 = 1 / gam;
+    Point left(1.0, 0.0, 0.0, p0 / (gam - 1));
+    Point right(0.125, 0.0, 0.0, 0.1 * p0 / (gam - 1));
+    std::ostringstream os;
+    os << "SHOCK\n" << n - 2 << "\n";
+    for (int i = 1; i < n - 1; i++) {
+        os << "x " << i << " " << n / 2 - 1 << " 0.5 " << left << " " << right
+           << "\n";
+    }
+    return os.str();
+}
+
+/**
+ * @brief Values and shock points of grid, leaving out the output counter
+ */
+std::string values_and_shocks(ShockGrid& grid)
+{
+    std::ostringstream os;
+    grid.KaragiozisGrid::save_state(os);
+    for (auto& sp : grid.shock_points()) {
+        sp.save_state(os);
+    }
+    return os.str();
+}
+
+/**
+ * @brief Time derivative of grid computed by tool on threads threads, with
+ * the phase timers (and so the separate convection and dissipation passes)
+ * on or off
+ */
+template <typename Grid>
+std::vector<Flux> derivative(
+    TimeIntegratorTool& tool, const Grid& grid, int threads, bool timing)
+{
+#ifndef DEBUG
+    int max_threads = omp_get_max_threads();
+    omp_set_num_threads(threads);
+#endif
+    auto& timers = PhaseTimers::instance();
+    bool enabled = timers.enabled();
+    timers.set_enabled(timing);
+    CartesianVariation var(grid.nPointsTotal);
+    tool.time_derivative(var, grid, 0.0);
+    timers.set_enabled(enabled);
+#ifndef DEBUG
+    omp_set_num_threads(max_threads);
+#endif
+    return {var.grid_variation.begin(), var.grid_variation.end()};
+}
+
+void expect_same_derivative(
+    const std::vector<Flux>& actual, const std::vector<Flux>& expected)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t ind = 0; ind < expected.size(); ind++) {
+        EXPECT_EQ(actual[ind].rho, expected[ind].rho) << "at " << ind;
+        EXPECT_EQ(actual[ind].ru, expected[ind].ru) << "at " << ind;
+        EXPECT_EQ(actual[ind].rv, expected[ind].rv) << "at " << ind;
+        EXPECT_EQ(actual[ind].e, expected[ind].e) << "at " << ind;
+    }
+}
+
+/**
+ * @brief Time derivative the way it was computed before the irregular work
+ * overlapped the interior: every point by the regular scheme in index
+ * order, then the points to revisit by the irregular scheme, then the
+ * boundary points
+ */
+std::vector<Flux> sequential_derivative(Options& opt, PointFunctions& pf,
+    const SolverContext& context, CartesianGrid& grid,
+    const std::set<int>& revisit)
+{
+    auto der = create_derivative("REGULAR", pf, grid, opt.derivative_order());
+    auto conv = create_convection(opt, pf, context, der);
+    auto diss = create_dissipation(opt, pf, der);
+    auto der_irreg
+        = revisit.empty() ? der : create_derivative("KARAGIOZIS", pf, grid);
+    auto conv_irreg = create_convection(opt, pf, context, der_irreg);
+    auto diss_irreg = create_dissipation(opt, pf, der_irreg);
+    Boundary boundary(pf, context, der_irreg, opt.reynolds(), opt.prandtl());
+    conv->init(grid);
+    conv_irreg->init(grid);
+    auto scheme = [&](const Convection& c, const Dissipation& d, int ind) {
+        return c.convection_x(grid, ind) + c.convection_y(grid, ind)
+            + d.dissipation_x(grid, ind) + d.dissipation_y(grid, ind);
+    };
+    std::vector<Flux> values(grid.nPointsTotal);
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        values[ind] = scheme(*conv, *diss, ind);
+    }
+    for (auto ind : revisit) {
+        values[ind] = scheme(*conv_irreg, *diss_irreg, ind);
+    }
+    for (auto& bp : grid.boundary()) {
+        Flux value = bp.x_boundary
+            ? boundary.convection_x(grid, bp, 0.0)
+                + boundary.dissipation_x(grid, bp)
+            : conv_irreg->convection_x(grid, bp.ind)
+                + diss_irreg->dissipation_x(grid, bp.ind);
+        value += bp.y_boundary ? boundary.convection_y(grid, bp, 0.0)
+                + boundary.dissipation_y(grid, bp)
+                               : conv_irreg->convection_y(grid, bp.ind)
+                + diss_irreg->dissipation_y(grid, bp.ind);
+        values[bp.ind] = value;
+    }
+    return values;
+}
+
+/**
+ * @brief The derivative of the tool, with the revisit and boundary tasks
+ * running beside the interior, computed by one thread in rows and by
+ * several threads in tiles that do not divide the grid, against the
+ * sequential one
+ */
+template <typename Grid>
+void expect_overlap_matches_sequential(
+    Options& opt, Grid& grid, const std::set<int>& revisit)
+{
+    PointFunctions pf(opt.mach(), opt.gam());
+    SolverContext context;
+    auto tool = Solver::create_tool(opt, pf, context, grid);
+    auto sequential = sequential_derivative(opt, pf, context, grid, revisit);
+    tool->set_traversal({grid.nPointsI, 0, 1});
+    expect_same_derivative(derivative(*tool, grid, 1, false), sequential);
+    tool->set_traversal({5, 7, 2});
+    expect_same_derivative(derivative(*tool, grid, 4, false), sequential);
+    expect_same_derivative(derivative(*tool, grid, 4, true), sequential);
+}
+
+/**
+ * @brief Options of the shock tube with a fitted shock, integrated by the
+ * adaptive Runge-Kutta method
+ */
+std::unique_ptr<Options> adaptive_options(int n, const std::string& extra)
+{
+    return case_options("SHOCK_TUBE", n, "SHOCK",
+        "INTEGRATOR_TYPE = ADAPTIVE_RUNGE_KUTTA\n" + extra,
+        shock_tube_shock(n, 1.4));
+}
+} // namespace
+
+TEST(TimeIntegratorTest, testLocalStepsEqualGlobalStepOnUniformFlow)
+{
+    // The channel starts from the inflow state everywhere
+    auto opt = case_options("CHANNEL", 16, "SIMPLE",
+        "STEADY_STATE = TRUE\nLOCAL_TIME_STEPPING = TRUE\n");
+    PointFunctions pf(opt->mach(), opt->gam());
+    SolverContext context;
+    CartesianGrid grid(*opt);
+    RungeKuttaIntegrator<CartesianGrid, CartesianVariation> integrator(*opt,
+        grid, Solver::create_tool(*opt, pf, context, grid), pf, context);
+    integrator.start();
+    integrator.step();
+
+    auto& local = integrator.local_steps();
+    ASSERT_EQ(local.size(), static_cast<size_t>(grid.nPointsTotal));
+    ASSERT_GT(integrator.step_size(), 0.0);
+    for (auto h : local) {
+        ASSERT_EQ(h, integrator.step_size());
+    }
+}
+
+TEST(TimeIntegratorTest, testRunStoppedByMaxStepsEndsAtTheTimeReached)
+{
+    for (std::string integrator :
+        {"EULER", "RUNGE_KUTTA", "IMEX", "ADAPTIVE_RUNGE_KUTTA"}) {
+        auto opt = case_options("CHANNEL", 16, "SIMPLE",
+            "INTEGRATOR_TYPE = " + integrator
+                + "\nOUTPUT_TYPE = COMPRESSED\nMAX_STEPS = 2\n");
+        Solver solver(*opt);
+        solver.run_case();
+        // The initial output, then the final one
+        auto snapshot = read_compressed_snapshot(
+            opt->output_file_name() + "_00000001.tfz");
+        EXPECT_GT(snapshot.t, 0.0) << integrator;
+        EXPECT_LT(snapshot.t, 0.1) << integrator;
+    }
+}
+
+TEST(TimeIntegratorTest, testJfnkRetriesFromTheRejectedState)
+{
+    // At CFL 1000 the first Newton update of the shock tube is not physical
+    auto opt = case_options("SHOCK_TUBE", 16, "SIMPLE",
+        "INTEGRATOR_TYPE = JFNK\nCFL = 1e3\nJFNK_MAX_CFL = 1e6\n"
+        "JFNK_MAX_ITERATIONS = 10\n");
+    PointFunctions pf(opt->mach(), opt->gam());
+    SolverContext context;
+    CartesianGrid grid(*opt);
+    JfnkIntegrator<CartesianGrid, CartesianVariation> integrator(*opt, grid,
+        Solver::create_tool(*opt, pf, context, grid), pf, context);
+    integrator.run();
+
+    // A retry that kept the rejected correction would not recover
+    ASSERT_GT(integrator.retries(), 0);
+    ASSERT_EQ(integrator.iterations(), 10);
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        ASSERT_GT(grid.values(ind).rho(), 0.0);
+    }
+}
+
+TEST(TimeIntegratorTest, testAdaptiveRejectionRestoresTheGrid)
+{
+    const int n = 32;
+    auto opt = adaptive_options(n, "");
+    PointFunctions pf(opt->mach(), opt->gam());
+    SolverContext context;
+    ShockGrid grid(*opt);
+    ASSERT_EQ(grid.shock_points().size(), static_cast<size_t>(n - 2));
+    auto tool = Solver::create_tool(*opt, pf, context, grid);
+    auto before = values_and_shocks(grid);
+
+    // No step meets these tolerances
+    const std::string strict = "ADAPTIVE_RTOL = 1e-14\nADAPTIVE_ATOL = 1e-14\n";
+    auto once = adaptive_options(n, strict + "ADAPTIVE_MAX_REJECTIONS = 0\n");
+    AdaptiveRungeKuttaIntegrator<ShockGrid, CartesianVariation> first(
+        *once, grid, tool, pf, context);
+    first.run();
+    ASSERT_EQ(first.steps(), 0);
+    ASSERT_EQ(first.rejections(), 1);
+    ASSERT_EQ(values_and_shocks(grid), before);
+
+    auto thrice = adaptive_options(n, strict + "ADAPTIVE_MAX_REJECTIONS = 3\n");
+    AdaptiveRungeKuttaIntegrator<ShockGrid, CartesianVariation> retried(
+        *thrice, grid, tool, pf, context);
+    retried.run();
+    ASSERT_EQ(retried.steps(), 0);
+    ASSERT_EQ(retried.rejections(), 4);
+    ASSERT_EQ(values_and_shocks(grid), before);
+    // Every rejection takes the smallest factor the controller allows
+    double dt = first.step_size();
+    ASSERT_DOUBLE_EQ(retried.step_size(), dt * 0.2 * 0.2 * 0.2);
+}
+
+TEST(TimeIntegratorTest, testAdaptiveStepGrowsWithinControllerLimits)
+{
+    const int n = 32;
+    auto opt = adaptive_options(
+        n, "ADAPTIVE_RTOL = 1\nADAPTIVE_ATOL = 1\nMAX_STEPS = 1\n");
+    PointFunctions pf(opt->mach(), opt->gam());
+    SolverContext context;
+    ShockGrid grid(*opt);
+    AdaptiveRungeKuttaIntegrator<ShockGrid, CartesianVariation> integrator(
+        *opt, grid, Solver::create_tool(*opt, pf, context, grid), pf, context);
+    integrator.run();
+
+    ASSERT_EQ(integrator.steps(), 1);
+    ASSERT_EQ(integrator.rejections(), 0);
+    // The error is far below the tolerance, so the growth is capped at 5
+    ASSERT_DOUBLE_EQ(
+        integrator.proposed_step_size(), 5 * integrator.step_size());
+}
+
+TEST(TimeIntegratorTest, testOverlappedDerivativeMatchesSequentialOne)
+{
+    auto opt = case_options("SHOCK_TUBE", 33, "SIMPLE", "");
+    CartesianGrid grid(*opt);
+    ASSERT_FALSE(grid.boundary().empty());
+    expect_overlap_matches_sequential(*opt, grid, {});
+}
+
+TEST(TimeIntegratorTest, testOverlappedRevisitMatchesSequentialOne)
+{
+    auto opt = case_options("CYLINDER", 33, "KARAGIOZIS", "");
+    KaragiozisGrid grid(*opt);
+    ASSERT_FALSE(grid.to_revisit().empty());
+    expect_overlap_matches_sequential(*opt, grid, grid.to_revisit());
+}
@@ -0,0 +1,81 @@
+#include "../traversal.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+namespace {
+/**
+ * @brief Checks that the tiles of traversal over a nPointsI x nPointsJ grid
+ * visit every point exactly once
+ */
+void expect_every_point_once(
+    int nPointsI, int nPointsJ, const Traversal& traversal, int threads)
+{
+    if (!grid_shape::fits(nPointsI, nPointsJ)) {
+        return;
+    }
+    int total = nPointsI * grid_shape::columns(nPointsJ);
+    Tiling tiling(nPointsI, nPointsJ, traversal, threads);
+    std::vector<int> visits(total, 0);
+    auto visit = [&](int ind) {
+        ASSERT_GE(ind, 0);
+        ASSERT_LT(ind, total);
+        visits[ind]++;
+    };
+    for (int tile = 0; tile < tiling.count(); tile++) {
+        tiling.visit(tile, visit);
+    }
+    for (int i = 0; i < nPointsI; i++) {
+        for (int j = 0; j < nPointsJ; j++) {
+            EXPECT_EQ(visits[i * grid_shape::columns(nPointsJ) + j], 1)
+                << nPointsI << "x" << nPointsJ << " grid, " << traversal
+                << ", point " << i << "," << j;
+        }
+    }
+}
+} // namespace
+
+TEST(TraversalTest, testTilesDividingTheGrid)
+{
+    expect_every_point_once(32, 64, {8, 16, 1}, 4);
+    expect_every_point_once(32, 64, {32, 64, 1}, 4);
+}
+
+TEST(TraversalTest, testTilesNotDividingTheGrid)
+{
+    expect_every_point_once(33, 29, {5, 7, 2}, 4);
+    expect_every_point_once(33, 29, {16, 64, 1}, 4);
+    expect_every_point_once(100, 37, {64, 36, 4}, 3);
+}
+
+TEST(TraversalTest, testOddSizes)
+{
+    for (int n : {1, 3, 7, 31}) {
+        expect_every_point_once(n, 2 * n + 1, {3, 5, 1}, 2);
+        expect_every_point_once(2 * n + 1, n, {0, 0, 1}, 5);
+    }
+}
+
+TEST(TraversalTest, testOneWideTiles)
+{
+    expect_every_point_once(9, 13, {1, 1, 1}, 4);
+    expect_every_point_once(9, 13, {1, 0, 1}, 4);
+    expect_every_point_once(9, 13, {0, 1, 1}, 4);
+    expect_every_point_once(1, 13, {4, 4, 1}, 1);
+    expect_every_point_once(13, 1, {4, 4, 1}, 1);
+}
+
+TEST(TraversalTest, testCandidates)
+{
+    for (auto& traversal : traversal_candidates(70, 300)) {
+        expect_every_point_once(70, 300, traversal, 4);
+    }
+}
+
+TEST(TraversalTest, testAutomaticRows)
+{
+    for (int threads : {1, 2, 7, 64}) {
+        expect_every_point_once(257, 129, {0, 0, 1}, threads);
+        expect_every_point_once(257, 129, {0, 50, 1}, threads);
+    }
+}
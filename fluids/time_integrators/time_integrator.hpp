@@ -0,0 +1,294 @@
+#ifndef TIME_INTEGRATOR_HPP
+#define TIME_INTEGRATOR_HPP
+
+#include "../input_output/checkpoint/checkpoint.hpp"
+#include "../input_output/writers/output_manager.hpp"
+#include "../input_output/writers/step_log.hpp"
+#include "../utils/parallel/communicator.hpp"
+#include "../utils/point_functions.hpp"
+#include "../utils/residual_norms.hpp"
+#include "../utils/solver_context.hpp"
+#include "../utils/timers/phase_timers.hpp"
+#include "grid_statistics.hpp"
+#include "time_integrator_tool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * \class TimeIntegrator
+ * @brief What the integrators share: the stable step, the start and the end
+ * of a run, and the updates, output, checkpoints and step log that close
+ * every step
+ *
+ * get_dt is the explicit step at the CFL option, limited by convection and,
+ * unless viscous_limit is cleared, by the viscous terms, then by the speed
+ * of the shocks on shock fitting grids. It also finds the wave speeds the
+ * boundaries read from the context and stops the run on NaN. Integrators
+ * that need the step of each point size local_dt, which get_dt then fills.
+ */
+template <typename Grid>
+class TimeIntegrator {
+protected:
+    /**
+     * @param always_steady Runs to a steady state whatever STEADY_STATE is
+     */
+    TimeIntegrator(Options& opt_in, Grid& grid_in,
+        std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in,
+        SolverContext& context_in, bool always_steady = false);
+
+    std::shared_ptr<TimeIntegratorTool> tool;
+    Grid& grid;
+    PointFunctions& pf;
+    SolverContext& context;
+    const double initial_time;
+    const double final_time;
+    const double cfl;
+    const long max_steps;
+    const double reynolds;
+    OutputManager output;
+    Checkpointer checkpointer;
+    std::shared_ptr<StepLog> step_log;
+    SteadyStateMonitor steady;
+    bool found_nan;
+
+    /**
+     * @name Limits of get_dt
+     * @{ */
+    bool viscous_limit; ///< False when the dissipation is implicit
+    double dt_cfl;      ///< Factor of the steps, cfl unless changed
+    std::vector<double> local_dt; ///< Step of each point, if sized
+    /**  @} */
+
+    double get_dt(const CartesianGrid& grid_in);
+    double get_dt(const ShockGrid& grid_in);
+
+    /**
+     * @brief Restores the restart checkpoint or writes the initial output
+     *
+     * @param step Receives the step number to start from
+     * @return Time to start from
+     */
+    double start_run(long& step);
+    void print_progress(long step, double t, double dt) const;
+    void log_step(
+        long step, double t, double dt, const ResidualNorms& norms) const;
+    /**
+     * @brief Applies the boundary conditions and grid updates to the new
+     * state of the grid, then writes the output and checkpoint due at t + dt
+     *
+     * @param step Step just taken, incremented
+     * @return Whether t + dt is a print time
+     */
+    bool end_step(double t, double dt, long& step);
+    /**
+     * @brief Feeds the residual of the step to the steady state monitor and
+     * reports when it is reached
+     */
+    bool steady_state_reached(const ResidualNorms& norms, double t, long step);
+    /**
+     * @brief Writes the final output and flushes the step log
+     *
+     * @param end_time Time the run reached, T_MAX only if it got there
+     */
+    void finish_run(double end_time);
+};
+
+template <typename Grid>
+TimeIntegrator<Grid>::TimeIntegrator(Options& opt_in, Grid& grid_in,
+    std::shared_ptr<TimeIntegratorTool> tool_in, PointFunctions& pf_in,
+    SolverContext& context_in, bool always_steady)
+    : tool(std::move(tool_in))
+    , grid(grid_in)
+    , pf(pf_in)
+    , context(context_in)
+    , initial_time(opt_in.t_init())
+    , final_time(opt_in.t_max())
+    , cfl(opt_in.cfl())
+    , max_steps(opt_in.max_steps())
+    , reynolds(opt_in.reynolds())
+    , output(opt_in)
+    , checkpointer(opt_in)
+    , step_log(std::make_shared<StepLog>(opt_in))
+    , steady(always_steady or opt_in.steady_state(),
+          opt_in.steady_residual_drop(), opt_in.steady_plateau_steps(),
+          opt_in.steady_plateau_tolerance())
+    , found_nan(false)
+    , viscous_limit(true)
+    , dt_cfl(cfl)
+{
+}
+
+template <typename Grid>
+double TimeIntegrator<Grid>::start_run(long& step)
+{
+    if (checkpointer.restart_requested()) {
+        return checkpointer.load(grid, output, step);
+    }
+    output.write_all(grid, initial_time);
+    grid.specific_print();
+    return initial_time;
+}
+
+template <typename Grid>
+void TimeIntegrator<Grid>::print_progress(long step, double t, double dt) const
+{
+    if (step_log->progress_due(step)) {
+        std::cout << std::scientific << "\r\bt=" << t << " dt=" << dt
+                  << std::flush;
+    }
+}
+
+template <typename Grid>
+void TimeIntegrator<Grid>::log_step(
+    long step, double t, double dt, const ResidualNorms& norms) const
+{
+    if (step_log->due(step)) {
+        // Each process revisits the points it owns
+        long revisits = revisit_count(grid);
+        if (grid.decomposition()) {
+            revisits = std::lround(parallel::sum(revisits));
+        }
+        step_log->record({step, t, dt, context.max_mach_number,
+            context.max_u_plus_c, context.max_v_plus_c, shock_count(grid),
+            revisits, norms});
+    }
+}
+
+template <typename Grid>
+bool TimeIntegrator<Grid>::end_step(double t, double dt, long& step)
+{
+    tool->update_values(&grid, t + dt);
+    {
+        ScopedPhaseTimer timer(TimerPhase::PosUpdate);
+        grid.grid_specific_pos_update(dt);
+    }
+    bool printed;
+    {
+        ScopedPhaseTimer timer(TimerPhase::Output);
+        printed = output.write_due(grid, t + dt);
+        if (printed) {
+            grid.specific_print();
+        }
+    }
+    {
+        ScopedPhaseTimer timer(TimerPhase::Checkpoint);
+        checkpointer.save_if_due(grid, output, t + dt, ++step);
+    }
+    PhaseTimers::instance().end_step(grid.nPointsTotal);
+    return printed;
+}
+
+template <typename Grid>
+bool TimeIntegrator<Grid>::steady_state_reached(
+    const ResidualNorms& norms, double t, long step)
+{
+    if (!steady.update(norms)) {
+        return false;
+    }
+    std::cout << std::endl
+              << "Steady state at t=" << t << " after " << step
+              << " steps: " << steady.reason() << std::endl;
+    return true;
+}
+
+template <typename Grid>
+void TimeIntegrator<Grid>::finish_run(double end_time)
+{
+    output.write_all(grid, end_time);
+    step_log->flush();
+}
+
+template <typename Grid>
+double TimeIntegrator<Grid>::get_dt(const CartesianGrid& grid_in)
+{
+    double dt = 1e10;
+    double max_mach_number = 0.0, max_u_plus_c = 0.0, max_v_plus_c = 0.0;
+    bool fill_local = !local_dt.empty();
+#ifndef DEBUG
+#pragma omp parallel for reduction(                                            \
+    min : dt), reduction(max : max_mach_number, max_u_plus_c, max_v_plus_c)
+#endif
+    for (int ind = 0; ind < grid_in.nPointsTotal; ind++) {
+        if (!grid_in.is_owned(ind)) {
+            continue;
+        }
+        auto point = grid.values(ind);
+        double c = pf.sound_speed(point);
+        double u = fabs(pf.u(point));
+        double v = fabs(pf.v(point));
+        const double dx = grid.dx;
+        const double dy = grid.dy;
+        double new_dt = viscous_limit
+            ? 1 / 2.
+                * std::min({dx / (u + c), dy / (v + c),
+                    dx * dx * reynolds / 2., dy * dy * reynolds / 2.})
+            : 1 / 2. * std::min(dx / (u + c), dy / (v + c));
+        if (new_dt < dt) {
+            dt = new_dt;
+        }
+        if (fill_local) {
+            local_dt[ind] = dt_cfl * new_dt;
+        }
+        auto new_mach = pf.mach_number(point);
+        if (max_mach_number < new_mach) {
+            max_mach_number = new_mach;
+        }
+        auto new_u_plus_c = u + c;
+        if (max_u_plus_c < new_u_plus_c) {
+            max_u_plus_c = new_u_plus_c;
+        }
+        auto new_v_plus_c = v + c;
+        if (max_v_plus_c < new_v_plus_c) {
+            max_v_plus_c = new_v_plus_c;
+        }
+        if (point.rho() != point.rho() || point.ru() != point.ru()
+            || point.rv() != point.rv() || point.e() != point.e()) {
+            found_nan = true;
+            std::cout << std::endl
+                      << "NaN found at ind=" << ind << " x=" << grid.X(ind)
+                      << " y=" << grid.Y(ind) << std::endl;
+        }
+    }
+    if (grid_in.decomposition()) {
+        dt = parallel::min(dt);
+        max_mach_number = parallel::max(max_mach_number);
+        max_u_plus_c = parallel::max(max_u_plus_c);
+        max_v_plus_c = parallel::max(max_v_plus_c);
+        found_nan = parallel::any(found_nan);
+    }
+    if (max_mach_number > 1) {
+        max_mach_number = 1;
+    }
+    context.max_mach_number = max_mach_number;
+    context.max_u_plus_c = max_u_plus_c;
+    context.max_v_plus_c = max_v_plus_c;
+    return dt_cfl * dt;
+}
+
+template <typename Grid>
+double TimeIntegrator<Grid>::get_dt(const ShockGrid& grid_in)
+{
+    auto dt = get_dt(dynamic_cast<const CartesianGrid&>(grid_in));
+    for (auto& sp : grid.shock_points()) {
+        double shock_dt;
+        if (sp.is_x()) {
+            shock_dt = fabs(grid.dx * cos(sp.theta) / sp.w);
+        }
+        else {
+            shock_dt = fabs(grid.dy * sin(sp.theta) / sp.w);
+        }
+        if (dt > shock_dt) {
+            dt = shock_dt * dt_cfl;
+        }
+    }
+    // Shocks move with the global step, so no point may outrun them
+    for (auto& local : local_dt) {
+        local = std::min(local, dt);
+    }
+    return dt;
+}
+#endif /* TIME_INTEGRATOR_HPP */
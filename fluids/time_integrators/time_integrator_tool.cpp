@@ -5,10 +5,248 @@
 #include "../grid/karagiozis_grid.hpp"
 #include "../reconstructions/abstract_convection.hpp"
 #include "../reconstructions/abstract_dissipation.hpp"
+#include "../utils/parallel/communicator.hpp"
+#include "../utils/parallel/halo_exchange.hpp"
+#include "../utils/timers/phase_timers.hpp"
 #include "time_integrator_types.hpp"
 #include <omp.h>
 
+#include <algorithm>
+#include <cmath>
+#include <set>
 #include <utility>
+#include <vector>
+
+namespace {
+Flux interior_x(const Convection& conv, const Dissipation& diss,
+    const CartesianGrid& grid, int ind, DerivativeTerms terms)
+{
+    switch (terms) {
+    case DerivativeTerms::Convection:
+        return conv.convection_x(grid, ind);
+    case DerivativeTerms::Dissipation:
+        return diss.dissipation_x(grid, ind);
+    default:
+        return conv.convection_x(grid, ind) + diss.dissipation_x(grid, ind);
+    }
+}
+
+Flux interior_y(const Convection& conv, const Dissipation& diss,
+    const CartesianGrid& grid, int ind, DerivativeTerms terms)
+{
+    switch (terms) {
+    case DerivativeTerms::Convection:
+        return conv.convection_y(grid, ind);
+    case DerivativeTerms::Dissipation:
+        return diss.dissipation_y(grid, ind);
+    default:
+        return conv.convection_y(grid, ind) + diss.dissipation_y(grid, ind);
+    }
+}
+
+Flux interior(const Convection& conv, const Dissipation& diss,
+    const CartesianGrid& grid, int ind, DerivativeTerms terms)
+{
+    switch (terms) {
+    case DerivativeTerms::Convection:
+        return conv.convection_x(grid, ind) + conv.convection_y(grid, ind);
+    case DerivativeTerms::Dissipation:
+        return diss.dissipation_x(grid, ind) + diss.dissipation_y(grid, ind);
+    default:
+        return conv.convection_x(grid, ind) + conv.convection_y(grid, ind)
+            + diss.dissipation_x(grid, ind) + diss.dissipation_y(grid, ind);
+    }
+}
+
+Flux boundary_x(const Boundary& boundary, const CartesianGrid& grid,
+    const BoundaryPoint& bp, double t, DerivativeTerms terms)
+{
+    switch (terms) {
+    case DerivativeTerms::Convection:
+        return boundary.convection_x(grid, bp, t);
+    case DerivativeTerms::Dissipation:
+        return boundary.dissipation_x(grid, bp);
+    default:
+        return boundary.convection_x(grid, bp, t)
+            + boundary.dissipation_x(grid, bp);
+    }
+}
+
+Flux boundary_y(const Boundary& boundary, const CartesianGrid& grid,
+    const BoundaryPoint& bp, double t, DerivativeTerms terms)
+{
+    switch (terms) {
+    case DerivativeTerms::Convection:
+        return boundary.convection_y(grid, bp, t);
+    case DerivativeTerms::Dissipation:
+        return boundary.dissipation_y(grid, bp);
+    default:
+        return boundary.convection_y(grid, bp, t)
+            + boundary.dissipation_y(grid, bp);
+    }
+}
+
+/**
+ * @brief Boundary scheme in the boundary direction(s) of bp and interior
+ * scheme of conv and diss in the other one
+ */
+Flux boundary_point(const Boundary& boundary, const Convection& conv,
+    const Dissipation& diss, const CartesianGrid& grid,
+    const BoundaryPoint& bp, double t, DerivativeTerms terms)
+{
+    Flux value = bp.x_boundary
+        ? boundary_x(boundary, grid, bp, t, terms)
+        : interior_x(conv, diss, grid, bp.ind, terms);
+    value += bp.y_boundary ? boundary_y(boundary, grid, bp, t, terms)
+                           : interior_y(conv, diss, grid, bp.ind, terms);
+    return value;
+}
+
+/**
+ * @brief Time derivative of every boundary point, in the order of
+ * grid.boundary()
+ */
+void boundary_points(const Boundary& boundary, const Convection& conv,
+    const Dissipation& diss, const CartesianGrid& grid, double t,
+    DerivativeTerms terms, std::vector<Flux>* values)
+{
+    ScopedPhaseTimer timer(TimerPhase::BoundaryPoints);
+    auto& points = grid.boundary();
+    values->resize(points.size());
+    for (size_t k = 0; k < points.size(); k++) {
+        (*values)[k]
+            = boundary_point(boundary, conv, diss, grid, points[k], t, terms);
+    }
+}
+
+/**
+ * @brief Time derivative of the points close to discontinuities, in the
+ * order of the set
+ */
+void revisit_points(const Convection& conv, const Dissipation& diss,
+    const CartesianGrid& grid, const std::set<int>& points,
+    DerivativeTerms terms, std::vector<Flux>* values)
+{
+    ScopedPhaseTimer timer(TimerPhase::IrregularPoints);
+    values->resize(points.size());
+    size_t k = 0;
+    for (auto ind : points) {
+        (*values)[k++] = interior(conv, diss, grid, ind, terms);
+    }
+}
+
+void copy_boundary_values(const CartesianGrid& grid,
+    const std::vector<Flux>& values, CartesianVariation* var)
+{
+    auto& points = grid.boundary();
+    for (size_t k = 0; k < points.size(); k++) {
+        var->grid_variation[points[k].ind] = values[k];
+    }
+}
+
+void copy_revisit_values(const std::set<int>& points,
+    const std::vector<Flux>& values, CartesianVariation* var)
+{
+    size_t k = 0;
+    for (auto ind : points) {
+        var->grid_variation[ind] = values[k++];
+    }
+}
+
+/**
+ * @brief Interior scheme of conv and diss on the points sweep(point) visits.
+ * Normally one pass computes every requested term of a point. With the
+ * timers on, convection and dissipation are separate passes, each timed as
+ * a phase of its own; the dissipation pass adds to the convection one in
+ * the order of the one pass sum, so the values are the same
+ */
+template <typename Sweep>
+void interior_passes(Sweep sweep, const Convection& conv,
+    const Dissipation& diss, const CartesianGrid& grid, DerivativeTerms terms,
+    CartesianVariation* var)
+{
+    auto& values = var->grid_variation;
+    if (!PhaseTimers::instance().enabled()) {
+        sweep([&](int ind) {
+            values[ind] = interior(conv, diss, grid, ind, terms);
+        });
+        return;
+    }
+    if (terms != DerivativeTerms::Dissipation) {
+        ScopedPhaseTimer timer(TimerPhase::Convection);
+        sweep([&](int ind) {
+            values[ind] = interior(
+                conv, diss, grid, ind, DerivativeTerms::Convection);
+        });
+    }
+    if (terms != DerivativeTerms::Convection) {
+        ScopedPhaseTimer timer(TimerPhase::Dissipation);
+        bool add = terms == DerivativeTerms::All;
+        sweep([&](int ind) {
+            values[ind] = add ? values[ind] + diss.dissipation_x(grid, ind)
+                    + diss.dissipation_y(grid, ind)
+                              : diss.dissipation_x(grid, ind)
+                    + diss.dissipation_y(grid, ind);
+        });
+    }
+}
+
+/**
+ * @brief Runs the interior scheme on every point, tile by tile, while
+ * revisit() and boundaries() run as tasks of their own. Their serial cost is
+ * then hidden behind the interior instead of being added after it. The
+ * interior also visits the points they handle, so they must write to their
+ * own buffers, which replace the regular values once everything finished
+ */
+template <typename Revisit, typename Boundaries>
+void overlap_interior(const Tiling& tiling, const Convection& conv,
+    const Dissipation& diss, const CartesianGrid& grid,
+    CartesianVariation* var, Revisit revisit, Boundaries boundaries)
+{
+#ifndef DEBUG
+#pragma omp parallel
+#pragma omp single
+#endif
+    {
+#ifndef DEBUG
+#pragma omp task
+#endif
+        revisit();
+#ifndef DEBUG
+#pragma omp task
+#endif
+        boundaries();
+        ScopedPhaseTimer regular_timer(TimerPhase::RegularPoints);
+        int tiles = tiling.count();
+        // Tiles go to whichever thread is free, whatever thread touched
+        // their pages first (see memory::allocate)
+        auto sweep = [&](auto point) {
+#ifndef DEBUG
+#pragma omp taskloop grainsize(tiling.tiles_per_task())
+#endif
+            for (int tile = 0; tile < tiles; tile++) {
+                tiling.visit(tile, point);
+            }
+        };
+        interior_passes(sweep, conv, diss, grid, var->terms, var);
+    }
+}
+
+/**
+ * @brief Norms over every process from the norms of the local points
+ */
+ResidualNorms global_norms(
+    const ResidualNorms& local, int local_points, int global_points)
+{
+    ResidualNorms norms;
+    for (size_t c = 0; c < local.l2.size(); c++) {
+        double sum = parallel::sum(local.l2[c] * local.l2[c] * local_points);
+        norms.l2[c] = std::sqrt(sum / global_points);
+        norms.linf[c] = parallel::max(local.linf[c]);
+    }
+    return norms;
+}
+} // namespace
 
 TimeIntegratorTool::TimeIntegratorTool(
     std::shared_ptr<Convection> convection_in,
@@ -35,125 +273,152 @@ TimeIntegratorTool::TimeIntegratorTool(
 {
 }
 
-void TimeIntegratorTool::time_derivative(
-    CartesianVariation& var, const CartesianGrid& grid, double t)
+Tiling TimeIntegratorTool::tiling(const CartesianGrid& grid) const
 {
-    int nPointsTotal = grid.nPointsTotal;
-    conv->init(grid);
 #ifndef DEBUG
-#pragma omp parallel for
+    int threads = omp_get_max_threads();
+#else
+    int threads = 1;
 #endif
-    for (int ind = 0; ind < nPointsTotal; ind++) { // NOLINT
-        var.grid_variation[ind] = conv->convection_x(grid, ind)
-            + conv->convection_y(grid, ind) + diss->dissipation_x(grid, ind)
-            + diss->dissipation_y(grid, ind);
-    }
-    for (auto& bp : grid.boundary()) { // NOLINT
-        int ind = bp.ind;
-        if (bp.x_boundary) {
-            var.grid_variation[ind] = (boundary->convection_x(grid, bp, t)
-                + boundary->dissipation_x(grid, bp));
-        }
-        else {
-            var.grid_variation[ind] = conv->convection_x(grid, ind)
-                + diss->dissipation_x(grid, ind);
-        }
-        if (bp.y_boundary) {
-            var.grid_variation[ind] += (boundary->convection_y(grid, bp, t)
-                + boundary->dissipation_y(grid, bp));
-        }
-        else {
-            var.grid_variation[ind] += conv->convection_y(grid, ind)
-                + diss->dissipation_y(grid, ind);
-        }
-    }
+    return Tiling(grid.nPointsI, grid.nPointsJ, traversal_c, threads);
 }
 
 void TimeIntegratorTool::time_derivative(
-    CartesianVariation& var, const KaragiozisGrid& grid, double t)
+    CartesianVariation& var, const CartesianGrid& grid, double t)
 {
+    ScopedPhaseTimer timer(TimerPhase::TimeDerivative);
+    if (var.terms != DerivativeTerms::Dissipation) {
+        conv->init(grid);
+    }
+    auto boundaries = [&] {
+        boundary_points(*boundary, *conv, *diss, grid, t, var.terms,
+            &boundary_values);
+    };
+    if (grid.decomposition()) {
+        decomposed_interior(var, grid);
+        boundaries();
+    }
+    else {
+        overlap_interior(
+            tiling(grid), *conv, *diss, grid, &var, [] {}, boundaries);
+    }
+    copy_boundary_values(grid, boundary_values, &var);
+    if (var.compute_norms) {
+        var.norms = norms(var, grid);
+    }
+}
 
-    int nPointsTotal = grid.nPointsTotal;
-#ifndef DEBUG
-#pragma omp parallel for
-#endif
-    for (int ind = 0; ind < nPointsTotal; ind++) { // NOLINT
-        var.grid_variation[ind] = conv->convection_x(grid, ind)
-            + conv->convection_y(grid, ind) + diss->dissipation_x(grid, ind)
-            + diss->dissipation_y(grid, ind);
-    }
-    for (const auto& ind : grid.to_revisit()) {
-        var.grid_variation[ind] = conv_irreg->convection_x(grid, ind)
-            + conv_irreg->convection_y(grid, ind)
-            + diss_irreg->dissipation_x(grid, ind)
-            + diss_irreg->dissipation_y(grid, ind);
-    }
-    for (auto& bp : grid.boundary()) { // NOLINT
-        int ind = bp.ind;
-        if (bp.x_boundary) {
-            var.grid_variation[ind] = (boundary_irreg->convection_x(grid, bp, t)
-                + boundary_irreg->dissipation_x(grid, bp));
-        }
-        else {
-            var.grid_variation[ind] = conv_irreg->convection_x(grid, ind)
-                + diss_irreg->dissipation_x(grid, ind);
-        }
-        if (bp.y_boundary) {
-            var.grid_variation[ind]
-                += (boundary_irreg->convection_y(grid, bp, t)
-                    + boundary_irreg->dissipation_y(grid, bp));
-        }
-        else {
-            var.grid_variation[ind] += conv_irreg->convection_y(grid, ind)
-                + diss_irreg->dissipation_y(grid, ind);
-        }
+ResidualNorms TimeIntegratorTool::norms(
+    const CartesianVariation& var, const CartesianGrid& grid) const
+{
+    auto local = residual_norms(var.grid_variation);
+    if (!grid.decomposition()) {
+        return local;
     }
+    auto& d = *grid.decomposition();
+    return global_norms(local, grid.nPointsTotal,
+        d.global_nPointsI() * d.global_nPointsJ());
 }
 
-void TimeIntegratorTool::time_derivative(
-    CartesianVariation& var, const GhiasShockGrid& grid, double t)
+parallel::HaloExchange& TimeIntegratorTool::halo_exchange(
+    const CartesianGrid& grid)
 {
+    if (!halo) {
+        halo = std::make_shared<parallel::HaloExchange>(grid.decomposition());
+    }
+    return *halo;
+}
 
-    int nPointsTotal = grid.nPointsTotal;
+void TimeIntegratorTool::decomposed_interior(
+    CartesianVariation& var, const CartesianGrid& grid)
+{
+    ScopedPhaseTimer regular_timer(TimerPhase::RegularPoints);
+    auto& d = *grid.decomposition();
+    auto& halo = halo_exchange(grid);
+    auto compute = [&](const std::vector<int>& points) {
+        int n = static_cast<int>(points.size());
+        auto sweep = [&](auto point) {
 #ifndef DEBUG
 #pragma omp parallel for
 #endif
-    for (int ind = 0; ind < nPointsTotal; ind++) { // NOLINT
-        var.grid_variation[ind] = conv->convection_x(grid, ind)
-            + conv->convection_y(grid, ind) + diss->dissipation_x(grid, ind)
-            + diss->dissipation_y(grid, ind);
+            for (int k = 0; k < n; k++) { // NOLINT
+                point(points[k]);
+            }
+        };
+        interior_passes(sweep, *conv, *diss, grid, var.terms, &var);
+    };
+    halo.begin(grid);
+    compute(d.inner_points());
+    // Ghost points only mirror points owned by other processes, so
+    // refreshing them does not change the state the grid represents
+    halo.finish(const_cast<CartesianGrid*>(&grid));
+    if (var.terms != DerivativeTerms::Dissipation) {
+        // Convections that cache fluxes need them at the new ghost values
+        conv->init(grid);
+    }
+    compute(d.outer_points());
+    // Ghost points are advanced by their owners
+    for (auto ind : d.ghost_points()) {
+        var.grid_variation[ind] = Flux {0.0, 0.0, 0.0, 0.0};
+    }
+}
+
+void TimeIntegratorTool::time_derivative(
+    CartesianVariation& var, const KaragiozisGrid& grid, double t)
+{
+    ScopedPhaseTimer timer(TimerPhase::TimeDerivative);
+    auto& to_revisit = grid.to_revisit();
+    auto revisit = [&] {
+        revisit_points(*conv_irreg, *diss_irreg, grid, to_revisit, var.terms,
+            &revisit_values);
+    };
+    auto boundaries = [&] {
+        boundary_points(*boundary_irreg, *conv_irreg, *diss_irreg, grid, t,
+            var.terms, &boundary_values);
+    };
+    if (grid.decomposition()) {
+        // The points to revisit are owned, so their stencils read ghost
+        // points only once the exchange finished
+        decomposed_interior(var, grid);
+        revisit();
+        boundaries();
+    }
+    else {
+        overlap_interior(
+            tiling(grid), *conv, *diss, grid, &var, revisit, boundaries);
+    }
+    copy_revisit_values(to_revisit, revisit_values, &var);
+    copy_boundary_values(grid, boundary_values, &var);
+    if (var.compute_norms) {
+        var.norms = norms(var, grid);
     }
+}
 
+void TimeIntegratorTool::time_derivative(
+    CartesianVariation& var, const GhiasShockGrid& grid, double t)
+{
+    ScopedPhaseTimer timer(TimerPhase::TimeDerivative);
     auto& to_revisit = grid.to_revisit();
-    for (auto& ind : to_revisit) {
-        var.grid_variation[ind] = conv_irreg->convection_x(grid, ind)
-            + conv_irreg->convection_y(grid, ind)
-            + diss_irreg->dissipation_x(grid, ind)
-            + diss_irreg->dissipation_y(grid, ind);
-    }
-    for (auto& bp : grid.boundary()) { // NOLINT
-        int ind = bp.ind;
-        if (bp.x_boundary) {
-            var.grid_variation[ind] = (boundary->convection_x(grid, bp, t)
-                + boundary->dissipation_x(grid, bp));
-        }
-        else {
-            var.grid_variation[ind] = conv_irreg->convection_x(grid, ind)
-                + diss_irreg->dissipation_x(grid, ind);
-        }
-        if (bp.y_boundary) {
-            var.grid_variation[ind] += (boundary->convection_y(grid, bp, t)
-                + boundary->dissipation_y(grid, bp));
-        }
-        else {
-            var.grid_variation[ind] += conv_irreg->convection_y(grid, ind)
-                + diss_irreg->dissipation_y(grid, ind);
-        }
+    auto revisit = [&] {
+        revisit_points(*conv_irreg, *diss_irreg, grid, to_revisit, var.terms,
+            &revisit_values);
+    };
+    auto boundaries = [&] {
+        boundary_points(*boundary, *conv_irreg, *diss_irreg, grid, t,
+            var.terms, &boundary_values);
+    };
+    overlap_interior(
+        tiling(grid), *conv, *diss, grid, &var, revisit, boundaries);
+    copy_revisit_values(to_revisit, revisit_values, &var);
+    copy_boundary_values(grid, boundary_values, &var);
+    if (var.compute_norms) {
+        var.norms = residual_norms(var.grid_variation);
     }
 }
 
 void TimeIntegratorTool::fix_boundary(CartesianGrid* grid, double t)
 {
+    ScopedPhaseTimer timer(TimerPhase::FixBoundary);
     for (auto& bp : grid->boundary()) {
         boundary->fix_boundary(grid, bp, t);
     }
@@ -161,6 +426,15 @@ void TimeIntegratorTool::fix_boundary(CartesianGrid* grid, double t)
 
 void TimeIntegratorTool::update_values(CartesianGrid* grid, double t)
 {
+    ScopedPhaseTimer timer(TimerPhase::UpdateValues);
     fix_boundary(grid, t);
+    if (grid->decomposition() and grid->update_reads_neighbors()) {
+        // Ghost points still hold the values before the update
+        halo_exchange(*grid).exchange(grid);
+    }
+    ScopedPhaseTimer grid_timer(TimerPhase::GridUpdate);
     grid->grid_specific_update();
+    if (round_storage) {
+        grid->round_to_single();
+    }
 }
@@ -1,7 +1,10 @@
 #ifndef TIME_INTEGRATOR_TOOL_HPP
 #define TIME_INTEGRATOR_TOOL_HPP
 
+#include "../utils/flux_def.hpp"
+#include "traversal.hpp"
 #include <memory>
+#include <vector>
 
 class Boundary;
 class Dissipation;
@@ -10,6 +13,10 @@ class CartesianGrid;
 class GhiasShockGrid;
 class KaragiozisGrid;
 struct CartesianVariation;
+struct ResidualNorms;
+namespace parallel {
+class HaloExchange;
+}
 
 class TimeIntegratorTool {
 public:
@@ -31,6 +38,15 @@ public:
     void fix_boundary(CartesianGrid* grid, double t);
     void update_values(CartesianGrid* grid, double t);
 
+    /**
+     * @brief Rounds the grid to single precision after every update, see
+     * CartesianGrid::round_to_single
+     */
+    void set_storage_rounding(bool enabled) { round_storage = enabled; }
+
+    const Traversal& traversal() const { return traversal_c; }
+    void set_traversal(const Traversal& traversal) { traversal_c = traversal; }
+
 private:
     std::shared_ptr<Convection> conv;
     std::shared_ptr<Dissipation> diss;
@@ -39,6 +55,32 @@ private:
     std::shared_ptr<Convection> conv_irreg;
     std::shared_ptr<Dissipation> diss_irreg;
     std::shared_ptr<Boundary> boundary_irreg;
+
+    Traversal traversal_c;
+    bool round_storage = false;
+    Tiling tiling(const CartesianGrid& grid) const;
+
+    /**
+     * @name Time derivatives of the points close to discontinuities and of
+     * the boundary points, computed while the interior is
+     * @{ */
+    std::vector<Flux> revisit_values;
+    std::vector<Flux> boundary_values;
+    /**  @} */
+
+    std::shared_ptr<parallel::HaloExchange> halo;
+    parallel::HaloExchange& halo_exchange(const CartesianGrid& grid);
+    /**
+     * @brief Interior of a decomposed grid: the points away from the ghost
+     * points are computed while the ghost points are being exchanged
+     */
+    void decomposed_interior(
+        CartesianVariation& var, const CartesianGrid& grid);
+    /**
+     * @brief Residual norms of var, over every process on a decomposed grid
+     */
+    ResidualNorms norms(
+        const CartesianVariation& var, const CartesianGrid& grid) const;
 };
 
 #endif /* TIME_INTEGRATOR_TOOL_HPP */
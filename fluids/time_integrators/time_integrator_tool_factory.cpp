@@ -10,8 +10,8 @@
 #include "time_integrator_tool_factory.hpp"
 #include <iostream>
 
-std::shared_ptr<TimeIntegratorTool> create_time_integrator_tool(
-    Options& opt, PointFunctions& pf, CartesianGrid& grid)
+std::shared_ptr<TimeIntegratorTool> create_time_integrator_tool(Options& opt,
+    PointFunctions& pf, const SolverContext& context, CartesianGrid& grid)
 {
 
     std::shared_ptr<Derivatives> der;
@@ -20,10 +20,10 @@ std::shared_ptr<TimeIntegratorTool> create_time_integrator_tool(
     std::shared_ptr<Boundary> boundary;
 
     der = create_derivative("REGULAR", pf, grid, opt.derivative_order());
-    conv = create_convection(opt, pf, der);
+    conv = create_convection(opt, pf, context, der);
     diss = create_dissipation(opt, pf, der);
-    boundary
-        = std::make_shared<Boundary>(pf, der, opt.reynolds(), opt.prandtl());
+    boundary = std::make_shared<Boundary>(
+        pf, context, der, opt.reynolds(), opt.prandtl());
 
     if (der == nullptr or conv == nullptr or diss == nullptr) {
         std::cerr << "Could not create tool!!!" << std::endl;
@@ -32,10 +32,10 @@ std::shared_ptr<TimeIntegratorTool> create_time_integrator_tool(
 
     if (opt.solver_type() == "KARAGIOZIS" || opt.solver_type() == "SHOCK") {
         auto der_irreg = create_derivative("KARAGIOZIS", pf, grid);
-        auto conv_irreg = create_convection(opt, pf, der_irreg);
+        auto conv_irreg = create_convection(opt, pf, context, der_irreg);
         auto diss_irreg = create_dissipation(opt, pf, der_irreg);
         auto boundary_irreg = std::make_shared<Boundary>(
-            pf, der_irreg, opt.reynolds(), opt.prandtl());
+            pf, context, der_irreg, opt.reynolds(), opt.prandtl());
         if (der_irreg == nullptr or conv_irreg == nullptr
             or diss_irreg == nullptr) {
             std::cerr << "Could not create tool!!! (Irregular part)"
@@ -47,7 +47,8 @@ std::shared_ptr<TimeIntegratorTool> create_time_integrator_tool(
     }
 
     if (opt.solver_type() == "GHIAS_SHOCK") {
-        auto conv_irreg = create_convection(opt, pf, der, "WENO_CONVECTION");
+        auto conv_irreg
+            = create_convection(opt, pf, context, der, "WENO_CONVECTION");
         auto diss_irreg = create_dissipation(opt, pf, der);
         return std::make_shared<TimeIntegratorTool>(
             conv, diss, boundary, conv_irreg, diss, boundary);
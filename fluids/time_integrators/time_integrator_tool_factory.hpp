@@ -6,9 +6,10 @@
 class TimeIntegratorTool;
 class Options;
 struct PointFunctions;
+struct SolverContext;
 class CartesianGrid;
 
-std::shared_ptr<TimeIntegratorTool> create_time_integrator_tool(
-    Options& opt, PointFunctions& pf, CartesianGrid& grid);
+std::shared_ptr<TimeIntegratorTool> create_time_integrator_tool(Options& opt,
+    PointFunctions& pf, const SolverContext& context, CartesianGrid& grid);
 
 #endif /* TIME_INTEGRATOR_TOOL_FACTORY_HPP */
@@ -2,14 +2,29 @@
 #define TIME_INTEGRATOR_TYPES_HPP
 
 #include "../utils/flux_def.hpp"
+#include "../utils/memory/grid_allocator.hpp"
+#include "../utils/residual_norms.hpp"
 #include <vector>
 
+/**
+ * @brief Terms of the equations included in a time derivative, so
+ * integrators can treat convection and dissipation differently
+ */
+enum class DerivativeTerms { All, Convection, Dissipation };
+
 struct CartesianVariation {
     CartesianVariation(int nPointsTotal)
-        : grid_variation(std::vector<Flux>(nPointsTotal))
+        : grid_variation(memory::GridArray<Flux>(nPointsTotal))
     {
     }
-    std::vector<Flux> grid_variation;
+    memory::GridArray<Flux> grid_variation;
+    /**
+     * When set, time_derivative also fills norms with the L2 and Linf norms
+     * of grid_variation
+     */
+    bool compute_norms = false;
+    DerivativeTerms terms = DerivativeTerms::All;
+    ResidualNorms norms = ResidualNorms();
 };
 
 #endif /* TIME_INTEGRATOR_TYPES_HPP */
@@ -0,0 +1,73 @@
+#include "traversal.hpp"
+#include <ostream>
+
+namespace {
+const int MIN_TILE_POINTS = 1024;
+const int TILES_PER_THREAD = 8;
+
+int tile_count(int n, int tile) { return (n + tile - 1) / tile; }
+} // namespace
+
+std::ostream& operator<<(std::ostream& os, const Traversal& traversal)
+{
+    if (traversal.tile_rows > 0) {
+        os << traversal.tile_rows;
+    }
+    else {
+        os << "auto";
+    }
+    os << " x ";
+    if (traversal.tile_cols > 0) {
+        os << traversal.tile_cols;
+    }
+    else {
+        os << "row";
+    }
+    return os << " tiles, " << traversal.tiles_per_task << " per task";
+}
+
+Tiling::Tiling(
+    int nPointsI_in, int nPointsJ_in, const Traversal& traversal, int threads)
+    : nPointsI(nPointsI_in)
+    , nPointsJ(nPointsJ_in)
+    , per_task(std::max(1, traversal.tiles_per_task))
+{
+    cols = traversal.tile_cols > 0 ? std::min(traversal.tile_cols, nPointsJ)
+                                   : nPointsJ;
+    if (traversal.tile_rows > 0) {
+        rows = std::min(traversal.tile_rows, nPointsI);
+    }
+    else {
+        // Enough tiles to balance the threads, not so small that the
+        // tasks cost more than the points
+        int points = std::max(MIN_TILE_POINTS,
+            nPointsI * nPointsJ / (TILES_PER_THREAD * std::max(1, threads)));
+        rows = std::min(nPointsI, std::max(1, points / std::max(1, cols)));
+    }
+    rows = std::max(1, rows);
+    cols = std::max(1, cols);
+    tiles_i = tile_count(nPointsI, rows);
+    tiles_j = tile_count(nPointsJ, cols);
+}
+
+std::vector<Traversal> traversal_candidates(int nPointsI, int nPointsJ)
+{
+    std::vector<Traversal> candidates;
+    for (int per_task : {1, 4}) {
+        candidates.push_back({0, 0, per_task});
+    }
+    for (int cols : {64, 128, 256, 512}) {
+        if (cols >= nPointsJ) {
+            continue;
+        }
+        for (int rows : {16, 64}) {
+            if (rows > nPointsI) {
+                continue;
+            }
+            for (int per_task : {1, 4}) {
+                candidates.push_back({rows, cols, per_task});
+            }
+        }
+    }
+    return candidates;
+}
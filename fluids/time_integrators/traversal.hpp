@@ -0,0 +1,76 @@
+/**
+ * \file traversal.hpp
+ * @brief Order in which the time derivatives visit the grid points
+ */
+#ifndef TRAVERSAL_HPP
+#define TRAVERSAL_HPP
+
+#include "../grid/grid_shape.hpp"
+
+#include <algorithm>
+#include <iosfwd>
+#include <vector>
+
+/**
+ * @brief Shape of the tiles the regular points are computed in
+ *
+ * The y stencils reach rows nPointsJ points apart. A tile of a few hundred
+ * columns keeps all the rows they read in cache on wide grids, while whole
+ * rows stream through memory once per row of the tile.
+ */
+struct Traversal {
+    /** Rows of a tile, 0 picks them from the grid size and threads */
+    int tile_rows = 0;
+    /** Columns of a tile, 0 takes whole rows */
+    int tile_cols = 0;
+    /** Tiles a thread takes at once */
+    int tiles_per_task = 1;
+};
+
+std::ostream& operator<<(std::ostream& os, const Traversal& traversal);
+
+/**
+ * \class Tiling
+ * @brief Tiles of a traversal over a nPointsI x nPointsJ grid
+ */
+class Tiling {
+public:
+    Tiling(int nPointsI_in, int nPointsJ_in, const Traversal& traversal,
+        int threads);
+
+    int count() const { return tiles_i * tiles_j; }
+    int tiles_per_task() const { return per_task; }
+
+    /**
+     * @brief Calls visit_point(ind) on every point of the tile, row by row
+     */
+    template <typename Visit>
+    void visit(int tile, Visit& visit_point) const
+    {
+        int i_begin = (tile / tiles_j) * rows;
+        int j_begin = (tile % tiles_j) * cols;
+        int i_end = std::min(nPointsI, i_begin + rows);
+        int j_end = std::min(nPointsJ, j_begin + cols);
+        for (int i = i_begin; i < i_end; i++) {
+            for (int j = j_begin; j < j_end; j++) {
+                visit_point(i * grid_shape::columns(nPointsJ) + j);
+            }
+        }
+    }
+
+private:
+    int nPointsI;
+    int nPointsJ;
+    int rows;
+    int cols;
+    int tiles_i;
+    int tiles_j;
+    int per_task;
+};
+
+/**
+ * @brief Traversals the tuner tries on a grid, whole rows first
+ */
+std::vector<Traversal> traversal_candidates(int nPointsI, int nPointsJ);
+
+#endif /* TRAVERSAL_HPP */
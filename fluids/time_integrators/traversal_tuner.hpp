@@ -0,0 +1,49 @@
+/**
+ * \file traversal_tuner.hpp
+ * @brief Picks the fastest traversal of the time derivative on a grid
+ */
+#ifndef TRAVERSAL_TUNER_HPP
+#define TRAVERSAL_TUNER_HPP
+
+#include "time_integrator_tool.hpp"
+#include "time_integrator_types.hpp"
+#include "traversal.hpp"
+#include <chrono>
+
+/**
+ * @brief Times a few time derivatives of grid with the traversal set in
+ * tool and every candidate one, and leaves the fastest one set in tool
+ *
+ * The traversal only changes the order the points are computed in, so the
+ * choice does not change the results. The derivatives are taken at the
+ * current state and thrown away.
+ */
+template <typename Grid>
+Traversal tune_traversal(
+    TimeIntegratorTool* tool, const Grid& grid, int evaluations = 3)
+{
+    CartesianVariation var(grid.nPointsTotal);
+    // Sizes the caches and buffers before anything is timed
+    tool->time_derivative(var, grid, 0.0);
+    auto candidates = traversal_candidates(grid.nPointsI, grid.nPointsJ);
+    candidates.insert(candidates.begin(), tool->traversal());
+    Traversal best;
+    double best_time = -1;
+    for (auto& candidate : candidates) {
+        tool->set_traversal(candidate);
+        auto start = std::chrono::steady_clock::now();
+        for (int k = 0; k < evaluations; k++) {
+            tool->time_derivative(var, grid, 0.0);
+        }
+        std::chrono::duration<double> elapsed
+            = std::chrono::steady_clock::now() - start;
+        if (best_time < 0 or elapsed.count() < best_time) {
+            best_time = elapsed.count();
+            best = candidate;
+        }
+    }
+    tool->set_traversal(best);
+    return best;
+}
+
+#endif /* TRAVERSAL_TUNER_HPP */
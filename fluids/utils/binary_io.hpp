@@ -0,0 +1,64 @@
+#ifndef BINARY_IO_HPP
+#define BINARY_IO_HPP
+
+#include <cstdint>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Raw binary (de)serialization used by checkpoints
+ *
+ * Values are stored with the native layout, so a file can only be read back
+ * on a machine with the same endianness.
+ */
+namespace binary_io {
+
+template <typename T>
+void write(std::ostream& os, const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+        "Only trivially copyable types can be written directly");
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+void read(std::istream& is, T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+        "Only trivially copyable types can be read directly");
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    if (!is) {
+        std::cerr << "Unexpected end of binary data" << std::endl;
+        throw(-1);
+    }
+}
+
+template <typename T, typename Allocator>
+void write_vector(std::ostream& os, const std::vector<T, Allocator>& vec)
+{
+    write(os, static_cast<uint64_t>(vec.size()));
+    if (!vec.empty()) {
+        os.write(reinterpret_cast<const char*>(vec.data()),
+            static_cast<std::streamsize>(vec.size() * sizeof(T)));
+    }
+}
+
+template <typename T, typename Allocator>
+void read_vector(std::istream& is, std::vector<T, Allocator>& vec)
+{
+    uint64_t size;
+    read(is, size);
+    vec.resize(size);
+    if (size != 0) {
+        is.read(reinterpret_cast<char*>(vec.data()),
+            static_cast<std::streamsize>(size * sizeof(T)));
+        if (!is) {
+            std::cerr << "Unexpected end of binary data" << std::endl;
+            throw(-1);
+        }
+    }
+}
+} // namespace binary_io
+
+#endif /* BINARY_IO_HPP */
@@ -10,6 +10,17 @@ public:
     {
     }
     double T;
+
+    void save_state(std::ostream& os) const
+    {
+        GenericDiscontinuity::save_state(os);
+        binary_io::write(os, T);
+    }
+    void load_state(std::istream& is)
+    {
+        GenericDiscontinuity::load_state(is);
+        binary_io::read(is, T);
+    }
 };
 
 #endif /* BODY_DISCONTINUITY_DEF_HPP */
@@ -0,0 +1,196 @@
+#include "residual_smoother.hpp"
+#include "../../grid/cartesian_grid.hpp"
+#include "../operators_overloads.hpp"
+#include "../point_functions.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/**
+ * @brief Solves a_k R'[k-1] + b_k R'[k] + c_k R'[k+1] = R[k] along the line
+ * of len points starting at first, in place. Solid points are left out and
+ * split the line, and b_k = 1 - a_k - c_k so a uniform residual is unchanged
+ */
+void solve_line(memory::GridArray<Flux>* variation,
+    const std::vector<double>& eps, const std::vector<char>& fluid,
+    int first, int stride, int len, std::vector<double>* c_prime)
+{
+    auto& var = *variation;
+    auto& cp = *c_prime;
+    int ind = first;
+    for (int k = 0; k < len; k++, ind += stride) {
+        double a = (k > 0 and fluid[ind] and fluid[ind - stride])
+            ? -eps[ind]
+            : 0.0;
+        double c = (k < len - 1 and fluid[ind] and fluid[ind + stride])
+            ? -eps[ind]
+            : 0.0;
+        double m = 1 - a - c - (k > 0 ? a * cp[k - 1] : 0.0);
+        cp[k] = c / m;
+        var[ind] = (k > 0 ? var[ind] + (-a) * var[ind - stride] : var[ind])
+            / m;
+    }
+    ind -= stride;
+    for (int k = len - 2; k >= 0; k--) {
+        ind -= stride;
+        var[ind] = var[ind] + (-cp[k]) * var[ind + stride];
+    }
+}
+
+bool any_positive(const std::vector<double>& eps, int first, int stride,
+    int len)
+{
+    for (int k = 0; k < len; k++) {
+        if (eps[first + k * stride] > 0.0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Bound of the kinematic viscosity and thermal diffusivity times
+ * the density
+ */
+double diffusivity(const PointFunctions& pf, double reynolds, double prandtl)
+{
+    return std::max(4 / 3., pf.gam / prandtl) / reynolds;
+}
+} // namespace
+
+ResidualSmoother::ResidualSmoother(double base_cfl)
+    : base_lambda(base_cfl / 2.)
+    , any_x(false)
+    , any_y(false)
+{
+}
+
+double ResidualSmoother::coefficient(double lambda) const
+{
+    double ratio = lambda / base_lambda;
+    return std::max(0.0, (ratio * ratio - 1) / 4.);
+}
+
+void ResidualSmoother::update_coefficients(const CartesianGrid& grid,
+    const PointFunctions& pf, double dt, const std::vector<double>& local_dt)
+{
+    int nPointsTotal = grid.nPointsTotal;
+    eps_x.resize(nPointsTotal);
+    eps_y.resize(nPointsTotal);
+    fluid.resize(nPointsTotal);
+    bool found_x = false, found_y = false;
+#ifndef DEBUG
+#pragma omp parallel for reduction(|| : found_x, found_y)
+#endif
+    for (int ind = 0; ind < nPointsTotal; ind++) {
+        auto point = grid.values(ind);
+        double h = local_dt.empty() ? dt : local_dt[ind];
+        double c = pf.sound_speed(point);
+        fluid[ind] = grid.ind_is_valid(ind);
+        eps_x[ind] = fluid[ind]
+            ? coefficient(h * (std::fabs(pf.u(point)) + c) / grid.dx)
+            : 0.0;
+        eps_y[ind] = fluid[ind]
+            ? coefficient(h * (std::fabs(pf.v(point)) + c) / grid.dy)
+            : 0.0;
+        found_x = found_x || eps_x[ind] > 0.0;
+        found_y = found_y || eps_y[ind] > 0.0;
+    }
+    any_x = found_x;
+    any_y = found_y;
+}
+
+void ResidualSmoother::update_viscous_coefficients(const CartesianGrid& grid,
+    const PointFunctions& pf, double h, double reynolds, double prandtl)
+{
+    int nPointsTotal = grid.nPointsTotal;
+    eps_x.resize(nPointsTotal);
+    eps_y.resize(nPointsTotal);
+    fluid.resize(nPointsTotal);
+    double mu = diffusivity(pf, reynolds, prandtl);
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (int ind = 0; ind < nPointsTotal; ind++) {
+        fluid[ind] = grid.ind_is_valid(ind);
+        double kappa = fluid[ind] ? mu / grid.rho(ind) : 0.0;
+        eps_x[ind] = h * kappa / (grid.dx * grid.dx);
+        eps_y[ind] = h * kappa / (grid.dy * grid.dy);
+    }
+    any_x = any_y = true;
+}
+
+void ResidualSmoother::update_implicit_coefficients(const CartesianGrid& grid,
+    const PointFunctions& pf, const std::vector<double>& local_dt,
+    double reynolds, double prandtl)
+{
+    int nPointsTotal = grid.nPointsTotal;
+    eps_x.resize(nPointsTotal);
+    eps_y.resize(nPointsTotal);
+    fluid.resize(nPointsTotal);
+    double mu = diffusivity(pf, reynolds, prandtl);
+    double dx = grid.dx;
+    double dy = grid.dy;
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (int ind = 0; ind < nPointsTotal; ind++) {
+        fluid[ind] = grid.ind_is_valid(ind);
+        if (!fluid[ind]) {
+            eps_x[ind] = eps_y[ind] = 0.0;
+            continue;
+        }
+        auto point = grid.values(ind);
+        double h = local_dt[ind];
+        double c = pf.sound_speed(point);
+        double kappa = mu / point.rho();
+        eps_x[ind] = h * ((std::fabs(pf.u(point)) + c) / (2 * dx)
+                             + kappa / (dx * dx));
+        eps_y[ind] = h * ((std::fabs(pf.v(point)) + c) / (2 * dy)
+                             + kappa / (dy * dy));
+    }
+    any_x = any_y = true;
+}
+
+void ResidualSmoother::smooth(
+    const CartesianGrid& grid, memory::GridArray<Flux>* variation) const
+{
+    int nI = grid.nPointsI;
+    int nJ = grid.nPointsJ;
+    if (any_x) {
+#ifndef DEBUG
+#pragma omp parallel
+#endif
+        {
+            std::vector<double> c_prime(nJ);
+#ifndef DEBUG
+#pragma omp for
+#endif
+            for (int i = 0; i < nI; i++) {
+                int first = grid.IND(i, 0);
+                if (any_positive(eps_x, first, grid.shiftX(), nJ)) {
+                    solve_line(variation, eps_x, fluid, first,
+                        grid.shiftX(), nJ, &c_prime);
+                }
+            }
+        }
+    }
+    if (any_y) {
+#ifndef DEBUG
+#pragma omp parallel
+#endif
+        {
+            std::vector<double> c_prime(nI);
+#ifndef DEBUG
+#pragma omp for
+#endif
+            for (int j = 0; j < nJ; j++) {
+                int first = grid.IND(0, j);
+                if (any_positive(eps_y, first, grid.shiftY(), nI)) {
+                    solve_line(variation, eps_y, fluid, first,
+                        grid.shiftY(), nI, &c_prime);
+                }
+            }
+        }
+    }
+}
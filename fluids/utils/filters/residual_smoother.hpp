@@ -0,0 +1,81 @@
+#ifndef RESIDUAL_SMOOTHER_HPP
+#define RESIDUAL_SMOOTHER_HPP
+
+#include "../flux_def.hpp"
+#include "../memory/grid_allocator.hpp"
+#include <vector>
+
+class CartesianGrid;
+struct PointFunctions;
+
+/**
+ * \class ResidualSmoother
+ * @brief Implicit residual smoothing, to run explicit schemes above their
+ * CFL limit
+ *
+ * The time derivative R is replaced by the solution of
+ * (1 - eps_x d_xx)(1 - eps_y d_yy) R' = R, one tridiagonal system per grid
+ * line and column. The coefficients follow the local CFL number
+ * lambda = dt (|u| + c) / dx of each direction,
+ * eps = max(0, ((lambda / lambda_0)^2 - 1) / 4), where lambda_0 is the
+ * largest local CFL number the scheme takes without smoothing, so points
+ * below it are left untouched. Boundary points are smoothed as well, as
+ * they would otherwise limit the step; solid points split the lines.
+ *
+ * With the coefficients of the viscous terms instead (see
+ * update_viscous_coefficients), the same line solves approximate
+ * (1 - h L)^-1, L being the viscous operator, by ADI factorization. This is
+ * how implicit viscous stages are preconditioned, and with
+ * update_implicit_coefficients the Newton steps of the steady solver.
+ */
+class ResidualSmoother {
+public:
+    /**
+     * @param base_cfl CFL option value at which the scheme is stable without
+     * smoothing
+     */
+    ResidualSmoother(double base_cfl);
+
+    /**
+     * @brief Computes the coefficients for the current state
+     *
+     * @param local_dt Step of each point, or empty if every point uses dt
+     */
+    void update_coefficients(const CartesianGrid& grid,
+        const PointFunctions& pf, double dt,
+        const std::vector<double>& local_dt);
+
+    /**
+     * @brief Coefficients eps = h kappa / dx^2, where kappa bounds the
+     * kinematic viscosity and thermal diffusivity of each point
+     */
+    void update_viscous_coefficients(const CartesianGrid& grid,
+        const PointFunctions& pf, double h, double reynolds, double prandtl);
+
+    /**
+     * @brief Coefficients of a scalar factorization of I - h J, J being the
+     * Jacobian of the whole time derivative: convection is represented by
+     * the dissipation of a first order upwind scheme, h (|u| + c) / (2 dx),
+     * and the viscous terms as in update_viscous_coefficients
+     *
+     * @param local_dt Step h of each point
+     */
+    void update_implicit_coefficients(const CartesianGrid& grid,
+        const PointFunctions& pf, const std::vector<double>& local_dt,
+        double reynolds, double prandtl);
+
+    void smooth(
+        const CartesianGrid& grid, memory::GridArray<Flux>* variation) const;
+
+private:
+    const double base_lambda;
+    std::vector<double> eps_x;
+    std::vector<double> eps_y;
+    std::vector<char> fluid; ///< Non-solid points
+    bool any_x;
+    bool any_y;
+
+    double coefficient(double lambda) const;
+};
+
+#endif /* RESIDUAL_SMOOTHER_HPP */
@@ -0,0 +1,89 @@
+#include "../../../grid/test/cartesian_grid_test_interface.hpp"
+#include "../../../input_output/options.hpp"
+#include "../../point_functions.hpp"
+#include "../residual_smoother.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+const int nI = 12;
+const int nJ = 9;
+
+CartesianGridTestInterface uniform_flow(Options& opt)
+{
+    return CartesianGridTestInterface::fluid_grid(opt, nI, nJ, 0.1, 0.1,
+        [](int, int) { return Point(1.0, 0.5, 0.2, 40.0); });
+}
+
+memory::GridArray<Flux> varying_residual(int n)
+{
+    memory::GridArray<Flux> residual(n);
+    for (int ind = 0; ind < n; ind++) {
+        residual[ind] = {std::sin(0.7 * ind), std::cos(0.3 * ind),
+            0.01 * ind, 1.0 + 0.5 * std::sin(1.3 * ind)};
+    }
+    return residual;
+}
+} // namespace
+
+TEST(ResidualSmootherTest, testZeroCoefficientsAreIdentity)
+{
+    Options opt;
+    auto grid = uniform_flow(opt);
+    PointFunctions pf(opt.mach(), opt.gam());
+    ResidualSmoother smoother(1.0);
+    auto residual = varying_residual(grid.nPointsTotal);
+
+    // Local CFL numbers below the base one leave every eps at 0
+    auto smoothed = residual;
+    smoother.update_coefficients(grid, pf, 1e-6, {});
+    smoother.smooth(grid, &smoothed);
+    // A zero step makes eps 0 but still solves every line
+    auto solved = residual;
+    smoother.update_viscous_coefficients(grid, pf, 0.0, 100.0, 0.72);
+    smoother.smooth(grid, &solved);
+
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        ASSERT_EQ(smoothed[ind].rho, residual[ind].rho);
+        ASSERT_EQ(smoothed[ind].e, residual[ind].e);
+        ASSERT_EQ(solved[ind].rho, residual[ind].rho);
+        ASSERT_EQ(solved[ind].ru, residual[ind].ru);
+        ASSERT_EQ(solved[ind].rv, residual[ind].rv);
+        ASSERT_EQ(solved[ind].e, residual[ind].e);
+    }
+}
+
+TEST(ResidualSmootherTest, testUniformResidualIsUnchanged)
+{
+    Options opt;
+    auto grid = uniform_flow(opt);
+    PointFunctions pf(opt.mach(), opt.gam());
+    ResidualSmoother smoother(1.0);
+    const Flux uniform {0.3, -1.2, 2.5, 7.0};
+    memory::GridArray<Flux> residual(grid.nPointsTotal);
+    std::fill(residual.begin(), residual.end(), uniform);
+
+    // Local CFL numbers well above the base one
+    smoother.update_coefficients(grid, pf, 0.2, {});
+    smoother.smooth(grid, &residual);
+
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        ASSERT_NEAR(residual[ind].rho, uniform.rho, 1e-12);
+        ASSERT_NEAR(residual[ind].ru, uniform.ru, 1e-12);
+        ASSERT_NEAR(residual[ind].rv, uniform.rv, 1e-12);
+        ASSERT_NEAR(residual[ind].e, uniform.e, 1e-12);
+    }
+
+    // The same system smooths a varying residual
+    auto varying = varying_residual(grid.nPointsTotal);
+    auto smoothed = varying;
+    smoother.smooth(grid, &smoothed);
+    double change = 0.0;
+    for (int ind = 0; ind < grid.nPointsTotal; ind++) {
+        change += std::fabs(smoothed[ind].rho - varying[ind].rho);
+    }
+    ASSERT_GT(change, 1e-3);
+}
@@ -2,34 +2,56 @@
 #define FLAG_HANDLER_HPP
 #include <cstdint>
 
-extern const int FLUID_POINT;
-extern const int SOLID_POINT;
-extern const int GHOST_POINT;
-extern const int BOUNDARY_POINT;
+/**
+ * Point flags pack the point type and, for each direction, how many points
+ * a stencil can reach to the left and to the right. Everything here is
+ * constexpr so the decoding inlines into the stencil selectors.
+ */
+
+constexpr int FLUID_POINT = 0;
+constexpr int SOLID_POINT = 1;
+constexpr int GHOST_POINT = 2;
+constexpr int BOUNDARY_POINT = 3;
 
 namespace flag_functions {
 namespace constants {
-    extern const int TYPE_MASK_SIZE;
-    extern const int TYPE_MASK_SHIFT;
-    extern const int TYPE_MASK;
+    constexpr int TYPE_MASK_SIZE = 2;
+    constexpr int TYPE_MASK_SHIFT = 0;
+    constexpr int TYPE_MASK = ((1 << TYPE_MASK_SIZE) - 1) << TYPE_MASK_SHIFT;
+
+    constexpr int DERX_MASK_SIZE = 8;
+    constexpr int DERX_MASK_SHIFT = TYPE_MASK_SIZE + TYPE_MASK_SHIFT;
+    constexpr int DERX_MASK = ((1 << DERX_MASK_SIZE) - 1) << DERX_MASK_SHIFT;
+
+    constexpr int DERY_MASK_SIZE = 8;
+    constexpr int DERY_MASK_SHIFT = DERX_MASK_SIZE + DERX_MASK_SHIFT;
+    constexpr int DERY_MASK = ((1 << DERY_MASK_SIZE) - 1) << DERY_MASK_SHIFT;
+
+    constexpr int LEFT_MASK = 15;
+    constexpr int RIGHT_MASK = (15 << 4);
+} // namespace constants
 
-    extern const int DERX_MASK_SIZE;
-    extern const int DERX_MASK_SHIFT;
-    extern const int DERX_MASK;
+constexpr int point_type(int flag)
+{
+    return (flag & constants::TYPE_MASK) >> constants::TYPE_MASK_SHIFT;
+}
 
-    extern const int DERY_MASK_SIZE;
-    extern const int DERY_MASK_SHIFT;
-    extern const int DERY_MASK;
+constexpr int derx(int flag)
+{
+    return (flag & constants::DERX_MASK) >> constants::DERX_MASK_SHIFT;
+}
 
-    extern const int LEFT_MASK;
-    extern const int RIGHT_MASK;
+constexpr int dery(int flag)
+{
+    return (flag & constants::DERY_MASK) >> constants::DERY_MASK_SHIFT;
 }
 
-int point_type(int flag);
-int derx(int flag);
-int dery(int flag);
-int left(int der_flag);
-int right(int der_flag);
+constexpr int left(int der_flag) { return der_flag & constants::LEFT_MASK; }
+
+constexpr int right(int der_flag)
+{
+    return (der_flag & constants::RIGHT_MASK) >> 4;
+}
 
 } /*flag_functions namespace*/
 
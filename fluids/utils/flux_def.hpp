@@ -1,6 +1,7 @@
 #ifndef FLUX_DEF_HPP
 #define FLUX_DEF_HPP
 
+#include "storage_def.hpp"
 #include <ostream>
 
 struct Flux {
@@ -8,11 +9,11 @@ struct Flux {
     double ru;
     double rv;
     double e;
-    Flux operator+(const Flux& rhs)
+    Flux operator+(const Flux& rhs) const
     {
         return {rho + rhs.rho, ru + rhs.ru, rv + rhs.rv, e + rhs.e};
     }
-    Flux operator-(const Flux& rhs)
+    Flux operator-(const Flux& rhs) const
     {
         return {rho - rhs.rho, ru - rhs.ru, rv - rhs.rv, e - rhs.e};
     }
@@ -32,4 +33,24 @@ struct Flux {
     }
 };
 
+/**
+ * @brief Flux kept in a grid array, in storage_real. Computations take the
+ * Flux it converts to
+ */
+struct StoredFlux {
+    storage_real rho;
+    storage_real ru;
+    storage_real rv;
+    storage_real e;
+    StoredFlux() {}
+    StoredFlux(const Flux& f)
+        : rho(static_cast<storage_real>(f.rho))
+        , ru(static_cast<storage_real>(f.ru))
+        , rv(static_cast<storage_real>(f.rv))
+        , e(static_cast<storage_real>(f.e))
+    {
+    }
+    operator Flux() const { return {rho, ru, rv, e}; }
+};
+
 #endif /* FLUX_DEF_HPP */
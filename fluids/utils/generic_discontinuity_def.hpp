@@ -1,6 +1,7 @@
 #ifndef GENERIC_DISCONTINUITY_DEF_HPP
 #define GENERIC_DISCONTINUITY_DEF_HPP
 
+#include "binary_io.hpp"
 #include "point_def.hpp"
 class GenericDiscontinuity {
 public:
@@ -22,6 +23,25 @@ public:
     const Point& cleft() const { return left_p; }
     const Point& cright() const { return right_p; }
 
+    void save_state(std::ostream& os) const
+    {
+        binary_io::write(os, type);
+        binary_io::write(os, ind);
+        binary_io::write(os, frac);
+        binary_io::write(os, theta);
+        binary_io::write(os, left_p);
+        binary_io::write(os, right_p);
+    }
+    void load_state(std::istream& is)
+    {
+        binary_io::read(is, type);
+        binary_io::read(is, ind);
+        binary_io::read(is, frac);
+        binary_io::read(is, theta);
+        binary_io::read(is, left_p);
+        binary_io::read(is, right_p);
+    }
+
 private:
     Point left_p;
     Point right_p;
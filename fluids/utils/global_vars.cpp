@@ -1,5 +0,0 @@
-#include "global_vars.hpp"
-
-double max_mach_number = 0;
-double max_u_plus_c;
-double max_v_plus_c;
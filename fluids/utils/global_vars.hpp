@@ -1,11 +0,0 @@
-#ifndef GLOBAL_VARS_HPP
-#define GLOBAL_VARS_HPP
-
-/*Very special variables, only to be used in thread-safe ways, and without
- * which the code complexity would increase in bizare ways*/
-
-extern double max_mach_number;
-extern double max_u_plus_c;
-extern double max_v_plus_c;
-
-#endif /* GLOBAL_VARS_HPP */
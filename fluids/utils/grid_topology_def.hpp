@@ -0,0 +1,17 @@
+#ifndef GRID_TOPOLOGY_DEF_HPP
+#define GRID_TOPOLOGY_DEF_HPP
+
+#include "boundary_point_def.hpp"
+#include "memory/grid_allocator.hpp"
+#include <vector>
+
+/**
+ * @brief What a grid only reads once it is built: the flag of every point
+ * and the boundary points. Grids built from the same memory input share one
+ */
+struct GridTopology {
+    memory::GridArray<int> flags;
+    std::vector<BoundaryPoint> boundary;
+};
+
+#endif /* GRID_TOPOLOGY_DEF_HPP */
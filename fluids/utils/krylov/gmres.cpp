@@ -0,0 +1,168 @@
+#include "gmres.hpp"
+#include <algorithm>
+#include <cmath>
+
+double dot(
+    const memory::GridArray<Flux>& a, const memory::GridArray<Flux>& b)
+{
+    double sum = 0.0;
+    int n = static_cast<int>(a.size());
+#ifndef DEBUG
+#pragma omp parallel for reduction(+ : sum)
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        sum += a[ind].rho * b[ind].rho + a[ind].ru * b[ind].ru
+            + a[ind].rv * b[ind].rv + a[ind].e * b[ind].e;
+    }
+    return sum;
+}
+
+double norm(const memory::GridArray<Flux>& a) { return std::sqrt(dot(a, a)); }
+
+void axpy(
+    double alpha, const memory::GridArray<Flux>& x, memory::GridArray<Flux>* y)
+{
+    auto& out = *y;
+    int n = static_cast<int>(x.size());
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        out[ind].rho += alpha * x[ind].rho;
+        out[ind].ru += alpha * x[ind].ru;
+        out[ind].rv += alpha * x[ind].rv;
+        out[ind].e += alpha * x[ind].e;
+    }
+}
+
+void scale(double alpha, memory::GridArray<Flux>* x)
+{
+    auto& out = *x;
+    int n = static_cast<int>(out.size());
+#ifndef DEBUG
+#pragma omp parallel for
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        out[ind].rho *= alpha;
+        out[ind].ru *= alpha;
+        out[ind].rv *= alpha;
+        out[ind].e *= alpha;
+    }
+}
+
+Gmres::Gmres(int restart_in, int max_iterations_in, double tolerance_in)
+    : restart(std::max(1, restart_in))
+    , max_iterations(std::max(1, max_iterations_in))
+    , tolerance(tolerance_in)
+{
+}
+
+void Gmres::apply(const Operator& op, const Operator& preconditioner,
+    const Vector& in, Vector* out)
+{
+    if (preconditioner) {
+        preconditioner(in, &preconditioned);
+        op(preconditioned, out);
+    }
+    else {
+        op(in, out);
+    }
+}
+
+void Gmres::residual(
+    const Operator& op, const Vector& rhs, const Vector& x, Vector* r)
+{
+    op(x, r);
+    scale(-1.0, r);
+    axpy(1.0, rhs, r);
+}
+
+GmresResult Gmres::solve(const Operator& op, const Operator& preconditioner,
+    const Vector& rhs, Vector* x)
+{
+    size_t n = rhs.size();
+    basis.resize(restart + 1);
+    for (auto& v : basis) {
+        v.resize(n);
+    }
+    work.resize(n);
+    preconditioned.resize(n);
+
+    double rhs_norm = norm(rhs);
+    if (rhs_norm == 0.0) {
+        std::fill(x->begin(), x->end(), Flux {0.0, 0.0, 0.0, 0.0});
+        return {0, 0.0, true};
+    }
+    double target = tolerance * rhs_norm;
+
+    // Hessenberg matrix (column major), Givens rotations and the rotated
+    // right-hand side of the least squares problem
+    std::vector<std::vector<double>> h(
+        restart, std::vector<double>(restart + 1));
+    std::vector<double> cs(restart), sn(restart), g(restart + 1), y(restart);
+
+    residual(op, rhs, *x, &basis[0]);
+    double beta = norm(basis[0]);
+    int iterations = 0;
+    while (beta > target and iterations < max_iterations) {
+        scale(1.0 / beta, &basis[0]);
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = beta;
+        int j = 0;
+        while (j < restart and iterations < max_iterations) {
+            auto& w = basis[j + 1];
+            apply(op, preconditioner, basis[j], &w);
+            for (int i = 0; i <= j; i++) {
+                h[j][i] = dot(w, basis[i]);
+                axpy(-h[j][i], basis[i], &w);
+            }
+            h[j][j + 1] = norm(w);
+            if (h[j][j + 1] > 0.0) {
+                scale(1.0 / h[j][j + 1], &w);
+            }
+            for (int i = 0; i < j; i++) {
+                double tmp = cs[i] * h[j][i] + sn[i] * h[j][i + 1];
+                h[j][i + 1] = -sn[i] * h[j][i] + cs[i] * h[j][i + 1];
+                h[j][i] = tmp;
+            }
+            double r = std::hypot(h[j][j], h[j][j + 1]);
+            cs[j] = h[j][j] / r;
+            sn[j] = h[j][j + 1] / r;
+            h[j][j] = r;
+            h[j][j + 1] = 0.0;
+            g[j + 1] = -sn[j] * g[j];
+            g[j] = cs[j] * g[j];
+            iterations++;
+            j++;
+            if (std::fabs(g[j]) <= target) {
+                break;
+            }
+        }
+        for (int i = j - 1; i >= 0; i--) {
+            y[i] = g[i];
+            for (int k = i + 1; k < j; k++) {
+                y[i] -= h[k][i] * y[k];
+            }
+            y[i] /= h[i][i];
+        }
+        std::fill(work.begin(), work.end(), Flux {0.0, 0.0, 0.0, 0.0});
+        for (int i = 0; i < j; i++) {
+            axpy(y[i], basis[i], &work);
+        }
+        if (preconditioner) {
+            preconditioner(work, &preconditioned);
+            axpy(1.0, preconditioned, x);
+        }
+        else {
+            axpy(1.0, work, x);
+        }
+        beta = std::fabs(g[j]);
+        if (beta <= target or iterations >= max_iterations) {
+            break;
+        }
+        // Restart from the true residual
+        residual(op, rhs, *x, &basis[0]);
+        beta = norm(basis[0]);
+    }
+    return {iterations, beta / rhs_norm, beta <= target};
+}
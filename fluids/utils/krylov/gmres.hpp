@@ -0,0 +1,66 @@
+#ifndef GMRES_HPP
+#define GMRES_HPP
+
+#include "../flux_def.hpp"
+#include "../memory/grid_allocator.hpp"
+#include <functional>
+#include <vector>
+
+/**
+ * @name Vector operations on grid variations, parallel over the points
+ * @{ */
+double dot(const memory::GridArray<Flux>& a, const memory::GridArray<Flux>& b);
+double norm(const memory::GridArray<Flux>& a);
+/** y += alpha * x */
+void axpy(
+    double alpha, const memory::GridArray<Flux>& x, memory::GridArray<Flux>* y);
+void scale(double alpha, memory::GridArray<Flux>* x);
+/**  @} */
+
+struct GmresResult {
+    int iterations;
+    double residual; ///< Final residual norm relative to the right-hand side
+    bool converged;
+};
+
+/**
+ * \class Gmres
+ * @brief Restarted, right-preconditioned, matrix-free GMRES
+ *
+ * The operator and the preconditioner are only given by their action on a
+ * vector, so Jacobians can be approximated by finite differences of time
+ * derivatives. Iterations stop once the residual norm drops below
+ * tolerance times the norm of the right-hand side, or after max_iterations
+ * products with the operator. The Krylov basis is kept between calls.
+ */
+class Gmres {
+public:
+    typedef memory::GridArray<Flux> Vector;
+    /** Computes out = A in */
+    typedef std::function<void(const Vector& in, Vector* out)> Operator;
+
+    Gmres(int restart, int max_iterations, double tolerance);
+
+    /**
+     * @param preconditioner Approximation of the inverse of the operator,
+     * or an empty function for none
+     * @param x Initial guess, overwritten with the solution
+     */
+    GmresResult solve(const Operator& op, const Operator& preconditioner,
+        const Vector& rhs, Vector* x);
+
+private:
+    const int restart;
+    const int max_iterations;
+    const double tolerance;
+    std::vector<Vector> basis;
+    Vector work;
+    Vector preconditioned;
+
+    void apply(const Operator& op, const Operator& preconditioner,
+        const Vector& in, Vector* out);
+    void residual(const Operator& op, const Vector& rhs, const Vector& x,
+        Vector* r);
+};
+
+#endif /* GMRES_HPP */
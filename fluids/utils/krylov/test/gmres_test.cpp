@@ -0,0 +1,82 @@
+#include "../gmres.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+typedef Gmres::Vector Vector;
+
+/** Non symmetric tridiagonal operator, the same on every component */
+void tridiagonal(const Vector& in, Vector* out)
+{
+    int n = static_cast<int>(in.size());
+    for (int i = 0; i < n; i++) {
+        Flux f = {3.0 * in[i].rho, 3.0 * in[i].ru, 3.0 * in[i].rv,
+            3.0 * in[i].e};
+        if (i > 0) {
+            f.rho -= 1.5 * in[i - 1].rho;
+            f.ru -= 1.5 * in[i - 1].ru;
+            f.rv -= 1.5 * in[i - 1].rv;
+            f.e -= 1.5 * in[i - 1].e;
+        }
+        if (i < n - 1) {
+            f.rho -= 0.5 * in[i + 1].rho;
+            f.ru -= 0.5 * in[i + 1].ru;
+            f.rv -= 0.5 * in[i + 1].rv;
+            f.e -= 0.5 * in[i + 1].e;
+        }
+        (*out)[i] = f;
+    }
+}
+
+Vector right_hand_side(int n)
+{
+    Vector rhs(n);
+    for (int i = 0; i < n; i++) {
+        rhs[i] = {1.0, std::sin(0.3 * i), -2.0 * i / n, 0.0};
+    }
+    return rhs;
+}
+
+double relative_residual(const Vector& rhs, const Vector& x)
+{
+    Vector ax(x.size());
+    tridiagonal(x, &ax);
+    axpy(-1.0, rhs, &ax);
+    return norm(ax) / norm(rhs);
+}
+} // namespace
+
+TEST(GmresTest, testSolvesWithRestarts)
+{
+    const int n = 50;
+    auto rhs = right_hand_side(n);
+    Vector x(n, {0.0, 0.0, 0.0, 0.0});
+    Gmres gmres(5, 200, 1e-10);
+    auto result = gmres.solve(tridiagonal, Gmres::Operator(), rhs, &x);
+    EXPECT_TRUE(result.converged);
+    EXPECT_LT(result.residual, 1e-10);
+    EXPECT_LT(relative_residual(rhs, x), 1e-9);
+}
+
+TEST(GmresTest, testPreconditionerAndZeroRightHandSide)
+{
+    const int n = 50;
+    auto rhs = right_hand_side(n);
+    Vector x(n, {0.0, 0.0, 0.0, 0.0});
+    Gmres gmres(30, 30, 1e-8);
+    auto jacobi = [](const Vector& in, Vector* out) {
+        *out = in;
+        scale(1 / 3.0, out);
+    };
+    auto result = gmres.solve(tridiagonal, jacobi, rhs, &x);
+    EXPECT_TRUE(result.converged);
+    EXPECT_LT(relative_residual(rhs, x), 1e-7);
+
+    Vector zero(n, {0.0, 0.0, 0.0, 0.0});
+    result = gmres.solve(tridiagonal, jacobi, zero, &x);
+    EXPECT_TRUE(result.converged);
+    EXPECT_EQ(result.iterations, 0);
+    EXPECT_DOUBLE_EQ(norm(x), 0.0);
+}
@@ -0,0 +1,59 @@
+#include "grid_allocator.hpp"
+#include <cstdlib>
+#include <cstring>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace memory {
+
+namespace {
+bool huge_pages_enabled = false;
+bool first_touch_enabled = true;
+
+void zero_fill(char* bytes, long count, std::size_t size)
+{
+    if (first_touch_enabled) {
+#ifndef DEBUG
+#pragma omp parallel for schedule(static)
+#endif
+        for (long i = 0; i < count; i++) {
+            std::memset(bytes + i * size, 0, size);
+        }
+    }
+    else {
+        std::memset(bytes, 0, count * size);
+    }
+}
+} // namespace
+
+void set_huge_pages(bool enabled) { huge_pages_enabled = enabled; }
+bool huge_pages() { return huge_pages_enabled; }
+
+void set_first_touch(bool enabled) { first_touch_enabled = enabled; }
+bool first_touch() { return first_touch_enabled; }
+
+void* allocate(std::size_t count, std::size_t size)
+{
+    std::size_t bytes = count * size;
+    if (bytes == 0) {
+        bytes = ALIGNMENT;
+    }
+    bool huge = huge_pages_enabled and bytes >= HUGE_PAGE_SIZE;
+    void* p = nullptr;
+    if (posix_memalign(&p, huge ? HUGE_PAGE_SIZE : ALIGNMENT, bytes) != 0) {
+        throw std::bad_alloc();
+    }
+#ifdef __linux__
+    if (huge) {
+        // Only advice, the kernel falls back to small pages
+        madvise(p, bytes, MADV_HUGEPAGE);
+    }
+#endif
+    zero_fill(static_cast<char*>(p), static_cast<long>(count), size);
+    return p;
+}
+
+void release(void* p) { std::free(p); }
+
+} // namespace memory
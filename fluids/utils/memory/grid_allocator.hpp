@@ -0,0 +1,128 @@
+/**
+ * \file grid_allocator.hpp
+ * @brief Allocation of the large per-point arrays of the solver
+ */
+#ifndef GRID_ALLOCATOR_HPP
+#define GRID_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace memory {
+
+/** Alignment of every grid array, one cache line */
+const std::size_t ALIGNMENT = 64;
+
+/** Arrays from this size on are backed by transparent huge pages */
+const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/**
+ * @brief Enables transparent huge pages for the arrays allocated from now on
+ */
+void set_huge_pages(bool enabled);
+bool huge_pages();
+
+/**
+ * @brief Enables the parallel first touch of the arrays allocated from now on
+ */
+void set_first_touch(bool enabled);
+bool first_touch();
+
+/**
+ * @brief Aligned memory for count elements of the given size, zero filled
+ *
+ * With first touch enabled the zeros are written inside an OpenMP static
+ * loop over the elements. The pages then start on the NUMA node of the
+ * thread that gets those points in the other static loops over the points,
+ * such as the stage updates and get_dt. The time derivative interior does
+ * not follow that partition: its tiles are handed out as tasks, in a shape
+ * the tuner may only pick after the arrays exist, so part of what it reads
+ * can sit on other nodes.
+ */
+void* allocate(std::size_t count, std::size_t size);
+void release(void* p);
+
+/**
+ * \class GridAllocator
+ * @brief Allocator of the grid arrays, see memory::allocate
+ *
+ * Default construction leaves elements as allocate() wrote them, so resizing
+ * a grid array does not touch every page again from a single thread.
+ */
+template <typename T>
+class GridAllocator {
+public:
+    typedef T value_type;
+
+    GridAllocator() = default;
+    template <typename U>
+    GridAllocator(const GridAllocator<U>&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(memory::allocate(n, sizeof(T)));
+    }
+    void deallocate(T* p, std::size_t) noexcept { release(p); }
+
+    template <typename U>
+    void construct(U* p) noexcept
+    {
+        ::new (static_cast<void*>(p)) U;
+    }
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args)
+    {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const GridAllocator<T>&, const GridAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const GridAllocator<T>&, const GridAllocator<U>&)
+{
+    return false;
+}
+
+/** Array with one entry per grid point */
+template <typename T>
+using GridArray = std::vector<T, GridAllocator<T>>;
+
+/**
+ * @brief Copies values into a grid array of T, converting each of them, in
+ * the same static partition the pages were touched with
+ */
+template <typename T, typename U, typename Allocator>
+GridArray<T> convert_to_grid_array(const std::vector<U, Allocator>& values)
+{
+    GridArray<T> array(values.size());
+    long n = static_cast<long>(values.size());
+#ifndef DEBUG
+#pragma omp parallel for schedule(static)
+#endif
+    for (long i = 0; i < n; i++) {
+        array[i] = T(values[i]);
+    }
+    return array;
+}
+
+/**
+ * @brief Copies values into a grid array of the same type
+ */
+template <typename T, typename Allocator>
+GridArray<T> to_grid_array(const std::vector<T, Allocator>& values)
+{
+    return convert_to_grid_array<T>(values);
+}
+
+} // namespace memory
+
+#endif /* GRID_ALLOCATOR_HPP */
@@ -0,0 +1,60 @@
+#include "../grid_allocator.hpp"
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+struct Cell {
+    double a, b, c;
+};
+
+bool aligned_to(const void* p, std::size_t alignment)
+{
+    return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+}
+} // namespace
+
+TEST(GridAllocatorTest, ArraysAreAlignedAndZeroFilled)
+{
+    for (bool touch : {true, false}) {
+        memory::set_first_touch(touch);
+        memory::GridArray<Cell> cells(1001);
+        EXPECT_TRUE(aligned_to(cells.data(), memory::ALIGNMENT));
+        for (auto& cell : cells) {
+            EXPECT_EQ(cell.a, 0.0);
+            EXPECT_EQ(cell.b, 0.0);
+            EXPECT_EQ(cell.c, 0.0);
+        }
+    }
+    memory::set_first_touch(true);
+}
+
+TEST(GridAllocatorTest, HugePagesAlignLargeArrays)
+{
+    memory::set_huge_pages(true);
+    memory::GridArray<double> large(memory::HUGE_PAGE_SIZE / sizeof(double));
+    memory::GridArray<double> small(100);
+    memory::set_huge_pages(false);
+    EXPECT_TRUE(aligned_to(large.data(), memory::HUGE_PAGE_SIZE));
+    EXPECT_TRUE(aligned_to(small.data(), memory::ALIGNMENT));
+    EXPECT_EQ(large.back(), 0.0);
+}
+
+TEST(GridAllocatorTest, ValuesSurviveCopiesAndResizes)
+{
+    std::vector<int> values(517);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int>(i) - 200;
+    }
+    auto array = memory::to_grid_array(values);
+    ASSERT_EQ(array.size(), values.size());
+    array.resize(2000);
+    for (size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(array[i], values[i]);
+    }
+    EXPECT_EQ(array.back(), 0);
+
+    memory::GridArray<int> filled(10, 7);
+    EXPECT_EQ(filled[9], 7);
+}
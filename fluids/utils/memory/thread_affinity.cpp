@@ -0,0 +1,78 @@
+#include "thread_affinity.hpp"
+#include <iostream>
+#include <vector>
+#ifndef DEBUG
+#include "omp.h"
+#endif
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace memory {
+
+namespace {
+#ifdef __linux__
+std::vector<int> allowed_cores()
+{
+    std::vector<int> cores;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) != 0) {
+        return cores;
+    }
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+        if (CPU_ISSET(cpu, &set)) {
+            cores.push_back(cpu);
+        }
+    }
+    return cores;
+}
+
+void pin_to(int core)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+    sched_setaffinity(0, sizeof(set), &set);
+}
+#endif
+} // namespace
+
+void pin_threads(const std::string& policy)
+{
+    if (policy == "NONE") {
+        return;
+    }
+    if (policy != "COMPACT" and policy != "SPREAD") {
+        std::cerr << "Thread affinity " << policy << " not found!!!"
+                  << std::endl;
+        throw(-1);
+    }
+#ifdef __linux__
+    auto cores = allowed_cores();
+    if (cores.empty()) {
+        return;
+    }
+    bool spread = policy == "SPREAD";
+    int n_cores = static_cast<int>(cores.size());
+#ifndef DEBUG
+#pragma omp parallel
+    {
+        int thread = omp_get_thread_num();
+        int threads = omp_get_num_threads();
+        int slot = spread ? static_cast<int>(
+                       static_cast<long>(thread) * n_cores / threads)
+                          : thread;
+        pin_to(cores[slot % n_cores]);
+    }
+#else
+    pin_to(cores[0]);
+    (void)spread;
+#endif
+#else
+    std::cerr << "Thread affinity needs Linux, threads are not pinned"
+              << std::endl;
+#endif
+}
+
+} // namespace memory
@@ -0,0 +1,25 @@
+/**
+ * \file thread_affinity.hpp
+ * @brief Pinning of the OpenMP threads to cores
+ */
+#ifndef THREAD_AFFINITY_HPP
+#define THREAD_AFFINITY_HPP
+
+#include <string>
+
+namespace memory {
+
+/**
+ * @brief Pins each thread of the OpenMP team to one of the allowed cores
+ *
+ * COMPACT fills neighbouring cores first, SPREAD spaces the threads evenly
+ * over the allowed cores, so both sockets are used before the threads
+ * share one. NONE leaves the placement to the OpenMP runtime. Threads keep
+ * their core while the team size does not change, which keeps them next to
+ * the pages they touched first.
+ */
+void pin_threads(const std::string& policy);
+
+} // namespace memory
+
+#endif /* THREAD_AFFINITY_HPP */
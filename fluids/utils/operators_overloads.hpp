@@ -1,20 +1,76 @@
 #ifndef OPERATORS_OVERLOADS_HPP
 #define OPERATORS_OVERLOADS_HPP
-struct Point;
-struct Flux;
+
+#include "flux_def.hpp"
+#include "point_def.hpp"
+
+/**
+ * Point and Flux arithmetic is defined here, inline, so the stage
+ * combinations of the integrators and the convection kernels compile to
+ * straight line code on the components instead of a call per operator.
+ */
+
 class ShockDiscontinuity;
-Point operator+(const Point& p1, const Point& p2);
-Point operator-(const Point& p1, const Point& p2);
-Point operator/(const Point& p1, const double& d);
-Point operator*(const double& d, const Point& p1);
-Point operator*(const Point& p1, const double& d);
-
-Flux operator+(const Flux& f1, const Point& p2);
-Point operator+(const Point& p1, const Flux& f2);
-Flux operator*(const Flux& f1, const double& d);
-Flux operator-(const Flux& f1);
-Flux operator*(const double& d, const Flux& f1);
-Flux operator/(const Flux& f1, const double& d);
-bool operator==(const Point& lhs, const Point& rhs);
+
+inline Point operator+(const Point& p1, const Point& p2)
+{
+    return {p1.rho() + p2.rho(), p1.ru() + p2.ru(), p1.rv() + p2.rv(),
+        p1.e() + p2.e()};
+}
+
+inline Point operator-(const Point& p1, const Point& p2)
+{
+    return {p1.rho() - p2.rho(), p1.ru() - p2.ru(), p1.rv() - p2.rv(),
+        p1.e() - p2.e()};
+}
+
+inline Point operator/(const Point& p1, const double& d)
+{
+    return {p1.rho() / d, p1.ru() / d, p1.rv() / d, p1.e() / d};
+}
+
+inline Point operator*(const double& d, const Point& p1)
+{
+    return {p1.rho() * d, p1.ru() * d, p1.rv() * d, p1.e() * d};
+}
+
+inline Point operator*(const Point& p1, const double& d)
+{
+    return {p1.rho() * d, p1.ru() * d, p1.rv() * d, p1.e() * d};
+}
+
+inline Flux operator+(const Flux& f1, const Point& p2)
+{
+    return {f1.rho + p2.rho(), f1.ru + p2.ru(), f1.rv + p2.rv(), f1.e + p2.e()};
+}
+
+inline Point operator+(const Point& p1, const Flux& f2)
+{
+    return {f2.rho + p1.rho(), f2.ru + p1.ru(), f2.rv + p1.rv(), f2.e + p1.e()};
+}
+
+inline Flux operator*(const Flux& f1, const double& d)
+{
+    return {f1.rho * d, f1.ru * d, f1.rv * d, f1.e * d};
+}
+
+inline Flux operator*(const double& d, const Flux& f1) { return f1 * d; }
+
+inline Flux operator-(const Flux& f1)
+{
+    return {-f1.rho, -f1.ru, -f1.rv, -f1.e};
+}
+
+inline Flux operator/(const Flux& f1, const double& d)
+{
+    return {f1.rho / d, f1.ru / d, f1.rv / d, f1.e / d};
+}
+
+inline bool operator==(const Point& lhs, const Point& rhs)
+{
+    return (lhs.rho() == rhs.rho() and lhs.ru() == rhs.ru()
+        and lhs.rv() == rhs.rv() and lhs.e() == rhs.e());
+}
+
 bool operator==(const ShockDiscontinuity& lhs, const ShockDiscontinuity& rhs);
 #endif /* OPERATORS_OVERLOADS_HPP */
@@ -0,0 +1,126 @@
+#include "communicator.hpp"
+#include <iostream>
+#include <numeric>
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+namespace parallel {
+
+Environment::Environment()
+    : cout_buffer(std::cout.rdbuf())
+{
+#ifdef USE_MPI
+    int initialized;
+    MPI_Initialized(&initialized);
+    if (!initialized) {
+        MPI_Init(nullptr, nullptr);
+    }
+#endif
+    if (!is_root()) {
+        // A stream without buffer drops everything written to it
+        std::cout.rdbuf(nullptr);
+    }
+}
+
+Environment::~Environment()
+{
+    std::cout.rdbuf(cout_buffer);
+    std::cout.clear();
+#ifdef USE_MPI
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (!finalized) {
+        MPI_Finalize();
+    }
+#endif
+}
+
+#ifdef USE_MPI
+namespace {
+bool mpi_running()
+{
+    int initialized, finalized;
+    MPI_Initialized(&initialized);
+    MPI_Finalized(&finalized);
+    return initialized and !finalized;
+}
+
+double reduce(double value, MPI_Op op)
+{
+    if (!mpi_running()) {
+        return value;
+    }
+    double result;
+    MPI_Allreduce(&value, &result, 1, MPI_DOUBLE, op, MPI_COMM_WORLD);
+    return result;
+}
+} // namespace
+
+int rank()
+{
+    if (!mpi_running()) {
+        return 0;
+    }
+    int r;
+    MPI_Comm_rank(MPI_COMM_WORLD, &r);
+    return r;
+}
+
+int size()
+{
+    if (!mpi_running()) {
+        return 1;
+    }
+    int s;
+    MPI_Comm_size(MPI_COMM_WORLD, &s);
+    return s;
+}
+
+double min(double value) { return reduce(value, MPI_MIN); }
+double max(double value) { return reduce(value, MPI_MAX); }
+double sum(double value) { return reduce(value, MPI_SUM); }
+
+bool any(bool value)
+{
+    if (!mpi_running()) {
+        return value;
+    }
+    int local = value ? 1 : 0, result;
+    MPI_Allreduce(&local, &result, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+    return result != 0;
+}
+
+void gather(const std::vector<double>& values, const std::vector<int>& counts,
+    std::vector<double>* all)
+{
+    if (!mpi_running()) {
+        *all = values;
+        return;
+    }
+    std::vector<int> displacements(counts.size(), 0);
+    std::partial_sum(
+        counts.begin(), counts.end() - 1, displacements.begin() + 1);
+    if (is_root()) {
+        all->resize(displacements.back() + counts.back());
+    }
+    MPI_Gatherv(values.data(), static_cast<int>(values.size()), MPI_DOUBLE,
+        is_root() ? all->data() : nullptr, counts.data(),
+        displacements.data(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+}
+#else
+int rank() { return 0; }
+int size() { return 1; }
+double min(double value) { return value; }
+double max(double value) { return value; }
+double sum(double value) { return value; }
+bool any(bool value) { return value; }
+
+void gather(const std::vector<double>& values, const std::vector<int>&,
+    std::vector<double>* all)
+{
+    *all = values;
+}
+#endif
+
+} // namespace parallel
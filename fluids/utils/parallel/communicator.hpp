@@ -0,0 +1,60 @@
+/**
+ * \file communicator.hpp
+ * @brief Process level parallelism: MPI start-up and global reductions
+ *
+ * Built without MPI (the default) there is a single process and every
+ * function here is a no-op, so callers never need to check for USE_MPI.
+ */
+#ifndef COMMUNICATOR_HPP
+#define COMMUNICATOR_HPP
+
+#include <iosfwd>
+#include <vector>
+
+namespace parallel {
+
+/**
+ * \class Environment
+ * @brief Initializes MPI on construction and finalizes it on destruction
+ *
+ * Only the first process writes to std::cout while the environment exists,
+ * so progress lines and messages are not repeated by every process. Errors
+ * written to std::cerr are kept on every process.
+ */
+class Environment {
+public:
+    Environment();
+    ~Environment();
+    Environment(const Environment&) = delete;
+    Environment& operator=(const Environment&) = delete;
+
+private:
+    std::streambuf* cout_buffer;
+};
+
+int rank();                ///< Rank of this process, 0 without MPI
+int size();                ///< Number of processes, 1 without MPI
+inline bool is_root() { return rank() == 0; }
+
+/**
+ * @name Reductions over every process
+ * @{ */
+double min(double value);
+double max(double value);
+double sum(double value);
+bool any(bool value);
+/**  @} */
+
+/**
+ * @brief Concatenates the values of every process, in rank order, on the
+ * first process
+ *
+ * @param counts Number of values sent by each process
+ * @param all Receives the values on the first process, untouched elsewhere
+ */
+void gather(const std::vector<double>& values, const std::vector<int>& counts,
+    std::vector<double>* all);
+
+} // namespace parallel
+
+#endif /* COMMUNICATOR_HPP */
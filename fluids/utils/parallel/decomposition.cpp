@@ -0,0 +1,173 @@
+#include "decomposition.hpp"
+#include "../flag_handler.hpp"
+#include <algorithm>
+#include <iostream>
+
+namespace parallel {
+
+namespace {
+/**
+ * @brief Block c of n points split in parts, sizes differ by at most one
+ */
+Range block(int n, int parts, int c)
+{
+    return {static_cast<int>(static_cast<long>(n) * c / parts),
+        static_cast<int>(static_cast<long>(n) * (c + 1) / parts)};
+}
+
+int clamp_der(int der_flag, int to_left, int to_right)
+{
+    int left = std::min(flag_functions::left(der_flag), to_left);
+    int right = std::min(flag_functions::right(der_flag), to_right);
+    return left | (right << 4);
+}
+} // namespace
+
+std::pair<int, int> Decomposition::process_grid(
+    int nPointsI, int nPointsJ, int procs)
+{
+    std::pair<int, int> best(procs, 1);
+    double best_perimeter = -1;
+    for (int pi = 1; pi <= procs; pi++) {
+        if (procs % pi != 0) {
+            continue;
+        }
+        int pj = procs / pi;
+        double perimeter = static_cast<double>(nPointsI) / pi
+            + static_cast<double>(nPointsJ) / pj;
+        if (best_perimeter < 0 or perimeter < best_perimeter) {
+            best_perimeter = perimeter;
+            best = std::make_pair(pi, pj);
+        }
+    }
+    return best;
+}
+
+Decomposition::Decomposition(
+    int nPointsI_in, int nPointsJ_in, int procs, int rank, int halo)
+    : global_i(nPointsI_in)
+    , global_j(nPointsJ_in)
+    , my_rank(rank)
+    , halo_width(halo)
+{
+    if (procs < 1 or rank < 0 or rank >= procs) {
+        std::cerr << "Invalid rank " << rank << " of " << procs
+                  << " processes" << std::endl;
+        throw(-1);
+    }
+    auto grid = process_grid(global_i, global_j, procs);
+    n_procs_i = grid.first;
+    n_procs_j = grid.second;
+    int ci = rank / n_procs_j;
+    int cj = rank % n_procs_j;
+    owned_i_r = block(global_i, n_procs_i, ci);
+    owned_j_r = block(global_j, n_procs_j, cj);
+    // Ghost layers must come from the direct neighbors only
+    if ((n_procs_i > 1 and global_i / n_procs_i < halo)
+        or (n_procs_j > 1 and global_j / n_procs_j < halo)) {
+        std::cerr << "A " << global_i << "x" << global_j
+                  << " grid is too small for " << n_procs_i << "x"
+                  << n_procs_j << " blocks with " << halo << " ghost layers"
+                  << std::endl;
+        throw(-1);
+    }
+    bool lower_i = ci > 0, upper_i = ci < n_procs_i - 1;
+    bool lower_j = cj > 0, upper_j = cj < n_procs_j - 1;
+    local_i_r = {owned_i_r.begin - (lower_i ? halo : 0),
+        owned_i_r.end + (upper_i ? halo : 0)};
+    local_j_r = {owned_j_r.begin - (lower_j ? halo : 0),
+        owned_j_r.end + (upper_j ? halo : 0)};
+    Range inner_i = {owned_i_r.begin + (lower_i ? halo : 0),
+        owned_i_r.end - (upper_i ? halo : 0)};
+    Range inner_j = {owned_j_r.begin + (lower_j ? halo : 0),
+        owned_j_r.end - (upper_j ? halo : 0)};
+
+    owned.resize(nPointsTotal());
+    for (int li = 0; li < nPointsI(); li++) {
+        for (int lj = 0; lj < nPointsJ(); lj++) {
+            int gi = local_i_r.begin + li;
+            int gj = local_j_r.begin + lj;
+            int ind = li * nPointsJ() + lj;
+            owned[ind] = owned_i_r.contains(gi) and owned_j_r.contains(gj);
+            if (!owned[ind]) {
+                ghost.push_back(ind);
+            }
+            else if (inner_i.contains(gi) and inner_j.contains(gj)) {
+                inner.push_back(ind);
+            }
+            else {
+                outer.push_back(ind);
+            }
+        }
+    }
+
+    for (int di = -1; di <= 1; di++) {
+        for (int dj = -1; dj <= 1; dj++) {
+            int ni = ci + di, nj = cj + dj;
+            if ((di == 0 and dj == 0) or ni < 0 or ni >= n_procs_i or nj < 0
+                or nj >= n_procs_j) {
+                continue;
+            }
+            Neighbor n;
+            n.rank = ni * n_procs_j + nj;
+            n.di = di;
+            n.dj = dj;
+            for (int ghosts = 0; ghosts < 2; ghosts++) {
+                auto& list = ghosts ? n.recv : n.send;
+                auto rows = region(di, owned_i_r, local_i_r, ghosts);
+                auto cols = region(dj, owned_j_r, local_j_r, ghosts);
+                for (int gi = rows.begin; gi < rows.end; gi++) {
+                    for (int gj = cols.begin; gj < cols.end; gj++) {
+                        list.push_back(local_ind(gi * global_j + gj));
+                    }
+                }
+            }
+            neighbor_list.push_back(n);
+        }
+    }
+}
+
+Range Decomposition::region(
+    int d, const Range& owned_r, const Range& local_r, bool ghosts) const
+{
+    if (d == 0) {
+        return owned_r;
+    }
+    if (ghosts) {
+        return d < 0 ? Range {local_r.begin, owned_r.begin}
+                     : Range {owned_r.end, local_r.end};
+    }
+    return d < 0 ? Range {owned_r.begin, owned_r.begin + halo_width}
+                 : Range {owned_r.end - halo_width, owned_r.end};
+}
+
+int Decomposition::global_ind(int local_ind) const
+{
+    int gi = local_i_r.begin + local_ind / nPointsJ();
+    int gj = local_j_r.begin + local_ind % nPointsJ();
+    return gi * global_j + gj;
+}
+
+int Decomposition::local_ind(int global_ind) const
+{
+    int gi = global_ind / global_j;
+    int gj = global_ind % global_j;
+    if (!local_i_r.contains(gi) or !local_j_r.contains(gj)) {
+        return -1;
+    }
+    return (gi - local_i_r.begin) * nPointsJ() + (gj - local_j_r.begin);
+}
+
+int Decomposition::local_flag(int flag, int local_ind) const
+{
+    using namespace flag_functions;
+    int li = local_ind / nPointsJ();
+    int lj = local_ind % nPointsJ();
+    int derx_flag = clamp_der(derx(flag), lj, nPointsJ() - 1 - lj);
+    int dery_flag = clamp_der(dery(flag), li, nPointsI() - 1 - li);
+    return (flag & constants::TYPE_MASK)
+        | (derx_flag << constants::DERX_MASK_SHIFT)
+        | (dery_flag << constants::DERY_MASK_SHIFT);
+}
+
+} // namespace parallel
@@ -0,0 +1,127 @@
+/**
+ * \file decomposition.hpp
+ * @brief Block decomposition of the grid among processes
+ */
+#ifndef DECOMPOSITION_HPP
+#define DECOMPOSITION_HPP
+
+#include <utility>
+#include <vector>
+
+namespace parallel {
+
+/**
+ * @brief Ghost layers around each block. Stencils reach 3 points (WENO)
+ * and derivative flags are compared against at most 4 neighbors, so owned
+ * points see the same stencils as in a single process run
+ */
+const int HALO_WIDTH = 4;
+
+/**
+ * @brief Half-open range [begin, end) of grid lines or columns
+ */
+struct Range {
+    int begin;
+    int end;
+    int size() const { return end - begin; }
+    bool contains(int k) const { return k >= begin and k < end; }
+};
+
+/**
+ * \class Decomposition
+ * @brief Splits an nPointsI x nPointsJ grid into one block per process
+ *
+ * Processes are arranged in a procs_i x procs_j grid chosen to minimize the
+ * halo perimeter, and each one owns a block of lines (i) and columns (j)
+ * whose sizes differ by at most one point. The local grid of a process is
+ * its block grown by HALO_WIDTH ghost points on every side that faces
+ * another block. Local indices follow the CartesianGrid convention
+ * (local_i * nPointsJ() + local_j), as does the rank ordering
+ * (coord_i * procs_j + coord_j).
+ */
+class Decomposition {
+public:
+    Decomposition(int nPointsI, int nPointsJ, int procs, int rank,
+        int halo = HALO_WIDTH);
+
+    /**
+     * @brief Process grid (procs_i, procs_j) used for procs processes
+     */
+    static std::pair<int, int> process_grid(
+        int nPointsI, int nPointsJ, int procs);
+
+    /**
+     * @brief Points exchanged with one of the (up to 8) neighbor blocks,
+     * as local indices in the same (row major) order on both sides
+     */
+    struct Neighbor {
+        int rank;
+        int di, dj; ///< Position of the neighbor relative to this block
+        std::vector<int> send;
+        std::vector<int> recv;
+    };
+
+    int rank() const { return my_rank; }
+    int procs_i() const { return n_procs_i; }
+    int procs_j() const { return n_procs_j; }
+    int halo() const { return halo_width; }
+
+    /**
+     * @name Global ranges owned by and stored in this process
+     * @{ */
+    const Range& owned_i() const { return owned_i_r; }
+    const Range& owned_j() const { return owned_j_r; }
+    const Range& local_i() const { return local_i_r; }
+    const Range& local_j() const { return local_j_r; }
+    /**  @} */
+
+    int global_nPointsI() const { return global_i; }
+    int global_nPointsJ() const { return global_j; }
+    int nPointsI() const { return local_i_r.size(); }
+    int nPointsJ() const { return local_j_r.size(); }
+    int nPointsTotal() const { return nPointsI() * nPointsJ(); }
+    int nPointsOwned() const { return owned_i_r.size() * owned_j_r.size(); }
+
+    int global_ind(int local_ind) const;
+    /**
+     * @return Local index of a global one, or -1 if it is not stored here
+     */
+    int local_ind(int global_ind) const;
+    bool is_owned(int local_ind) const { return owned[local_ind] != 0; }
+
+    /**
+     * @name Point lists (local indices)
+     * @{ */
+    /// Owned points whose stencils only reach owned points
+    const std::vector<int>& inner_points() const { return inner; }
+    /// Owned points whose stencils reach ghost points
+    const std::vector<int>& outer_points() const { return outer; }
+    /// Copies of points owned by other processes
+    const std::vector<int>& ghost_points() const { return ghost; }
+    /**  @} */
+
+    const std::vector<Neighbor>& neighbors() const { return neighbor_list; }
+
+    /**
+     * @brief Limits the stencil widths stored in a global flag to the local
+     * grid, so no stencil of a ghost point leaves the local arrays
+     */
+    int local_flag(int flag, int local_ind) const;
+
+private:
+    int global_i, global_j;
+    int n_procs_i, n_procs_j;
+    int my_rank;
+    int halo_width;
+    Range owned_i_r, owned_j_r, local_i_r, local_j_r;
+    std::vector<char> owned;
+    std::vector<int> inner, outer, ghost;
+    std::vector<Neighbor> neighbor_list;
+
+    Range region(int d, const Range& owned_r, const Range& local_r,
+        bool ghosts) const;
+};
+
+} // namespace parallel
+
+#endif /* DECOMPOSITION_HPP */
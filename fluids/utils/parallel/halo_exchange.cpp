@@ -0,0 +1,55 @@
+#include "halo_exchange.hpp"
+#include <utility>
+
+namespace parallel {
+
+#ifdef USE_MPI
+namespace {
+/**
+ * @brief Message tag of data sent towards the neighbor at (di, dj)
+ */
+int direction_tag(int di, int dj) { return (di + 1) * 3 + (dj + 1); }
+} // namespace
+#endif
+
+HaloExchange::HaloExchange(
+    std::shared_ptr<const Decomposition> decomposition_in)
+    : decomposition(std::move(decomposition_in))
+{
+    for (auto& neighbor : decomposition->neighbors()) {
+        links.push_back({std::vector<double>(4 * neighbor.send.size()),
+            std::vector<double>(4 * neighbor.recv.size())});
+    }
+#ifdef USE_MPI
+    requests.resize(2 * links.size());
+#endif
+}
+
+void HaloExchange::post()
+{
+#ifdef USE_MPI
+    auto& neighbors = decomposition->neighbors();
+    for (size_t n = 0; n < links.size(); n++) {
+        auto& neighbor = neighbors[n];
+        auto& link = links[n];
+        MPI_Irecv(link.recv_buffer.data(),
+            static_cast<int>(link.recv_buffer.size()), MPI_DOUBLE,
+            neighbor.rank, direction_tag(-neighbor.di, -neighbor.dj),
+            MPI_COMM_WORLD, &requests[2 * n]);
+        MPI_Isend(link.send_buffer.data(),
+            static_cast<int>(link.send_buffer.size()), MPI_DOUBLE,
+            neighbor.rank, direction_tag(neighbor.di, neighbor.dj),
+            MPI_COMM_WORLD, &requests[2 * n + 1]);
+    }
+#endif
+}
+
+void HaloExchange::wait()
+{
+#ifdef USE_MPI
+    MPI_Waitall(static_cast<int>(requests.size()), requests.data(),
+        MPI_STATUSES_IGNORE);
+#endif
+}
+
+} // namespace parallel
@@ -0,0 +1,96 @@
+/**
+ * \file halo_exchange.hpp
+ * @brief Non-blocking update of the ghost points of a decomposed grid
+ */
+#ifndef HALO_EXCHANGE_HPP
+#define HALO_EXCHANGE_HPP
+
+#include "../point_def.hpp"
+#include "decomposition.hpp"
+#include <memory>
+#include <vector>
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+namespace parallel {
+
+/**
+ * \class HaloExchange
+ * @brief Copies owned points into the ghost points of the neighbor blocks
+ *
+ * begin() sends the points every neighbor needs and returns at once, so
+ * points that do not reach any ghost point can be computed while the
+ * messages travel; finish() waits for them and writes the ghost points.
+ * Any grid with values(ind) and set_values(p, ind) over the local indices
+ * of the decomposition can be exchanged.
+ */
+class HaloExchange {
+public:
+    explicit HaloExchange(std::shared_ptr<const Decomposition> decomposition);
+
+    template <typename Grid>
+    void begin(const Grid& grid)
+    {
+        for (size_t n = 0; n < links.size(); n++) {
+            auto& buffer = links[n].send_buffer;
+            auto& send = decomposition->neighbors()[n].send;
+            for (size_t k = 0; k < send.size(); k++) {
+                pack(grid.values(send[k]), &buffer[4 * k]);
+            }
+        }
+        post();
+    }
+
+    template <typename Grid>
+    void finish(Grid* grid)
+    {
+        wait();
+        for (size_t n = 0; n < links.size(); n++) {
+            auto& buffer = links[n].recv_buffer;
+            auto& recv = decomposition->neighbors()[n].recv;
+            for (size_t k = 0; k < recv.size(); k++) {
+                grid->set_values(unpack(&buffer[4 * k]), recv[k]);
+            }
+        }
+    }
+
+    template <typename Grid>
+    void exchange(Grid* grid)
+    {
+        begin(*grid);
+        finish(grid);
+    }
+
+    const Decomposition& domain() const { return *decomposition; }
+
+private:
+    struct Link {
+        std::vector<double> send_buffer;
+        std::vector<double> recv_buffer;
+    };
+    std::shared_ptr<const Decomposition> decomposition;
+    std::vector<Link> links;
+#ifdef USE_MPI
+    std::vector<MPI_Request> requests;
+#endif
+
+    void post();
+    void wait();
+
+    static void pack(const Point& p, double* out)
+    {
+        out[0] = p.rho();
+        out[1] = p.ru();
+        out[2] = p.rv();
+        out[3] = p.e();
+    }
+    static Point unpack(const double* in)
+    {
+        return Point(in[0], in[1], in[2], in[3]);
+    }
+};
+
+} // namespace parallel
+
+#endif /* HALO_EXCHANGE_HPP */
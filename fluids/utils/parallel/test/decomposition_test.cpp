@@ -0,0 +1,139 @@
+#include "../../flag_handler.hpp"
+#include "../decomposition.hpp"
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using parallel::Decomposition;
+
+namespace {
+int der_flag(int left, int right) { return left | (right << 4); }
+
+int make_flag(int type, int derx_flag, int dery_flag)
+{
+    using namespace flag_functions::constants;
+    return type | (derx_flag << DERX_MASK_SHIFT)
+        | (dery_flag << DERY_MASK_SHIFT);
+}
+} // namespace
+
+TEST(DecompositionTest, ProcessGridFollowsTheGridShape)
+{
+    EXPECT_EQ(Decomposition::process_grid(32, 32, 4), std::make_pair(2, 2));
+    EXPECT_EQ(Decomposition::process_grid(100, 10, 4), std::make_pair(4, 1));
+    EXPECT_EQ(Decomposition::process_grid(10, 100, 4), std::make_pair(1, 4));
+    EXPECT_EQ(Decomposition::process_grid(50, 50, 1), std::make_pair(1, 1));
+}
+
+TEST(DecompositionTest, SingleProcessOwnsEverything)
+{
+    Decomposition d(12, 9, 1, 0);
+    EXPECT_EQ(d.nPointsI(), 12);
+    EXPECT_EQ(d.nPointsJ(), 9);
+    EXPECT_EQ(d.nPointsOwned(), 12 * 9);
+    EXPECT_TRUE(d.neighbors().empty());
+    EXPECT_TRUE(d.ghost_points().empty());
+    EXPECT_TRUE(d.outer_points().empty());
+    EXPECT_EQ(static_cast<int>(d.inner_points().size()), 12 * 9);
+    for (int ind = 0; ind < d.nPointsTotal(); ind++) {
+        EXPECT_EQ(d.global_ind(ind), ind);
+        EXPECT_EQ(d.local_ind(ind), ind);
+    }
+}
+
+TEST(DecompositionTest, BlocksCoverTheGridOnce)
+{
+    const int nI = 23, nJ = 31, procs = 6;
+    std::vector<int> owners(nI * nJ, 0);
+    for (int r = 0; r < procs; r++) {
+        Decomposition d(nI, nJ, procs, r);
+        int owned = 0;
+        for (int ind = 0; ind < d.nPointsTotal(); ind++) {
+            EXPECT_EQ(d.local_ind(d.global_ind(ind)), ind);
+            if (d.is_owned(ind)) {
+                owners[d.global_ind(ind)]++;
+                owned++;
+            }
+        }
+        EXPECT_EQ(owned, d.nPointsOwned());
+        EXPECT_EQ(d.inner_points().size() + d.outer_points().size(),
+            static_cast<size_t>(owned));
+        EXPECT_EQ(d.ghost_points().size(),
+            static_cast<size_t>(d.nPointsTotal() - owned));
+    }
+    for (auto count : owners) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(DecompositionTest, SendAndReceiveListsMatch)
+{
+    const int nI = 40, nJ = 30, procs = 6;
+    std::vector<Decomposition> blocks;
+    for (int r = 0; r < procs; r++) {
+        blocks.emplace_back(nI, nJ, procs, r);
+    }
+    for (auto& d : blocks) {
+        // Every ghost point is received exactly once
+        std::vector<int> received(d.nPointsTotal(), 0);
+        for (auto& n : d.neighbors()) {
+            auto& other = blocks[n.rank];
+            const Decomposition::Neighbor* back = nullptr;
+            for (auto& m : other.neighbors()) {
+                if (m.rank == d.rank()) {
+                    back = &m;
+                }
+            }
+            ASSERT_NE(back, nullptr);
+            EXPECT_EQ(back->di, -n.di);
+            EXPECT_EQ(back->dj, -n.dj);
+            ASSERT_EQ(n.recv.size(), back->send.size());
+            for (size_t k = 0; k < n.recv.size(); k++) {
+                EXPECT_FALSE(d.is_owned(n.recv[k]));
+                EXPECT_TRUE(other.is_owned(back->send[k]));
+                EXPECT_EQ(d.global_ind(n.recv[k]),
+                    other.global_ind(back->send[k]));
+                received[n.recv[k]]++;
+            }
+        }
+        for (auto ind : d.ghost_points()) {
+            EXPECT_EQ(received[ind], 1);
+        }
+    }
+}
+
+TEST(DecompositionTest, InnerPointsStayAwayFromGhosts)
+{
+    Decomposition d(32, 32, 4, 3);
+    EXPECT_EQ(d.owned_i().begin, 16);
+    EXPECT_EQ(d.owned_j().begin, 16);
+    EXPECT_EQ(d.local_i().begin, 16 - parallel::HALO_WIDTH);
+    EXPECT_EQ(d.local_j().end, 32);
+    for (auto ind : d.inner_points()) {
+        int gi = d.global_ind(ind) / 32;
+        int gj = d.global_ind(ind) % 32;
+        EXPECT_GE(gi, d.owned_i().begin + d.halo());
+        EXPECT_GE(gj, d.owned_j().begin + d.halo());
+    }
+}
+
+TEST(DecompositionTest, FlagsAreLimitedToTheLocalGrid)
+{
+    using namespace flag_functions;
+    Decomposition d(32, 32, 4, 3);
+    int flag = make_flag(FLUID_POINT, der_flag(15, 3), der_flag(2, 15));
+
+    int corner = d.local_flag(flag, 0);
+    EXPECT_EQ(point_type(corner), FLUID_POINT);
+    EXPECT_EQ(left(derx(corner)), 0);
+    EXPECT_EQ(right(derx(corner)), 3);
+    EXPECT_EQ(left(dery(corner)), 0);
+    EXPECT_EQ(right(dery(corner)), 15);
+
+    // Owned points keep every width the stencils can use
+    int owned = d.local_flag(flag, d.local_ind(16 * 32 + 16));
+    EXPECT_GE(left(derx(owned)), parallel::HALO_WIDTH);
+    EXPECT_EQ(right(derx(owned)), 3);
+    EXPECT_EQ(left(dery(owned)), 2);
+    EXPECT_GE(right(dery(owned)), parallel::HALO_WIDTH);
+}
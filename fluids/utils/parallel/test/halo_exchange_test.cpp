@@ -0,0 +1,69 @@
+#include "../communicator.hpp"
+#include "../halo_exchange.hpp"
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+namespace {
+/** Smallest grid interface HaloExchange works with */
+struct LocalValues {
+    std::vector<Point> points;
+    const Point& values(int ind) const { return points[ind]; }
+    void set_values(Point p, int ind) { points[ind] = p; }
+};
+
+Point expected(int global_ind)
+{
+    return Point(global_ind, -global_ind, 0.5 * global_ind, 1.0);
+}
+} // namespace
+
+TEST(HaloExchangeTest, GhostsReceiveTheOwnersValues)
+{
+    auto d = std::make_shared<parallel::Decomposition>(
+        37, 29, parallel::size(), parallel::rank());
+    LocalValues local {std::vector<Point>(d->nPointsTotal())};
+    for (int ind = 0; ind < d->nPointsTotal(); ind++) {
+        local.points[ind] = d->is_owned(ind) ? expected(d->global_ind(ind))
+                                              : Point(-1, -1, -1, -1);
+    }
+    parallel::HaloExchange halo(d);
+    halo.exchange(&local);
+    for (int ind = 0; ind < d->nPointsTotal(); ind++) {
+        auto p = expected(d->global_ind(ind));
+        EXPECT_EQ(local.points[ind].rho(), p.rho());
+        EXPECT_EQ(local.points[ind].ru(), p.ru());
+        EXPECT_EQ(local.points[ind].rv(), p.rv());
+        EXPECT_EQ(local.points[ind].e(), p.e());
+    }
+}
+
+TEST(HaloExchangeTest, Reductions)
+{
+    int n = parallel::size();
+    double r = parallel::rank();
+    EXPECT_EQ(parallel::min(r), 0.0);
+    EXPECT_EQ(parallel::max(r), n - 1.0);
+    EXPECT_EQ(parallel::sum(1.0), static_cast<double>(n));
+    EXPECT_TRUE(parallel::any(parallel::rank() == n - 1));
+    EXPECT_FALSE(parallel::any(false));
+
+    std::vector<int> counts(n);
+    for (int k = 0; k < n; k++) {
+        counts[k] = k + 1;
+    }
+    std::vector<double> mine(parallel::rank() + 1, r), all;
+    parallel::gather(mine, counts, &all);
+    if (parallel::is_root()) {
+        ASSERT_EQ(static_cast<int>(all.size()), n * (n + 1) / 2);
+        EXPECT_EQ(all.back(), n - 1.0);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    parallel::Environment environment;
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
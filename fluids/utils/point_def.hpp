@@ -1,20 +1,33 @@
 #ifndef POINT_DEF_HPP
 #define POINT_DEF_HPP
 
+#include "storage_def.hpp"
 #include <istream>
 #include <ostream>
 
-struct Point {
-    double rho_v;
-    double ru_v;
-    double rv_v;
-    double e_v;
-    Point() {}
-    Point(double v1, double v2, double v3, double v4)
-        : rho_v(v1)
-        , ru_v(v2)
-        , rv_v(v3)
-        , e_v(v4)
+/**
+ * @brief Conservative variables kept in Real, read and written as double
+ *
+ * Point computes in double. Grids keep StoredPoint, in the storage
+ * precision of the build; both convert to each other.
+ */
+template <typename Real>
+struct BasicPoint {
+    Real rho_v;
+    Real ru_v;
+    Real rv_v;
+    Real e_v;
+    BasicPoint() {}
+    BasicPoint(double v1, double v2, double v3, double v4)
+        : rho_v(static_cast<Real>(v1))
+        , ru_v(static_cast<Real>(v2))
+        , rv_v(static_cast<Real>(v3))
+        , e_v(static_cast<Real>(v4))
+    {
+    }
+    template <typename Other>
+    BasicPoint(const BasicPoint<Other>& p)
+        : BasicPoint(p.rho(), p.ru(), p.rv(), p.e())
     {
     }
     inline double rho(void) const { return rho_v; }
@@ -22,20 +35,23 @@ struct Point {
     inline double rv(void) const { return rv_v; }
     inline double e(void) const { return e_v; }
 
-    inline void set_rho(double val) { rho_v = val; }
-    inline void set_ru(double val) { ru_v = val; }
-    inline void set_rv(double val) { rv_v = val; }
-    inline void set_e(double val) { e_v = val; }
-    friend std::istream& operator>>(std::istream& is, Point& p)
+    inline void set_rho(double val) { rho_v = static_cast<Real>(val); }
+    inline void set_ru(double val) { ru_v = static_cast<Real>(val); }
+    inline void set_rv(double val) { rv_v = static_cast<Real>(val); }
+    inline void set_e(double val) { e_v = static_cast<Real>(val); }
+    friend std::istream& operator>>(std::istream& is, BasicPoint& p)
     {
         is >> p.rho_v >> p.ru_v >> p.rv_v >> p.e_v;
         return is;
     }
-    friend std::ostream& operator<<(std::ostream& os, const Point& p)
+    friend std::ostream& operator<<(std::ostream& os, const BasicPoint& p)
     {
         os << p.rho_v << " " << p.ru_v << " " << p.rv_v << " " << p.e_v;
         return os;
     }
 };
 
+typedef BasicPoint<double> Point;
+typedef BasicPoint<storage_real> StoredPoint;
+
 #endif /* POINT_DEF_HPP */
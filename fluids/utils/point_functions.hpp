@@ -1,7 +1,7 @@
 #ifndef POINT_FUNCTIONS_HPP
 #define POINT_FUNCTIONS_HPP
 
-struct Point;
+#include "point_def.hpp"
 
 struct PointFunctions {
     PointFunctions(double mach_in, double gam_in);
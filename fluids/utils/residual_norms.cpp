@@ -0,0 +1,93 @@
+#include "residual_norms.hpp"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+ResidualNorms residual_norms(const memory::GridArray<Flux>& variation)
+{
+    double rho = 0.0, ru = 0.0, rv = 0.0, e = 0.0;
+    double max_rho = 0.0, max_ru = 0.0, max_rv = 0.0, max_e = 0.0;
+    int n = static_cast<int>(variation.size());
+#ifndef DEBUG
+#pragma omp parallel for reduction(+ : rho, ru, rv, e)                         \
+    reduction(max : max_rho, max_ru, max_rv, max_e)
+#endif
+    for (int ind = 0; ind < n; ind++) {
+        auto& f = variation[ind];
+        rho += f.rho * f.rho;
+        ru += f.ru * f.ru;
+        rv += f.rv * f.rv;
+        e += f.e * f.e;
+        max_rho = std::max(max_rho, std::fabs(f.rho));
+        max_ru = std::max(max_ru, std::fabs(f.ru));
+        max_rv = std::max(max_rv, std::fabs(f.rv));
+        max_e = std::max(max_e, std::fabs(f.e));
+    }
+    double scale = (n > 0) ? 1.0 / n : 0.0;
+    return {{{std::sqrt(rho * scale), std::sqrt(ru * scale),
+                std::sqrt(rv * scale), std::sqrt(e * scale)}},
+        {{max_rho, max_ru, max_rv, max_e}}};
+}
+
+SteadyStateMonitor::SteadyStateMonitor(bool enabled_in, double drop_in,
+    int plateau_steps_in, double plateau_tolerance_in)
+    : is_enabled(enabled_in)
+    , drop(drop_in)
+    , plateau_steps(static_cast<size_t>(std::max(0, plateau_steps_in)))
+    , plateau_tolerance(plateau_tolerance_in)
+    , reference({{0.0, 0.0, 0.0, 0.0}})
+    , last_relative(1.0)
+{
+}
+
+bool SteadyStateMonitor::update(const ResidualNorms& norms)
+{
+    if (!is_enabled) {
+        return false;
+    }
+    for (auto& l2 : norms.l2) {
+        if (l2 != l2) {
+            return false;
+        }
+    }
+    bool any_reference = false;
+    last_relative = 0.0;
+    for (size_t c = 0; c < reference.size(); c++) {
+        reference[c] = std::max(reference[c], norms.l2[c]);
+        if (reference[c] > 0.0) {
+            any_reference = true;
+            last_relative
+                = std::max(last_relative, norms.l2[c] / reference[c]);
+        }
+    }
+    if (!any_reference) {
+        // Nothing to measure the drop against yet (e.g. a uniform initial
+        // state whose boundaries have not acted)
+        return false;
+    }
+    if (last_relative <= std::pow(10.0, -drop)) {
+        std::ostringstream ss;
+        ss << "the residual dropped by " << drop << " orders of magnitude";
+        why = ss.str();
+        return true;
+    }
+    if (plateau_steps == 0 || last_relative <= 0.0) {
+        return false;
+    }
+    history.push_back(std::log10(last_relative));
+    if (history.size() > plateau_steps) {
+        history.pop_front();
+    }
+    if (history.size() < plateau_steps) {
+        return false;
+    }
+    auto range = std::minmax_element(history.begin(), history.end());
+    if (*range.second - *range.first < plateau_tolerance) {
+        std::ostringstream ss;
+        ss << "the residual stalled at " << last_relative
+           << " of its maximum for " << plateau_steps << " steps";
+        why = ss.str();
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,61 @@
+#ifndef RESIDUAL_NORMS_HPP
+#define RESIDUAL_NORMS_HPP
+
+#include "flux_def.hpp"
+#include "memory/grid_allocator.hpp"
+#include <array>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Norms of each conservative component (rho, ru, rv, e) of a time
+ * derivative. l2 is the root mean square over the grid points, so it does
+ * not grow with the grid size.
+ */
+struct ResidualNorms {
+    std::array<double, 4> l2;
+    std::array<double, 4> linf;
+};
+
+ResidualNorms residual_norms(const memory::GridArray<Flux>& variation);
+
+/**
+ * \class SteadyStateMonitor
+ * @brief Decides when a run has reached a steady state from its residuals
+ *
+ * Each component is scaled by the largest L2 norm it has reached so far, so
+ * the start-up transient does not count as convergence. The run is converged
+ * once every (non-zero) component dropped by `drop` orders of magnitude, or,
+ * when plateau_steps > 0, once the largest scaled residual varied by less
+ * than plateau_tolerance orders of magnitude over the last plateau_steps
+ * updates.
+ */
+class SteadyStateMonitor {
+public:
+    SteadyStateMonitor(bool enabled, double drop, int plateau_steps,
+        double plateau_tolerance);
+
+    bool enabled() const { return is_enabled; }
+    /**
+     * @brief Adds the residual of a new step and returns true if converged
+     */
+    bool update(const ResidualNorms& norms);
+    /**
+     * @brief Largest residual component relative to its reference
+     */
+    double relative_residual() const { return last_relative; }
+    const std::string& reason() const { return why; }
+
+private:
+    const bool is_enabled;
+    const double drop;
+    const size_t plateau_steps;
+    const double plateau_tolerance;
+    std::array<double, 4> reference;
+    std::deque<double> history;
+    double last_relative;
+    std::string why;
+};
+
+#endif /* RESIDUAL_NORMS_HPP */
@@ -20,6 +20,10 @@ public:
     {
         return shocked_points;
     }
+    void set_shocked_points(const std::set<int>& points)
+    {
+        shocked_points = points;
+    }
 
 private:
     const double sensitivity;
@@ -8,6 +8,7 @@ public:
     LuisaDetector() {}
     virtual void detect_shocks(const CartesianGrid& grid) = 0;
     virtual const std::set<int>& set_of_shocked_points() const = 0;
+    virtual void set_shocked_points(const std::set<int>& points) = 0;
 };
 
 #endif /* LUISA_SHOCK_DETECTOR_HPP */
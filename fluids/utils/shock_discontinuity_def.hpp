@@ -31,6 +31,23 @@ public:
     double sigma;
     bool is_connected;
 
+    void save_state(std::ostream& os) const
+    {
+        GenericDiscontinuity::save_state(os);
+        binary_io::write(os, low_pressure_side);
+        binary_io::write(os, w);
+        binary_io::write(os, sigma);
+        binary_io::write(os, is_connected);
+    }
+    void load_state(std::istream& is)
+    {
+        GenericDiscontinuity::load_state(is);
+        binary_io::read(is, low_pressure_side);
+        binary_io::read(is, w);
+        binary_io::read(is, sigma);
+        binary_io::read(is, is_connected);
+    }
+
     bool is_strong() { return sigma >= 1.05; }
     bool is_weak() { return !(is_strong()); }
     friend std::ostream& operator<<(std::ostream& os, ShockDiscontinuity& sd)
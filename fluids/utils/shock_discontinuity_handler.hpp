@@ -1,10 +1,10 @@
 #ifndef SHOCK_DISCONTINUITY_HANDLER_HPP
 #define SHOCK_DISCONTINUITY_HANDLER_HPP
 
+#include "point_def.hpp"
 #include "shock_discontinuity_def.hpp"
 #include <utility>
 
-struct Point;
 class Options;
 
 class ShockHandler {
@@ -0,0 +1,28 @@
+/**
+ * \file solver_context.hpp
+ * @brief State shared by the components of one solver run
+ */
+#ifndef SOLVER_CONTEXT_HPP
+#define SOLVER_CONTEXT_HPP
+
+/**
+ * \struct SolverContext
+ * @brief What the components of one run exchange while it advances
+ *
+ * Every run owns its context and hands it to the components that need it,
+ * so several solvers can run in the same process.
+ */
+struct SolverContext {
+    /**
+     * @name Largest wave speeds of the current state
+     * Computed by the integrators with the time step, read by the
+     * Lax-Friedrichs flux and the subsonic outlets. The Mach number is
+     * capped at 1
+     * @{ */
+    double max_mach_number = 0;
+    double max_u_plus_c = 0;
+    double max_v_plus_c = 0;
+    /**  @} */
+};
+
+#endif /* SOLVER_CONTEXT_HPP */
@@ -0,0 +1,37 @@
+/**
+ * \file span.hpp
+ * @brief View of contiguous values owned by someone else
+ */
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cstddef>
+
+/**
+ * \class Span
+ * @brief Pointer and size of an array, in the spirit of C++20 std::span
+ *
+ * Copies nothing: writes through a Span<T> change the owner's values. The
+ * view is valid as long as the owner does not reallocate.
+ */
+template <typename T>
+class Span {
+public:
+    Span(T* data_in, size_t size_in)
+        : data_c(data_in)
+        , size_c(size_in)
+    {
+    }
+    T* data() const { return data_c; }
+    size_t size() const { return size_c; }
+    bool empty() const { return size_c == 0; }
+    T& operator[](size_t i) const { return data_c[i]; }
+    T* begin() const { return data_c; }
+    T* end() const { return data_c + size_c; }
+
+private:
+    T* data_c;
+    size_t size_c;
+};
+
+#endif /* SPAN_HPP */
@@ -0,0 +1,28 @@
+/**
+ * \file storage_def.hpp
+ * @brief Precision the grid state and the cached fluxes are stored in
+ */
+#ifndef STORAGE_DEF_HPP
+#define STORAGE_DEF_HPP
+
+/**
+ * Built with SINGLE_PRECISION_STORAGE, grid points and cached fluxes keep
+ * their values in float, which halves the memory traffic of the bandwidth
+ * bound kernels. Values are read back as double, so the stencils still
+ * accumulate in double precision.
+ */
+#ifdef SINGLE_PRECISION_STORAGE
+typedef float storage_real;
+#else
+typedef double storage_real;
+#endif
+
+/**
+ * @brief The value a single precision store of v would read back
+ */
+inline double round_to_single(double v)
+{
+    return static_cast<double>(static_cast<float>(v));
+}
+
+#endif /* STORAGE_DEF_HPP */
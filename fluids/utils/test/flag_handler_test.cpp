@@ -17,3 +17,16 @@ TEST(FlagHandlerTest, Basic)
     EXPECT_EQ(left(dery(sample_flag)), v3);
     EXPECT_EQ(right(dery(sample_flag)), v4);
 }
+
+TEST(FlagHandlerTest, DecodesAtCompileTime)
+{
+    using namespace flag_functions;
+    constexpr int flag = BOUNDARY_POINT
+        + (((2 << 4) + 1) << constants::DERX_MASK_SHIFT)
+        + (((4 << 4) + 3) << constants::DERY_MASK_SHIFT);
+
+    static_assert(point_type(flag) == BOUNDARY_POINT, "point type");
+    static_assert(left(derx(flag)) == 1 and right(derx(flag)) == 2, "derx");
+    static_assert(left(dery(flag)) == 3 and right(dery(flag)) == 4, "dery");
+    EXPECT_EQ(point_type(flag), BOUNDARY_POINT);
+}
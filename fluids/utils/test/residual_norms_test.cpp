@@ -0,0 +1,59 @@
+#include "../residual_norms.hpp"
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+ResidualNorms norms_of(double l2)
+{
+    return {{{l2, 2 * l2, l2, 0.0}}, {{l2, l2, l2, 0.0}}};
+}
+}
+
+TEST(ResidualNormsTest, testNormsPerComponent)
+{
+    memory::GridArray<Flux> variation
+        = {{3.0, 0.0, 1.0, -2.0}, {-4.0, 0.0, 1.0, 2.0}};
+    auto norms = residual_norms(variation);
+    EXPECT_DOUBLE_EQ(norms.l2[0], std::sqrt(12.5));
+    EXPECT_DOUBLE_EQ(norms.l2[1], 0.0);
+    EXPECT_DOUBLE_EQ(norms.l2[2], 1.0);
+    EXPECT_DOUBLE_EQ(norms.l2[3], 2.0);
+    EXPECT_DOUBLE_EQ(norms.linf[0], 4.0);
+    EXPECT_DOUBLE_EQ(norms.linf[1], 0.0);
+    EXPECT_DOUBLE_EQ(norms.linf[2], 1.0);
+    EXPECT_DOUBLE_EQ(norms.linf[3], 2.0);
+}
+
+TEST(ResidualNormsTest, testConvergesAfterResidualDrop)
+{
+    SteadyStateMonitor monitor(true, 3, 0, 0.01);
+    EXPECT_FALSE(monitor.update(norms_of(0.0)));
+    // The reference is the largest residual, not the first one
+    EXPECT_FALSE(monitor.update(norms_of(1.0)));
+    EXPECT_FALSE(monitor.update(norms_of(10.0)));
+    EXPECT_FALSE(monitor.update(norms_of(1e-1)));
+    EXPECT_FALSE(monitor.update(norms_of(2e-2)));
+    EXPECT_DOUBLE_EQ(monitor.relative_residual(), 2e-3);
+    EXPECT_TRUE(monitor.update(norms_of(5e-3)));
+    EXPECT_FALSE(monitor.reason().empty());
+
+    SteadyStateMonitor disabled(false, 3, 0, 0.01);
+    EXPECT_FALSE(disabled.update(norms_of(0.0)));
+}
+
+TEST(ResidualNormsTest, testConvergesOnPlateau)
+{
+    SteadyStateMonitor monitor(true, 12, 4, 0.01);
+    EXPECT_FALSE(monitor.update(norms_of(1.0)));
+    EXPECT_FALSE(monitor.update(norms_of(1e-4)));
+    EXPECT_FALSE(monitor.update(norms_of(1.001e-4)));
+    EXPECT_FALSE(monitor.update(norms_of(1.002e-4)));
+    EXPECT_TRUE(monitor.update(norms_of(1.001e-4)));
+
+    SteadyStateMonitor no_plateau(true, 12, 0, 0.01);
+    for (int step = 0; step < 10; step++) {
+        EXPECT_FALSE(no_plateau.update(norms_of(1.0)));
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * \file perf_counters.cpp
+ * @brief Implementation of the PerfCounters class
+ */
+#include "perf_counters.hpp"
+
+#ifdef WITH_PERF_COUNTERS
+#include <asm/unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+const char* event_names[N_PERF_EVENTS]
+    = {"cycles", "instructions", "llc_misses", "branch_misses"};
+
+#ifdef WITH_PERF_COUNTERS
+const uint64_t event_configs[N_PERF_EVENTS]
+    = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+int open_event(uint64_t config, int group_fd)
+{
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = (group_fd == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED
+        | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(
+        syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+#endif
+} // namespace
+
+const char* perf_event_name(PerfEvent event)
+{
+    return event_names[static_cast<int>(event)];
+}
+
+bool PerfCounters::compiled_in()
+{
+#ifdef WITH_PERF_COUNTERS
+    return true;
+#else
+    return false;
+#endif
+}
+
+#ifdef WITH_PERF_COUNTERS
+PerfCounters::PerfCounters()
+    : leader(-1)
+    , n_open(0)
+{
+    fds.fill(-1);
+    slot.fill(-1);
+    for (int e = 0; e < N_PERF_EVENTS; e++) {
+        int fd = open_event(event_configs[e], leader);
+        if (fd < 0) {
+            if (e == 0) {
+                error_c = std::string("perf_event_open failed: ")
+                    + std::strerror(errno);
+                return;
+            }
+            continue;
+        }
+        if (e == 0) {
+            leader = fd;
+        }
+        fds[e] = fd;
+        slot[e] = n_open++;
+    }
+    ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+}
+
+PerfCounters::~PerfCounters()
+{
+    for (auto fd : fds) {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+}
+
+bool PerfCounters::read(PerfSample* sample) const
+{
+    if (leader < 0) {
+        return false;
+    }
+    // nr, time_enabled, time_running, then one value per open event
+    std::array<uint64_t, 3 + N_PERF_EVENTS> buffer{};
+    auto size = sizeof(uint64_t) * (3 + n_open);
+    if (::read(leader, buffer.data(), size) != static_cast<ssize_t>(size)) {
+        return false;
+    }
+    double scale = (buffer[2] > 0)
+        ? static_cast<double>(buffer[1]) / static_cast<double>(buffer[2])
+        : 1.0;
+    for (int e = 0; e < N_PERF_EVENTS; e++) {
+        (*sample)[e] = (slot[e] < 0)
+            ? 0
+            : static_cast<uint64_t>(buffer[3 + slot[e]] * scale);
+    }
+    return true;
+}
+#else
+PerfCounters::PerfCounters()
+    : leader(-1)
+    , n_open(0)
+    , error_c("built without PERF_COUNTERS")
+{
+    fds.fill(-1);
+    slot.fill(-1);
+}
+
+PerfCounters::~PerfCounters() {}
+
+bool PerfCounters::read(PerfSample*) const { return false; }
+#endif
+
+bool PerfCounters::has(PerfEvent event) const
+{
+    return slot[static_cast<int>(event)] >= 0;
+}
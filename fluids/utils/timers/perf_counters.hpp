@@ -0,0 +1,65 @@
+/**
+ * \file perf_counters.hpp
+ * @brief Hardware performance counters of the calling thread
+ */
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+enum class PerfEvent {
+    Cycles,
+    Instructions,
+    LlcMisses,
+    BranchMisses,
+    NumEvents
+};
+
+const int N_PERF_EVENTS = static_cast<int>(PerfEvent::NumEvents);
+
+typedef std::array<uint64_t, N_PERF_EVENTS> PerfSample;
+
+const char* perf_event_name(PerfEvent event);
+
+/**
+ * \class PerfCounters
+ * @brief Counts cycles, instructions, last level cache misses and branch
+ * misses of the thread that creates the object (user space only)
+ *
+ * The counters are opened with perf_event_open as one group, so they are
+ * scheduled together; values are scaled when the kernel multiplexes them.
+ * Only available on Linux when built with PERF_COUNTERS=ON. If the leader
+ * (cycles) cannot be opened, for example in containers or with a restrictive
+ * perf_event_paranoid, available() is false and error() says why. Events the
+ * processor lacks are left out and reported as missing.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    static bool compiled_in();
+
+    bool available() const { return leader >= 0; }
+    bool has(PerfEvent event) const;
+    const std::string& error() const { return error_c; }
+
+    /**
+     * @brief Current counts since the counters were opened
+     * @return False if the counters could not be read
+     */
+    bool read(PerfSample* sample) const;
+
+private:
+    int leader;
+    std::array<int, N_PERF_EVENTS> fds;
+    std::array<int, N_PERF_EVENTS> slot; ///< Position in the group read
+    int n_open;
+    std::string error_c;
+};
+
+#endif /* PERF_COUNTERS_HPP */
@@ -0,0 +1,421 @@
+/**
+ * \file phase_timers.cpp
+ * @brief Implementation of the PhaseTimers class
+ */
+#include "phase_timers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+namespace {
+struct PhaseInfo {
+    const char* name;
+    TimerPhase parent;
+};
+
+const PhaseInfo phase_table[N_TIMER_PHASES] = {
+    {"get_dt", TimerPhase::NumPhases},
+    {"pre_update", TimerPhase::NumPhases},
+    {"filter", TimerPhase::NumPhases},
+    {"time_derivative", TimerPhase::NumPhases},
+    {"regular_points", TimerPhase::TimeDerivative},
+    {"convection", TimerPhase::RegularPoints},
+    {"dissipation", TimerPhase::RegularPoints},
+    {"irregular_points", TimerPhase::TimeDerivative},
+    {"boundary_points", TimerPhase::TimeDerivative},
+    {"residual_smoothing", TimerPhase::NumPhases},
+    {"stage_update", TimerPhase::NumPhases},
+    {"update_values", TimerPhase::NumPhases},
+    {"fix_boundary", TimerPhase::UpdateValues},
+    {"grid_update", TimerPhase::UpdateValues},
+    {"pos_update", TimerPhase::NumPhases},
+    {"output", TimerPhase::NumPhases},
+    {"checkpoint", TimerPhase::NumPhases},
+};
+} // namespace
+
+namespace {
+/**
+ * @brief Two spaces per level, nested phases under their parent
+ */
+std::string phase_indent(TimerPhase phase)
+{
+    std::string indent = "  ";
+    for (auto p = phase_parent(phase); p != TimerPhase::NumPhases;
+         p = phase_parent(p)) {
+        indent += "  ";
+    }
+    return indent;
+}
+} // namespace
+
+thread_local PhaseTimers::ThreadTotals* PhaseTimers::local = nullptr;
+
+const char* phase_name(TimerPhase phase)
+{
+    return phase_table[static_cast<int>(phase)].name;
+}
+
+TimerPhase phase_parent(TimerPhase phase)
+{
+    return phase_table[static_cast<int>(phase)].parent;
+}
+
+void PhaseTimers::ThreadTotals::clear()
+{
+    total.fill(0.0);
+    calls.fill(0);
+    in_step.fill(0.0);
+    for (auto& phase_events : events) {
+        phase_events.fill(0);
+    }
+}
+
+PhaseTimers& PhaseTimers::instance()
+{
+    static PhaseTimers timers;
+    return timers;
+}
+
+PhaseTimers::PhaseTimers()
+    : enabled_c(true)
+{
+    reset();
+}
+
+PhaseTimers::ThreadTotals& PhaseTimers::local_totals()
+{
+    if (local == nullptr) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        threads.push_back(std::make_unique<ThreadTotals>());
+        threads.back()->clear();
+        local = threads.back().get();
+    }
+    return *local;
+}
+
+void PhaseTimers::add(TimerPhase phase, double seconds)
+{
+    auto& totals = local_totals();
+    int p = static_cast<int>(phase);
+    totals.total[p] += seconds;
+    totals.calls[p]++;
+    totals.in_step[p] += seconds;
+}
+
+void PhaseTimers::add(
+    TimerPhase phase, double seconds, const PerfSample& counts)
+{
+    add(phase, seconds);
+    auto& phase_events = local_totals().events[static_cast<int>(phase)];
+    for (int e = 0; e < N_PERF_EVENTS; e++) {
+        phase_events[e] += counts[e];
+    }
+}
+
+bool PhaseTimers::read_counters(PerfSample* sample)
+{
+    if (!enabled_c or !PerfCounters::compiled_in()) {
+        return false;
+    }
+    auto& totals = local_totals();
+    if (!totals.counters_tried) {
+        totals.counters_tried = true;
+        totals.counters = std::make_unique<PerfCounters>();
+        if (!totals.counters->available()) {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            counters_error_c = totals.counters->error();
+        }
+    }
+    return totals.counters->read(sample);
+}
+
+void PhaseTimers::begin_step()
+{
+    if (!enabled_c) {
+        return;
+    }
+    step_start = std::chrono::steady_clock::now();
+}
+
+void PhaseTimers::end_step(long n_points)
+{
+    if (!enabled_c) {
+        return;
+    }
+    std::chrono::duration<double> elapsed
+        = std::chrono::steady_clock::now() - step_start;
+    step_seconds += elapsed.count();
+    step_buckets[bucket_of(elapsed.count())]++;
+    n_steps++;
+    n_points_updated += n_points;
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (int p = 0; p < N_TIMER_PHASES; p++) {
+        double in_step = 0.0;
+        for (auto& thread : threads) {
+            in_step += thread->in_step[p];
+            thread->in_step[p] = 0.0;
+        }
+        if (in_step > 0.0) {
+            buckets[p][bucket_of(in_step)]++;
+        }
+    }
+}
+
+void PhaseTimers::reset()
+{
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (auto& thread : threads) {
+        thread->clear();
+    }
+    for (auto& phase_buckets : buckets) {
+        phase_buckets.fill(0);
+    }
+    step_buckets.fill(0);
+    step_seconds = 0.0;
+    n_steps = 0;
+    n_points_updated = 0;
+}
+
+double PhaseTimers::total(TimerPhase phase) const
+{
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    double sum = 0.0;
+    for (auto& thread : threads) {
+        sum += thread->total[static_cast<int>(phase)];
+    }
+    return sum;
+}
+
+long PhaseTimers::calls(TimerPhase phase) const
+{
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    long sum = 0;
+    for (auto& thread : threads) {
+        sum += thread->calls[static_cast<int>(phase)];
+    }
+    return sum;
+}
+
+std::array<long, PhaseTimers::N_BUCKETS> PhaseTimers::histogram(
+    TimerPhase phase) const
+{
+    return buckets[static_cast<int>(phase)];
+}
+
+PerfSample PhaseTimers::counts(TimerPhase phase) const
+{
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    PerfSample sum{};
+    for (auto& thread : threads) {
+        for (int e = 0; e < N_PERF_EVENTS; e++) {
+            sum[e] += thread->events[static_cast<int>(phase)][e];
+        }
+    }
+    return sum;
+}
+
+std::string PhaseTimers::counters_error() const
+{
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    return counters_error_c;
+}
+
+bool PhaseTimers::has_counts() const
+{
+    for (int p = 0; p < N_TIMER_PHASES; p++) {
+        if (counts(static_cast<TimerPhase>(p))[0] > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+double PhaseTimers::points_per_second() const
+{
+    return (step_seconds > 0.0) ? n_points_updated / step_seconds : 0.0;
+}
+
+double PhaseTimers::bucket_floor(int b)
+{
+    return (b == 0) ? 0.0 : 1e-6 * std::pow(2.0, b - 1);
+}
+
+int PhaseTimers::bucket_of(double seconds)
+{
+    int b = 0;
+    double floor = 1e-6;
+    while (b < N_BUCKETS - 1 and seconds >= floor) {
+        floor *= 2;
+        b++;
+    }
+    return b;
+}
+
+namespace {
+std::string format_seconds(double seconds)
+{
+    std::ostringstream os;
+    if (seconds < 1e-3) {
+        os << std::fixed << std::setprecision(0) << seconds * 1e6 << "us";
+    }
+    else if (seconds < 1.0) {
+        os << std::fixed << std::setprecision(1) << seconds * 1e3 << "ms";
+    }
+    else {
+        os << std::fixed << std::setprecision(2) << seconds << "s";
+    }
+    return os.str();
+}
+
+void print_histogram(std::ostream& os, const std::string& indent,
+    const std::array<long, PhaseTimers::N_BUCKETS>& hist)
+{
+    for (int b = 0; b < PhaseTimers::N_BUCKETS; b++) {
+        if (hist[b] == 0) {
+            continue;
+        }
+        os << indent << "  >= " << std::setw(8)
+           << format_seconds(PhaseTimers::bucket_floor(b)) << ": " << hist[b]
+           << std::endl;
+    }
+}
+
+void json_histogram(
+    std::ostream& os, const std::array<long, PhaseTimers::N_BUCKETS>& hist)
+{
+    os << "[";
+    bool first = true;
+    for (int b = 0; b < PhaseTimers::N_BUCKETS; b++) {
+        if (hist[b] == 0) {
+            continue;
+        }
+        os << (first ? "" : ", ") << "{\"min_seconds\": "
+           << PhaseTimers::bucket_floor(b) << ", \"steps\": " << hist[b]
+           << "}";
+        first = false;
+    }
+    os << "]";
+}
+} // namespace
+
+void PhaseTimers::print_summary(std::ostream& os) const
+{
+    os << std::endl << "Timing summary: " << n_steps << " steps in "
+       << format_seconds(step_seconds) << ", " << std::scientific
+       << std::setprecision(3) << points_per_second() << " points/s"
+       << std::endl;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        os << "  threads reporting: " << threads.size() << std::endl;
+    }
+    for (int p = 0; p < N_TIMER_PHASES; p++) {
+        auto phase = static_cast<TimerPhase>(p);
+        long n_calls = calls(phase);
+        if (n_calls == 0) {
+            continue;
+        }
+        double seconds = total(phase);
+        std::string indent = phase_indent(phase);
+        os << indent << std::left << std::setw(20) << phase_name(phase)
+           << std::right << std::setw(10) << format_seconds(seconds)
+           << std::fixed << std::setprecision(1) << std::setw(7)
+           << (step_seconds > 0 ? 100 * seconds / step_seconds : 0.0) << "%"
+           << std::setw(10) << n_calls << " calls" << std::endl;
+        print_histogram(os, indent, buckets[p]);
+    }
+    os << "  step" << std::endl;
+    print_histogram(os, "  ", step_buckets);
+    print_counters(os);
+    os.unsetf(std::ios::floatfield);
+}
+
+void PhaseTimers::print_counters(std::ostream& os) const
+{
+    if (!PerfCounters::compiled_in()) {
+        return;
+    }
+    auto error = counters_error();
+    if (!has_counts()) {
+        os << "Hardware counters unavailable"
+           << (error.empty() ? std::string() : ": " + error) << std::endl;
+        return;
+    }
+    os << "Hardware counters (thread running each phase):" << std::endl
+       << "  " << std::left << std::setw(20) << "phase" << std::right
+       << std::setw(14) << "cycles" << std::setw(14) << "instructions"
+       << std::setw(7) << "IPC" << std::setw(12) << "LLC mpki"
+       << std::setw(12) << "branch mpki" << std::endl;
+    for (int p = 0; p < N_TIMER_PHASES; p++) {
+        auto phase = static_cast<TimerPhase>(p);
+        auto c = counts(phase);
+        if (c[0] == 0) {
+            continue;
+        }
+        // Misses per thousand instructions
+        double kilo_instructions = std::max<double>(1, c[1]) / 1000.0;
+        std::string indent = phase_indent(phase);
+        os << indent << std::left << std::setw(22 - indent.size())
+           << phase_name(phase) << std::right << std::setw(14) << c[0]
+           << std::setw(14) << c[1] << std::fixed << std::setprecision(2)
+           << std::setw(7) << static_cast<double>(c[1]) / c[0]
+           << std::setw(12) << c[2] / kilo_instructions << std::setw(12)
+           << c[3] / kilo_instructions << std::endl;
+    }
+    if (!error.empty()) {
+        os << "  (some threads had no counters: " << error << ")" << std::endl;
+    }
+}
+
+void PhaseTimers::write_json(std::ostream& os) const
+{
+    os << "{" << std::endl
+       << "  \"steps\": " << n_steps << "," << std::endl
+       << "  \"run_seconds\": " << step_seconds << "," << std::endl
+       << "  \"points_per_second\": " << points_per_second() << ","
+       << std::endl
+       << "  \"step_histogram\": ";
+    json_histogram(os, step_buckets);
+    bool counting = has_counts();
+    if (PerfCounters::compiled_in() and !counting) {
+        os << "," << std::endl
+           << "  \"counters_error\": \"" << counters_error() << "\"";
+    }
+    os << "," << std::endl << "  \"phases\": [" << std::endl;
+    bool first = true;
+    for (int p = 0; p < N_TIMER_PHASES; p++) {
+        auto phase = static_cast<TimerPhase>(p);
+        auto parent = phase_parent(phase);
+        os << (first ? "" : ",\n") << "    {\"name\": \"" << phase_name(phase)
+           << "\", \"parent\": "
+           << (parent == TimerPhase::NumPhases
+                      ? std::string("null")
+                      : "\"" + std::string(phase_name(parent)) + "\"")
+           << ", \"seconds\": " << total(phase)
+           << ", \"calls\": " << calls(phase) << ", \"per_thread_seconds\": [";
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            for (size_t t = 0; t < threads.size(); t++) {
+                os << (t == 0 ? "" : ", ") << threads[t]->total[p];
+            }
+        }
+        os << "], \"histogram\": ";
+        json_histogram(os, buckets[p]);
+        if (counting) {
+            auto c = counts(phase);
+            os << ", \"counters\": {";
+            for (int e = 0; e < N_PERF_EVENTS; e++) {
+                os << (e == 0 ? "" : ", ") << "\""
+                   << perf_event_name(static_cast<PerfEvent>(e))
+                   << "\": " << c[e];
+            }
+            os << "}";
+        }
+        os << "}";
+        first = false;
+    }
+    os << std::endl << "  ]" << std::endl << "}" << std::endl;
+}
@@ -0,0 +1,197 @@
+/**
+ * \file phase_timers.hpp
+ * @brief Low-overhead timers for the phases of a time step
+ */
+#ifndef PHASE_TIMERS_HPP
+#define PHASE_TIMERS_HPP
+
+#include "perf_counters.hpp"
+#include <array>
+#include <chrono>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Timed phases. Phases listed with a parent in phase_parent() run
+ * inside that phase and are also counted in it.
+ */
+enum class TimerPhase {
+    GetDt,
+    PreUpdate,
+    Filter,
+    TimeDerivative,
+    RegularPoints,
+    Convection,
+    Dissipation,
+    IrregularPoints,
+    BoundaryPoints,
+    ResidualSmoothing,
+    StageUpdate,
+    UpdateValues,
+    FixBoundary,
+    GridUpdate,
+    PosUpdate,
+    Output,
+    Checkpoint,
+    NumPhases
+};
+
+const int N_TIMER_PHASES = static_cast<int>(TimerPhase::NumPhases);
+
+const char* phase_name(TimerPhase phase);
+
+/**
+ * @return Phase that contains phase, or NumPhases for top level phases
+ */
+TimerPhase phase_parent(TimerPhase phase);
+
+/**
+ * \class PhaseTimers
+ * @brief Accumulates the time spent in each phase
+ *
+ * Every thread adds to its own totals, so timers can be used inside parallel
+ * regions without synchronization; totals are merged when reported. The
+ * integrators mark the steps with begin_step/end_step, which turns the time
+ * spent on each phase during the step into an entry of a per-phase histogram
+ * of step times (logarithmic buckets, 1 us to ~16 s).
+ *
+ * When built with PERF_COUNTERS=ON, every timed phase also accumulates the
+ * hardware counters (see PerfCounters) of the thread that runs it. Counters
+ * are opened per thread on first use; if they are unavailable, phases are
+ * only timed and the summary says why.
+ */
+class PhaseTimers {
+public:
+    static const int N_BUCKETS = 25;
+
+    static PhaseTimers& instance();
+
+    void set_enabled(bool enabled_in) { enabled_c = enabled_in; }
+    bool enabled() const { return enabled_c; }
+
+    void add(TimerPhase phase, double seconds);
+    void add(TimerPhase phase, double seconds, const PerfSample& counts);
+
+    /**
+     * @brief Reads the hardware counters of the calling thread
+     * @return False if timers are disabled or counters are unavailable
+     */
+    bool read_counters(PerfSample* sample);
+    void begin_step();
+    /**
+     * @param n_points Grid points updated during the step
+     */
+    void end_step(long n_points);
+    void reset();
+
+    long steps() const { return n_steps; }
+    double run_time() const { return step_seconds; }
+    double total(TimerPhase phase) const;
+    long calls(TimerPhase phase) const;
+    std::array<long, N_BUCKETS> histogram(TimerPhase phase) const;
+    PerfSample counts(TimerPhase phase) const;
+    /**
+     * @brief Why counters could not be opened; empty if they were
+     */
+    std::string counters_error() const;
+    std::array<long, N_BUCKETS> step_histogram() const
+    {
+        return step_buckets;
+    }
+    double points_per_second() const;
+
+    /**
+     * @brief Prints per-phase totals, per-step histograms and throughput
+     */
+    void print_summary(std::ostream& os) const;
+    void write_json(std::ostream& os) const;
+
+    /**
+     * @brief Lower limit of histogram bucket b, in seconds
+     */
+    static double bucket_floor(int b);
+
+private:
+    struct ThreadTotals {
+        std::array<double, N_TIMER_PHASES> total;
+        std::array<long, N_TIMER_PHASES> calls;
+        std::array<double, N_TIMER_PHASES> in_step;
+        std::array<PerfSample, N_TIMER_PHASES> events;
+        std::unique_ptr<PerfCounters> counters;
+        bool counters_tried = false;
+        void clear();
+    };
+
+    PhaseTimers();
+    ThreadTotals& local_totals();
+
+    static thread_local ThreadTotals* local;
+
+    bool enabled_c;
+    mutable std::mutex registry_mutex;
+    std::vector<std::unique_ptr<ThreadTotals>> threads;
+    std::array<std::array<long, N_BUCKETS>, N_TIMER_PHASES> buckets;
+    std::array<long, N_BUCKETS> step_buckets;
+    std::chrono::steady_clock::time_point step_start;
+    double step_seconds;
+    long n_steps;
+    long n_points_updated;
+    std::string counters_error_c;
+
+    bool has_counts() const;
+    void print_counters(std::ostream& os) const;
+    static int bucket_of(double seconds);
+};
+
+/**
+ * \class ScopedPhaseTimer
+ * @brief Adds the lifetime of the object to a phase
+ */
+class ScopedPhaseTimer {
+public:
+    explicit ScopedPhaseTimer(TimerPhase phase_in)
+        : phase(phase_in)
+        , active(PhaseTimers::instance().enabled())
+        , counting(false)
+    {
+        if (active) {
+            counting = PhaseTimers::instance().read_counters(&start_counts);
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedPhaseTimer()
+    {
+        if (!active) {
+            return;
+        }
+        std::chrono::duration<double> elapsed
+            = std::chrono::steady_clock::now() - start;
+        auto& timers = PhaseTimers::instance();
+        PerfSample end_counts;
+        if (counting and timers.read_counters(&end_counts)) {
+            for (int e = 0; e < N_PERF_EVENTS; e++) {
+                end_counts[e] -= start_counts[e];
+            }
+            timers.add(phase, elapsed.count(), end_counts);
+        }
+        else {
+            timers.add(phase, elapsed.count());
+        }
+    }
+
+    ScopedPhaseTimer(const ScopedPhaseTimer&) = delete;
+    ScopedPhaseTimer& operator=(const ScopedPhaseTimer&) = delete;
+
+private:
+    TimerPhase phase;
+    bool active;
+    bool counting;
+    std::chrono::steady_clock::time_point start;
+    PerfSample start_counts;
+};
+
+#endif /* PHASE_TIMERS_HPP */
@@ -0,0 +1,102 @@
+#include "../phase_timers.hpp"
+#include "gtest/gtest.h"
+
+#include <sstream>
+#include <thread>
+
+TEST(PhaseTimersTest, testPhasesAreAccumulated)
+{
+    auto& timers = PhaseTimers::instance();
+    timers.reset();
+    for (int step = 0; step < 3; step++) {
+        timers.begin_step();
+        timers.add(TimerPhase::GetDt, 1e-3);
+        timers.add(TimerPhase::TimeDerivative, 2e-3);
+        timers.add(TimerPhase::TimeDerivative, 2e-3);
+        timers.end_step(100);
+    }
+    EXPECT_DOUBLE_EQ(timers.total(TimerPhase::GetDt), 3e-3);
+    EXPECT_DOUBLE_EQ(timers.total(TimerPhase::TimeDerivative), 12e-3);
+    EXPECT_EQ(timers.calls(TimerPhase::TimeDerivative), 6);
+    EXPECT_EQ(timers.calls(TimerPhase::Filter), 0);
+    EXPECT_EQ(timers.steps(), 3);
+
+    // 4 ms per step falls in the [2.048 ms, 4.096 ms) bucket
+    auto hist = timers.histogram(TimerPhase::TimeDerivative);
+    long n_entries = 0;
+    for (int b = 0; b < PhaseTimers::N_BUCKETS; b++) {
+        n_entries += hist[b];
+        if (hist[b] > 0) {
+            EXPECT_LE(PhaseTimers::bucket_floor(b), 4e-3);
+            EXPECT_GT(PhaseTimers::bucket_floor(b + 1), 4e-3);
+        }
+    }
+    EXPECT_EQ(n_entries, 3);
+    EXPECT_GT(timers.points_per_second(), 0.0);
+}
+
+TEST(PhaseTimersTest, testThreadsAreMerged)
+{
+    auto& timers = PhaseTimers::instance();
+    timers.reset();
+    timers.begin_step();
+    std::thread worker([&timers]() {
+        for (int n = 0; n < 10; n++) {
+            timers.add(TimerPhase::RegularPoints, 1e-4);
+        }
+    });
+    for (int n = 0; n < 10; n++) {
+        timers.add(TimerPhase::RegularPoints, 1e-4);
+    }
+    worker.join();
+    timers.end_step(10);
+    EXPECT_NEAR(timers.total(TimerPhase::RegularPoints), 2e-3, 1e-12);
+    EXPECT_EQ(timers.calls(TimerPhase::RegularPoints), 20);
+}
+
+TEST(PhaseTimersTest, testScopedTimerAndReports)
+{
+    auto& timers = PhaseTimers::instance();
+    timers.reset();
+    timers.set_enabled(false);
+    {
+        ScopedPhaseTimer timer(TimerPhase::Output);
+    }
+    EXPECT_EQ(timers.calls(TimerPhase::Output), 0);
+
+    timers.set_enabled(true);
+    timers.begin_step();
+    {
+        ScopedPhaseTimer timer(TimerPhase::Output);
+    }
+    timers.end_step(1);
+    EXPECT_EQ(timers.calls(TimerPhase::Output), 1);
+    EXPECT_GE(timers.total(TimerPhase::Output), 0.0);
+
+    std::ostringstream summary, json;
+    timers.print_summary(summary);
+    timers.write_json(json);
+    EXPECT_NE(summary.str().find("output"), std::string::npos);
+    EXPECT_NE(json.str().find("\"name\": \"fix_boundary\", "
+                              "\"parent\": \"update_values\""),
+        std::string::npos);
+}
+
+TEST(PhaseTimersTest, testHardwareCountersDegradeGracefully)
+{
+    PerfCounters counters;
+    PerfSample before{}, after{};
+    if (!counters.available()) {
+        EXPECT_FALSE(counters.error().empty());
+        EXPECT_FALSE(counters.read(&before));
+        return;
+    }
+    ASSERT_TRUE(counters.read(&before));
+    volatile double sum = 0.0;
+    for (int n = 0; n < 100000; n++) {
+        sum = sum + n;
+    }
+    ASSERT_TRUE(counters.read(&after));
+    int instructions = static_cast<int>(PerfEvent::Instructions);
+    EXPECT_GT(after[instructions], before[instructions]);
+}
@@ -1,7 +1,8 @@
 #ifndef USEFUL_ALIAS_HPP
 #define USEFUL_ALIAS_HPP
 
-struct Point;
+#include "point_def.hpp"
+
 struct PointFunctions;
 namespace alias {
 
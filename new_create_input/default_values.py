@@ -6,6 +6,7 @@ DEFAULT_OPTIONS = {
     "CFL": "0.9",
     "MIX_PARAM": "0.1",
     "T_MAX": "1.0",
+    "MAX_STEPS": "0",
     "T_INIT": "0.0",
     "PRINT_INTERVAL": "0.1",
     "PRINT_CONTINUE": "FALSE",
@@ -22,6 +23,59 @@ DEFAULT_OPTIONS = {
     "OUTPUT_COUNTER": "0",
     "INPUT_TYPE": "DEFAULT",
     "OUTPUT_TYPE": "VTK",
+    "OUTPUT_FIELDS": "ALL",
+    "OUTPUT_BOX": "NONE",
+    "OUTPUT_STRIDE": "1",
+    "OUTPUT_STREAMS": "NONE",
+    "OUTPUT_STREAM_INTERVALS": "",
+    "OUTPUT_STREAM_STRIDES": "",
+    "OUTPUT_STREAM_FIELDS": "",
+    "OUTPUT_STREAM_BOXES": "",
+    "OUTPUT_PARTITIONED": "FALSE",
+    "COMPRESSION_ERROR_BOUND": "1e-4",
+    "COMPRESSION_ERROR_TYPE": "REL",
+    "COMPRESSION_FIELD_BOUNDS": "NONE",
+    "COMPRESSION_LEVEL": "6",
+    "COMPRESSION_VALIDATE": "FALSE",
+    "HDF5_SNAPSHOTS_PER_FILE": "0",
+    "HDF5_CHUNK_SIZE": "64",
+    "HDF5_COMPRESSION_LEVEL": "4",
+    "CHECKPOINT_INTERVAL": "0",
+    "CHECKPOINT_KEEP": "2",
+    "CHECKPOINT_FILE_NAME": "checkpoint",
+    "RESTART": "FALSE",
+    "RESTART_FILE": "LATEST",
+    "TIMING": "TRUE",
+    "TIMING_JSON": "NONE",
+    "STEP_LOG": "NONE",
+    "STEP_LOG_FORMAT": "CSV",
+    "STEP_LOG_INTERVAL": "1",
+    "STEP_LOG_FLUSH_SECONDS": "1.0",
+    "PROGRESS_INTERVAL": "100",
+    "STEADY_STATE": "FALSE",
+    "STEADY_RESIDUAL_DROP": "6",
+    "STEADY_PLATEAU_STEPS": "0",
+    "STEADY_PLATEAU_TOLERANCE": "0.01",
+    "LOCAL_TIME_STEPPING": "FALSE",
+    "RESIDUAL_SMOOTHING": "FALSE",
+    "RESIDUAL_SMOOTHING_CFL": "0.9",
+    "IMEX_NEWTON_ITERATIONS": "2",
+    "IMEX_KRYLOV_ITERATIONS": "20",
+    "IMEX_KRYLOV_TOLERANCE": "1e-3",
+    "JFNK_MAX_ITERATIONS": "200",
+    "JFNK_MAX_CFL": "20",
+    "JFNK_KRYLOV_ITERATIONS": "30",
+    "JFNK_KRYLOV_TOLERANCE": "1e-2",
+    "ADAPTIVE_RTOL": "1e-4",
+    "ADAPTIVE_ATOL": "1e-6",
+    "ADAPTIVE_MAX_REJECTIONS": "20",
+    "BENCHMARK": "FALSE",
+    "BENCHMARK_CASES": "SHOCK_TUBE CYLINDER CHANNEL",
+    "BENCHMARK_SOLVERS": "SIMPLE GHIAS KARAGIOZIS SHOCK GHIAS_SHOCK",
+    "BENCHMARK_SIZES": "64 128 256",
+    "BENCHMARK_THREADS": "ALL",
+    "BENCHMARK_STEPS": "20",
+    "BENCHMARK_REPORT": "NONE",
     "FLUX": "SIMPLE",
     "CONVECTION": "SIMPLE",
     "MIX_CONVECTION_MAIN": "SIMPLE",
@@ -29,6 +83,18 @@ DEFAULT_OPTIONS = {
     "DISSIPATION": "SIMPLE",
     "DERIVATIVE_ORDER": "2",
     "OMP_THREADS": "0",
+    "THREAD_AFFINITY": "NONE",
+    "FIRST_TOUCH": "TRUE",
+    "HUGE_PAGES": "FALSE",
+    "TILE_ROWS": "0",
+    "TILE_COLS": "0",
+    "TILE_AUTOTUNE": "FALSE",
+    "STORAGE_ROUNDING": "NONE",
+    "PRECISION_CHECK": "FALSE",
+    "ENSEMBLE": "FALSE",
+    "ENSEMBLE_MACH": "NONE",
+    "ENSEMBLE_REYNOLDS": "NONE",
+    "ENSEMBLE_CONCURRENCY": "0",
     "LUISA_DETECTOR": "TYPE_23",
     "DETECTOR_SENSITIVITY": "1.0",
     "SHOULD_FILTER": "FALSE",